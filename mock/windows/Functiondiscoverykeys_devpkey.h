@@ -0,0 +1,3 @@
+#pragma once
+// Mock device property keys for cross-platform development; nothing reads
+// endpoint properties off Windows
@@ -0,0 +1,21 @@
+#pragma once
+// Mock shell folder API for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "windows.h"
+
+typedef GUID KNOWNFOLDERID;
+typedef const GUID& REFKNOWNFOLDERID;
+
+struct MockFolderRoamingAppData;
+#define FOLDERID_RoamingAppData __uuidof(MockFolderRoamingAppData)
+
+// No per-user folders: settings fall back to their defaults
+inline HRESULT SHGetKnownFolderPath(REFKNOWNFOLDERID, DWORD, HANDLE, PWSTR* path)
+{
+    *path = nullptr;
+    return E_NOTIMPL;
+}
+
+#endif // MOCK_WINDOWS_APIS
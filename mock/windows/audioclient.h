@@ -0,0 +1,86 @@
+#pragma once
+// Mock WASAPI client interfaces for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "windows.h"
+#include "mmreg.h"
+
+typedef enum _AUDCLNT_SHAREMODE {
+    AUDCLNT_SHAREMODE_SHARED,
+    AUDCLNT_SHAREMODE_EXCLUSIVE
+} AUDCLNT_SHAREMODE;
+
+typedef enum _AUDIO_STREAM_CATEGORY {
+    AudioCategory_Other = 0
+} AUDIO_STREAM_CATEGORY;
+
+typedef struct AudioClientProperties {
+    UINT32 cbSize;
+    BOOL bIsOffload;
+    AUDIO_STREAM_CATEGORY eCategory;
+    DWORD Options;
+} AudioClientProperties;
+
+#define AUDCLNT_STREAMFLAGS_LOOPBACK 0x00020000
+#define AUDCLNT_STREAMFLAGS_EVENTCALLBACK 0x00040000
+
+#define AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY 0x1
+#define AUDCLNT_BUFFERFLAGS_SILENT 0x2
+#define AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR 0x4
+
+#define AUDCLNT_ERR(n) ((HRESULT)(0x88890000 | (n)))
+#define AUDCLNT_SUCCESS(n) ((HRESULT)(0x08890000 | (n)))
+#define AUDCLNT_E_NOT_INITIALIZED AUDCLNT_ERR(0x001)
+#define AUDCLNT_E_ALREADY_INITIALIZED AUDCLNT_ERR(0x002)
+#define AUDCLNT_E_WRONG_ENDPOINT_TYPE AUDCLNT_ERR(0x003)
+#define AUDCLNT_E_DEVICE_INVALIDATED AUDCLNT_ERR(0x004)
+#define AUDCLNT_E_NOT_STOPPED AUDCLNT_ERR(0x005)
+#define AUDCLNT_E_OUT_OF_ORDER AUDCLNT_ERR(0x007)
+#define AUDCLNT_E_UNSUPPORTED_FORMAT AUDCLNT_ERR(0x008)
+#define AUDCLNT_E_INVALID_SIZE AUDCLNT_ERR(0x009)
+#define AUDCLNT_E_BUFFER_OPERATION_PENDING AUDCLNT_ERR(0x00B)
+#define AUDCLNT_E_EVENTHANDLE_NOT_SET AUDCLNT_ERR(0x014)
+#define AUDCLNT_S_BUFFER_EMPTY AUDCLNT_SUCCESS(0x001)
+
+struct IAudioClient : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE Initialize(AUDCLNT_SHAREMODE ShareMode, DWORD StreamFlags, REFERENCE_TIME hnsBufferDuration,
+                                                 REFERENCE_TIME hnsPeriodicity, const WAVEFORMATEX* pFormat, LPCGUID AudioSessionGuid) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetBufferSize(UINT32* pNumBufferFrames) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetStreamLatency(REFERENCE_TIME* phnsLatency) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetCurrentPadding(UINT32* pNumPaddingFrames) = 0;
+    virtual HRESULT STDMETHODCALLTYPE IsFormatSupported(AUDCLNT_SHAREMODE ShareMode, const WAVEFORMATEX* pFormat,
+                                                        WAVEFORMATEX** ppClosestMatch) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetMixFormat(WAVEFORMATEX** ppDeviceFormat) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetDevicePeriod(REFERENCE_TIME* phnsDefaultDevicePeriod, REFERENCE_TIME* phnsMinimumDevicePeriod) = 0;
+    virtual HRESULT STDMETHODCALLTYPE Start() = 0;
+    virtual HRESULT STDMETHODCALLTYPE Stop() = 0;
+    virtual HRESULT STDMETHODCALLTYPE Reset() = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetEventHandle(HANDLE eventHandle) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetService(REFIID riid, void** ppv) = 0;
+};
+
+struct IAudioClient2 : IAudioClient {
+    virtual HRESULT STDMETHODCALLTYPE IsOffloadCapable(AUDIO_STREAM_CATEGORY Category, BOOL* pbOffloadCapable) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetClientProperties(const AudioClientProperties* pProperties) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetBufferSizeLimits(const WAVEFORMATEX* pFormat, BOOL bEventDriven,
+                                                          REFERENCE_TIME* phnsMinBufferDuration, REFERENCE_TIME* phnsMaxBufferDuration) = 0;
+};
+
+struct IAudioClient3 : IAudioClient2 {
+    virtual HRESULT STDMETHODCALLTYPE GetSharedModeEnginePeriod(const WAVEFORMATEX* pFormat, UINT32* pDefaultPeriodInFrames,
+                                                                UINT32* pFundamentalPeriodInFrames, UINT32* pMinPeriodInFrames,
+                                                                UINT32* pMaxPeriodInFrames) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetCurrentSharedModeEnginePeriod(WAVEFORMATEX** ppFormat, UINT32* pCurrentPeriodInFrames) = 0;
+    virtual HRESULT STDMETHODCALLTYPE InitializeSharedAudioStream(DWORD StreamFlags, UINT32 PeriodInFrames, const WAVEFORMATEX* pFormat,
+                                                                  LPCGUID AudioSessionGuid) = 0;
+};
+
+struct IAudioCaptureClient : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE GetBuffer(BYTE** ppData, UINT32* pNumFramesToRead, DWORD* pdwFlags, UINT64* pu64DevicePosition,
+                                                UINT64* pu64QPCPosition) = 0;
+    virtual HRESULT STDMETHODCALLTYPE ReleaseBuffer(UINT32 NumFramesRead) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetNextPacketSize(UINT32* pNumFramesInNextPacket) = 0;
+};
+
+#endif // MOCK_WINDOWS_APIS
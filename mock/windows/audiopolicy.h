@@ -0,0 +1,43 @@
+#pragma once
+// Mock audio session interfaces for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "windows.h"
+
+struct IAudioVolumeDuckNotification;
+struct ISimpleAudioVolume;
+
+struct IAudioSessionControl : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE GetDisplayName(LPWSTR* pRetVal) = 0;
+};
+
+struct IAudioSessionNotification : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE OnSessionCreated(IAudioSessionControl* NewSession) = 0;
+};
+
+struct IAudioSessionControl2 : IAudioSessionControl {
+    virtual HRESULT STDMETHODCALLTYPE GetProcessId(DWORD* pRetVal) = 0;
+};
+
+struct IAudioSessionEnumerator : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE GetCount(int* SessionCount) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetSession(int SessionCount, IAudioSessionControl** Session) = 0;
+};
+
+struct IAudioSessionManager : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE GetAudioSessionControl(LPCGUID AudioSessionGuid, DWORD StreamFlags,
+                                                             IAudioSessionControl** SessionControl) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetSimpleAudioVolume(LPCGUID AudioSessionGuid, DWORD StreamFlags,
+                                                           ISimpleAudioVolume** AudioVolume) = 0;
+};
+
+struct IAudioSessionManager2 : IAudioSessionManager {
+    virtual HRESULT STDMETHODCALLTYPE GetSessionEnumerator(IAudioSessionEnumerator** SessionEnum) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterSessionNotification(IAudioSessionNotification* SessionNotification) = 0;
+    virtual HRESULT STDMETHODCALLTYPE UnregisterSessionNotification(IAudioSessionNotification* SessionNotification) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterDuckNotification(LPCWSTR sessionID, IAudioVolumeDuckNotification* duckNotification) = 0;
+    virtual HRESULT STDMETHODCALLTYPE UnregisterDuckNotification(IAudioVolumeDuckNotification* duckNotification) = 0;
+};
+
+#endif // MOCK_WINDOWS_APIS
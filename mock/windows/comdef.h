@@ -0,0 +1,18 @@
+#pragma once
+// Mock COM support classes for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "windows.h"
+
+class _com_error {
+public:
+    explicit _com_error(HRESULT hr) : m_hr(hr) {}
+    HRESULT Error() const { return m_hr; }
+    const wchar_t* ErrorMessage() const { return L"Unknown error"; }
+
+private:
+    HRESULT m_hr;
+};
+
+#endif // MOCK_WINDOWS_APIS
@@ -0,0 +1,12 @@
+#pragma once
+// Mock endpoint volume interfaces for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "windows.h"
+
+struct IAudioMeterInformation : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE GetPeakValue(float* pfPeak) = 0;
+};
+
+#endif // MOCK_WINDOWS_APIS
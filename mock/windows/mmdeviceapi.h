@@ -0,0 +1,51 @@
+#pragma once
+// Mock MMDevice API for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "windows.h"
+
+typedef enum __MIDL___MIDL_itf_mmdeviceapi_0000_0000_0001 {
+    eRender,
+    eCapture,
+    eAll
+} EDataFlow;
+
+typedef enum __MIDL___MIDL_itf_mmdeviceapi_0000_0000_0002 {
+    eConsole,
+    eMultimedia,
+    eCommunications
+} ERole;
+
+#define DEVICE_STATE_ACTIVE 0x00000001
+#define DEVICE_STATE_NOTPRESENT 0x00000004
+
+struct PROPVARIANT;
+struct IPropertyStore;
+struct IMMDeviceCollection;
+struct IMMNotificationClient;
+
+struct IMMDevice : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE Activate(REFIID iid, DWORD dwClsCtx, PROPVARIANT* pActivationParams, void** ppInterface) = 0;
+    virtual HRESULT STDMETHODCALLTYPE OpenPropertyStore(DWORD stgmAccess, IPropertyStore** ppProperties) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetId(LPWSTR* ppstrId) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetState(DWORD* pdwState) = 0;
+    // Lets a ComPtr's address stand in for void** as it does with WRL
+    template <class Q>
+    HRESULT Activate(REFIID iid, DWORD dwClsCtx, PROPVARIANT* pActivationParams, Q** ppInterface)
+    {
+        return Activate(iid, dwClsCtx, pActivationParams, reinterpret_cast<void**>(ppInterface));
+    }
+};
+
+struct IMMDeviceEnumerator : IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE EnumAudioEndpoints(EDataFlow dataFlow, DWORD dwStateMask, IMMDeviceCollection** ppDevices) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetDefaultAudioEndpoint(EDataFlow dataFlow, ERole role, IMMDevice** ppEndpoint) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetDevice(LPCWSTR pwstrId, IMMDevice** ppDevice) = 0;
+    virtual HRESULT STDMETHODCALLTYPE RegisterEndpointNotificationCallback(IMMNotificationClient* pClient) = 0;
+    virtual HRESULT STDMETHODCALLTYPE UnregisterEndpointNotificationCallback(IMMNotificationClient* pClient) = 0;
+};
+
+class MMDeviceEnumerator;
+
+#endif // MOCK_WINDOWS_APIS
@@ -0,0 +1,5 @@
+#pragma once
+// Mock COM base header for cross-platform development; the COM subset
+// lives in windows.h
+
+#include "windows.h"
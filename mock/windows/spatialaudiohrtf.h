@@ -0,0 +1,3 @@
+#pragma once
+// Mock spatial audio HRTF interfaces for cross-platform development; only
+// the include is needed off Windows
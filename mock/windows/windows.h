@@ -1,11 +1,20 @@
 #pragma once
 // Mock Windows.h for cross-platform development
 // This file provides basic Windows type definitions for compilation on non-Windows platforms
-// The actual functionality will not work - this is for syntax checking only
+// The window functions do not work - they are for syntax checking only. The
+// COM subset below is real enough for the audio engine to run against the
+// fake endpoint in the headless benchmark build.
 
 #ifdef MOCK_WINDOWS_APIS
 
+#include <cstdarg>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <type_traits>
 
 // Basic Windows types
 typedef void* HANDLE;
@@ -37,6 +46,22 @@ typedef const wchar_t* LPCWSTR;
 typedef void* LPVOID;
 typedef long long LONGLONG;
 typedef unsigned long long ULONGLONG;
+typedef unsigned long ULONG;
+typedef unsigned long long UINT64;
+typedef unsigned short USHORT;
+typedef int INT;
+typedef float FLOAT;
+typedef wchar_t WCHAR;
+typedef wchar_t* PWSTR;
+typedef const wchar_t* PCWSTR;
+typedef long LONG_PTR;
+typedef long INT_PTR;
+typedef unsigned long ULONG_PTR;
+typedef unsigned long SIZE_T;
+typedef DWORD COLORREF;
+typedef LONGLONG REFERENCE_TIME;
+// 32 bits as on Windows, so FAILED() sees the sign of 0x8xxxxxxx codes
+typedef int32_t HRESULT;
 
 typedef LRESULT (*WNDPROC)(HWND, UINT, WPARAM, LPARAM);
 
@@ -119,8 +144,23 @@ typedef LONG* LPLONG;
 #define SW_SHOWNOACTIVATE 4
 
 // Error codes
-#define S_OK 0
-#define E_FAIL 0x80004005L
+#define S_OK ((HRESULT)0)
+#define S_FALSE ((HRESULT)1)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_NOTIMPL ((HRESULT)0x80004001L)
+#define E_NOINTERFACE ((HRESULT)0x80004002L)
+#define E_POINTER ((HRESULT)0x80004003L)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define ERROR_NOT_FOUND 1168L
+#define HRESULT_FROM_WIN32(x) ((HRESULT)(((x) & 0x0000FFFF) | (7 << 16) | 0x80000000))
+
+#define RGB(r, g, b) ((COLORREF)(((BYTE)(r) | ((WORD)((BYTE)(g)) << 8)) | (((DWORD)(BYTE)(b)) << 16)))
+#define GetRValue(rgb) ((BYTE)(rgb))
+#define GetGValue(rgb) ((BYTE)(((WORD)(rgb)) >> 8))
+#define GetBValue(rgb) ((BYTE)((rgb) >> 16))
 
 // MessageBox flags
 #define MB_OK 0x00000000L
@@ -217,8 +257,125 @@ inline BOOL AppendMenuW(HMENU, UINT, UINT_PTR, LPCWSTR) { return TRUE; }
 inline BOOL InsertMenuW(HMENU, UINT, UINT, UINT_PTR, LPCWSTR) { return TRUE; }
 inline UINT TrackPopupMenu(HMENU, UINT, int, int, int, HWND, const RECT*) { return 0; }
 
+inline void OutputDebugStringA(LPCSTR) {}
+inline void OutputDebugStringW(LPCWSTR) {}
+inline HANDLE GetCurrentProcess() { return nullptr; }
+inline HANDLE GetCurrentThread() { return nullptr; }
+
+// Private profile (INI) files read back their defaults and never write. The
+// file name is untyped because std::filesystem::path is narrow off Windows.
+inline DWORD GetPrivateProfileStringW(LPCWSTR, LPCWSTR, LPCWSTR fallback, LPWSTR buffer, DWORD size, const void*)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+    std::wcsncpy(buffer, fallback ? fallback : L"", size - 1);
+    buffer[size - 1] = L'\0';
+    return static_cast<DWORD>(std::wcslen(buffer));
+}
+inline UINT GetPrivateProfileIntW(LPCWSTR, LPCWSTR, int fallback, const void*) { return static_cast<UINT>(fallback); }
+inline BOOL WritePrivateProfileStringW(LPCWSTR, LPCWSTR, LPCWSTR, const void*) { return FALSE; }
+
+// Secure CRT
+inline int sprintf_s(char* buffer, size_t size, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int result = std::vsnprintf(buffer, size, format, args);
+    va_end(args);
+    return result;
+}
+template <size_t N>
+int sprintf_s(char (&buffer)[N], const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int result = std::vsnprintf(buffer, N, format, args);
+    va_end(args);
+    return result;
+}
+template <size_t N>
+int swprintf_s(wchar_t (&buffer)[N], const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int result = std::vswprintf(buffer, N, format, args);
+    va_end(args);
+    return result;
+}
+inline int swscanf_s(const wchar_t* input, const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int result = std::vswscanf(input, format, args);
+    va_end(args);
+    return result;
+}
+
 // COM
-inline long CoInitializeEx(void*, DWORD) { return S_OK; }
+#define STDMETHODCALLTYPE
+#define STDMETHODIMP HRESULT STDMETHODCALLTYPE
+#define CLSCTX_ALL 0x17
+#define COINIT_MULTITHREADED 0x0
+#define COINIT_APARTMENTTHREADED 0x2
+
+typedef struct _FILETIME {
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+} FILETIME;
+
+typedef struct _GUID {
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t Data4[8];
+} GUID;
+inline bool operator==(const GUID& a, const GUID& b) { return std::memcmp(&a, &b, sizeof(GUID)) == 0; }
+inline bool operator!=(const GUID& a, const GUID& b) { return !(a == b); }
+typedef GUID IID;
+typedef GUID CLSID;
+typedef const GUID& REFIID;
+typedef const GUID& REFCLSID;
+typedef const GUID* LPCGUID;
+
+// __uuidof hands each interface a distinct GUID on first use; nothing
+// outside the process ever sees them
+inline GUID MockNextGuid()
+{
+    static uint32_t next = 1;
+    GUID guid{};
+    guid.Data1 = next++;
+    return guid;
+}
+template <class T>
+const GUID& MockUuidOf()
+{
+    static const GUID guid = MockNextGuid();
+    return guid;
+}
+#define __uuidof(x) MockUuidOf<std::remove_cv_t<std::remove_reference_t<x>>>()
+#define IID_PPV_ARGS(pp) \
+    MockUuidOf<std::remove_cv_t<std::remove_reference_t<decltype(**(pp))>>>(), \
+        reinterpret_cast<void**>(static_cast<decltype(&**(pp))*>(pp))
+
+struct IUnknown {
+    virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) = 0;
+    virtual ULONG STDMETHODCALLTYPE AddRef() = 0;
+    virtual ULONG STDMETHODCALLTYPE Release() = 0;
+    template <class Q>
+    HRESULT QueryInterface(Q** object) { return QueryInterface(__uuidof(Q), reinterpret_cast<void**>(object)); }
+};
+
+inline HRESULT CoInitializeEx(void*, DWORD) { return S_OK; }
 inline void CoUninitialize() {}
+inline void* CoTaskMemAlloc(SIZE_T bytes) { return std::malloc(bytes); }
+inline void CoTaskMemFree(void* memory) { std::free(memory); }
+// No COM classes are registered; callers pass their own objects in
+inline HRESULT CoCreateInstance(REFCLSID, IUnknown*, DWORD, REFIID, void** object)
+{
+    *object = nullptr;
+    return E_NOINTERFACE;
+}
 
 #endif // MOCK_WINDOWS_APIS
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+// Mock WRL ComPtr for cross-platform development
+
+#ifdef MOCK_WINDOWS_APIS
+
+#include "../windows.h"
+
+#include <utility>
+
+namespace Microsoft {
+namespace WRL {
+template <class T>
+class ComPtr;
+
+namespace Details {
+// What &comPtr yields: converts to T** or void** after releasing the old
+// pointer, like the real ComPtrRef
+template <class T>
+class ComPtrRef {
+public:
+    explicit ComPtrRef(ComPtr<T>* pointer) : m_pointer(pointer) {}
+    operator T**() { return m_pointer->ReleaseAndGetAddressOf(); }
+    operator void**() { return reinterpret_cast<void**>(m_pointer->ReleaseAndGetAddressOf()); }
+    T*& operator*() { return *m_pointer->ReleaseAndGetAddressOf(); }
+    ComPtr<T>* Get() const { return m_pointer; }
+
+private:
+    ComPtr<T>* m_pointer;
+};
+}
+
+template <class T>
+class ComPtr {
+public:
+    ComPtr() = default;
+    ComPtr(decltype(nullptr)) {}
+    ComPtr(T* pointer) : m_pointer(pointer) { InternalAddRef(); }
+    ComPtr(const ComPtr& other) : m_pointer(other.m_pointer) { InternalAddRef(); }
+    template <class U>
+    ComPtr(const ComPtr<U>& other) : m_pointer(other.Get()) { InternalAddRef(); }
+    ComPtr(ComPtr&& other) noexcept : m_pointer(other.m_pointer) { other.m_pointer = nullptr; }
+    ~ComPtr() { Reset(); }
+
+    ComPtr& operator=(ComPtr other)
+    {
+        std::swap(m_pointer, other.m_pointer);
+        return *this;
+    }
+    ComPtr& operator=(decltype(nullptr))
+    {
+        Reset();
+        return *this;
+    }
+
+    T* Get() const { return m_pointer; }
+    T* operator->() const { return m_pointer; }
+    explicit operator bool() const { return m_pointer != nullptr; }
+    Details::ComPtrRef<T> operator&() { return Details::ComPtrRef<T>(this); }
+
+    T* const* GetAddressOf() const { return &m_pointer; }
+    T** GetAddressOf() { return &m_pointer; }
+    T** ReleaseAndGetAddressOf()
+    {
+        Reset();
+        return &m_pointer;
+    }
+
+    void Attach(T* pointer)
+    {
+        Reset();
+        m_pointer = pointer;
+    }
+    T* Detach()
+    {
+        T* pointer = m_pointer;
+        m_pointer = nullptr;
+        return pointer;
+    }
+
+    unsigned long Reset()
+    {
+        unsigned long count = 0;
+        if (m_pointer)
+        {
+            count = m_pointer->Release();
+            m_pointer = nullptr;
+        }
+        return count;
+    }
+
+    template <class U>
+    HRESULT As(ComPtr<U>* other) const
+    {
+        return m_pointer->QueryInterface(__uuidof(U), reinterpret_cast<void**>(other->ReleaseAndGetAddressOf()));
+    }
+    template <class U>
+    HRESULT As(Details::ComPtrRef<U> other) const
+    {
+        return As(other.Get());
+    }
+
+    HRESULT CopyTo(T** other) const
+    {
+        InternalAddRef();
+        *other = m_pointer;
+        return S_OK;
+    }
+
+private:
+    void InternalAddRef() const
+    {
+        if (m_pointer)
+        {
+            m_pointer->AddRef();
+        }
+    }
+
+    T* m_pointer{nullptr};
+};
+}
+}
+
+#endif // MOCK_WINDOWS_APIS
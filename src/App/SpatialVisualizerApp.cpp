@@ -4,11 +4,13 @@
 #include "Audio/SpatialAudioRouter.h"
 #include "Config/ConfigManager.h"
 #include "Diagnostics/PerformanceMonitor.h"
+#include "Diagnostics/TraceRecorder.h"
 #include "Hotkeys/HotkeyController.h"
 #include "Rendering/DirectionVisualizer.h"
 #include "UI/OverlayWindow.h"
 #include "UI/SettingsController.h"
 #include "UI/TrayIcon.h"
+#include "Util/NamedThread.h"
 
 #include <shellapi.h>
 
@@ -32,6 +34,8 @@ SpatialVisualizerApp::~SpatialVisualizerApp()
 
 int SpatialVisualizerApp::Run()
 {
+    Util::ThreadIdentity uiThread{"ui"};
+
     InitializeWindow();
     InitializeAudio();
     InitializeUi();
@@ -90,6 +94,13 @@ void SpatialVisualizerApp::Shutdown()
     {
         m_performanceMonitor->Stop();
     }
+
+    // Every worker has stopped, so the buffers hold each thread's final spans
+    if constexpr (Diagnostics::kTraceEnabled)
+    {
+        Diagnostics::TraceRecorder::Instance().WriteChromeJson(
+            Diagnostics::TraceRecorder::TimestampedPath(m_config->DataDirectory()));
+    }
 }
 
 void SpatialVisualizerApp::InitializeWindow()
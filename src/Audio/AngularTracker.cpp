@@ -0,0 +1,80 @@
+#include "Audio/AngularTracker.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+namespace
+{
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kTwoPi = 2.0f * kPi;
+
+// Smoothing time constant of the velocity estimate
+constexpr float kVelocityTimeConstant = 0.08f;
+// Packets further apart than this are not the same motion
+constexpr float kMaxGapSeconds = 0.15f;
+// Faster than two turns per second is a different source, not motion
+constexpr float kMaxVelocity = 2.0f * kTwoPi;
+// Samples needed before the estimate is fully trusted
+constexpr uint32_t kWarmupSamples = 5;
+// Velocity scatter (rad/s) at which confidence has halved
+constexpr float kScatterScale = 1.5f;
+
+float WrapAngle(float angle)
+{
+    // Shortest signed difference in [-pi, pi]
+    return std::remainder(angle, kTwoPi);
+}
+}
+
+AngularTracker::Estimate AngularTracker::Update(float azimuth, bool tracked, std::chrono::steady_clock::time_point time) noexcept
+{
+    if (!tracked)
+    {
+        Reset();
+        return {};
+    }
+
+    const float dt = m_hasSample ? std::chrono::duration<float>(time - m_lastTime).count() : 0.0f;
+    if (!m_hasSample || dt <= 0.0f || dt > kMaxGapSeconds)
+    {
+        Restart(azimuth, time);
+        return {};
+    }
+
+    const float instant = WrapAngle(azimuth - m_lastAzimuth) / dt;
+    if (std::fabs(instant) > kMaxVelocity)
+    {
+        Restart(azimuth, time);
+        return {};
+    }
+
+    const float alpha = 1.0f - std::exp(-dt / kVelocityTimeConstant);
+    m_scatter += alpha * (std::fabs(instant - m_velocity) - m_scatter);
+    m_velocity += alpha * (instant - m_velocity);
+    m_lastAzimuth = azimuth;
+    m_lastTime = time;
+    m_samples = std::min(m_samples + 1, kWarmupSamples);
+
+    Estimate estimate;
+    estimate.velocity = m_velocity;
+    estimate.confidence = (static_cast<float>(m_samples) / kWarmupSamples) / (1.0f + m_scatter / kScatterScale);
+    return estimate;
+}
+
+void AngularTracker::Reset() noexcept
+{
+    m_hasSample = false;
+    m_velocity = 0.0f;
+    m_scatter = 0.0f;
+    m_samples = 0;
+}
+
+void AngularTracker::Restart(float azimuth, std::chrono::steady_clock::time_point time) noexcept
+{
+    Reset();
+    m_hasSample = true;
+    m_lastAzimuth = azimuth;
+    m_lastTime = time;
+}
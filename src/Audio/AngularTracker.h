@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Audio
+{
+// Follows the dominant source's azimuth from packet to packet and estimates
+// how fast it is turning. The velocity is exponentially smoothed; confidence
+// grows with the number of consistent samples and drops with the scatter of
+// the raw per-packet velocity around the estimate. Losing the source, a long
+// gap or an implausible jump restarts tracking at zero confidence.
+class AngularTracker
+{
+public:
+    struct Estimate
+    {
+        float velocity{0.0f}; // radians per second, positive turning right
+        float confidence{0.0f}; // 0..1
+    };
+
+    Estimate Update(float azimuth, bool tracked, std::chrono::steady_clock::time_point time) noexcept;
+    void Reset() noexcept;
+
+private:
+    void Restart(float azimuth, std::chrono::steady_clock::time_point time) noexcept;
+
+    bool m_hasSample{false};
+    float m_lastAzimuth{0.0f};
+    std::chrono::steady_clock::time_point m_lastTime;
+    float m_velocity{0.0f};
+    float m_scatter{0.0f};
+    uint32_t m_samples{0};
+};
+}
@@ -0,0 +1,120 @@
+#include "Audio/CaptureHealth.h"
+
+#include <audioclient.h>
+
+#include <algorithm>
+
+using namespace Audio;
+
+namespace
+{
+// A wakeup that finds more than this many device periods queued is behind
+constexpr uint64_t kBacklogPeriods = 2;
+constexpr auto kEngageReducedAfter = std::chrono::milliseconds(500);
+constexpr auto kRestoreFullAfter = std::chrono::seconds(2);
+// Loopback delivers nothing while the endpoint is silent; a gap this long
+// is the stream resuming, not jitter
+constexpr auto kStreamGap = std::chrono::seconds(1);
+
+Diagnostics::MetricsRegistry& Registry()
+{
+    return Diagnostics::MetricsRegistry::Instance();
+}
+}
+
+CaptureHealth::CaptureHealth()
+    : m_discontinuities(Registry().GetCounter("audio.discontinuities"))
+    , m_timestampErrors(Registry().GetCounter("audio.timestamp_errors"))
+    , m_tierChanges(Registry().GetCounter("audio.tier_changes"))
+    , m_backlogFrames(Registry().GetGauge("audio.backlog_frames"))
+    , m_tierGauge(Registry().GetGauge("audio.analysis_tier"))
+    , m_packetSize(Registry().GetHistogram("audio.packet_size"))
+    , m_wakeInterval(Registry().GetHistogram("audio.wake_interval"))
+    , m_wakeJitter(Registry().GetHistogram("audio.wake_jitter"))
+    , m_backlog(Registry().GetHistogram("audio.backlog"))
+{
+}
+
+void CaptureHealth::Configure(UINT32 sampleRate, REFERENCE_TIME devicePeriod100ns) noexcept
+{
+    m_sampleRate = std::max<UINT32>(1, sampleRate);
+    if (devicePeriod100ns > 0)
+    {
+        m_devicePeriod = std::chrono::nanoseconds(devicePeriod100ns * 100);
+    }
+    m_periodFrames = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::chrono::duration<double>(m_devicePeriod).count() * m_sampleRate));
+
+    m_lastWake = {};
+    m_wakeFrames = 0;
+    m_backlogged = false;
+    m_stateSince = {};
+    m_backlogFrames.Set(0);
+    m_tier = AnalysisTier::Full;
+    m_tierGauge.Set(0);
+}
+
+void CaptureHealth::OnWake(std::chrono::steady_clock::time_point now) noexcept
+{
+    if (m_lastWake != std::chrono::steady_clock::time_point{})
+    {
+        const auto interval = now - m_lastWake;
+        if (interval < kStreamGap)
+        {
+            m_wakeInterval.Record(interval);
+            m_wakeJitter.Record(interval > m_devicePeriod ? interval - m_devicePeriod : m_devicePeriod - interval);
+        }
+    }
+    m_lastWake = now;
+    m_wakeFrames = 0;
+}
+
+void CaptureHealth::OnPacket(UINT32 frames, DWORD flags) noexcept
+{
+    m_wakeFrames += frames;
+    m_packetSize.Record(FramesToDuration(frames));
+    if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY)
+    {
+        m_discontinuities.Add();
+    }
+    if (flags & AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR)
+    {
+        m_timestampErrors.Add();
+    }
+}
+
+AnalysisTier CaptureHealth::OnDrained(std::chrono::steady_clock::time_point now) noexcept
+{
+    m_backlogFrames.Set(static_cast<int64_t>(m_wakeFrames));
+    m_backlog.Record(FramesToDuration(m_wakeFrames));
+
+    const bool backlogged = m_wakeFrames > kBacklogPeriods * m_periodFrames;
+    if (backlogged != m_backlogged || m_stateSince == std::chrono::steady_clock::time_point{})
+    {
+        m_backlogged = backlogged;
+        m_stateSince = now;
+    }
+
+    const auto held = now - m_stateSince;
+    if (m_tier == AnalysisTier::Full && m_backlogged && held >= kEngageReducedAfter)
+    {
+        SetTier(AnalysisTier::Reduced);
+    }
+    else if (m_tier == AnalysisTier::Reduced && !m_backlogged && held >= kRestoreFullAfter)
+    {
+        SetTier(AnalysisTier::Full);
+    }
+    return m_tier;
+}
+
+std::chrono::nanoseconds CaptureHealth::FramesToDuration(uint64_t frames) const noexcept
+{
+    return std::chrono::nanoseconds(frames * 1'000'000'000ull / m_sampleRate);
+}
+
+void CaptureHealth::SetTier(AnalysisTier tier) noexcept
+{
+    m_tier = tier;
+    m_tierGauge.Set(tier == AnalysisTier::Reduced ? 1 : 0);
+    m_tierChanges.Add();
+}
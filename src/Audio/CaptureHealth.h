@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <windows.h>
+
+#include "Audio/DirectionAnalyzer.h"
+#include "Diagnostics/MetricsRegistry.h"
+
+namespace Audio
+{
+// Timing and glitch accounting of the capture stream, reported through
+// MetricsRegistry so the performance monitor picks it up:
+//   audio.discontinuities, audio.timestamp_errors  flagged packets
+//   audio.packet_size     audio duration of each packet
+//   audio.wake_interval   between sample-event wakeups
+//   audio.wake_jitter     |wake interval - device period|
+//   audio.backlog         audio queued when a wakeup came, drained in one go
+//   audio.backlog_frames  the same, in frames, for the last wakeup
+//   audio.analysis_tier   0 full, 1 reduced; audio.tier_changes
+// Backlog of more than two device periods sustained for half a second
+// switches analysis to the reduced tier; two seconds without backlog
+// switch it back. Capture thread only.
+class CaptureHealth
+{
+public:
+    CaptureHealth();
+
+    // Stream rate and WASAPI default device period; resets timing and
+    // returns to the full tier.
+    void Configure(UINT32 sampleRate, REFERENCE_TIME devicePeriod100ns) noexcept;
+
+    // The sample event woke the capture thread.
+    void OnWake(std::chrono::steady_clock::time_point now) noexcept;
+    // A packet was read from the capture client.
+    void OnPacket(UINT32 frames, DWORD flags) noexcept;
+    // The queue is empty again. Returns the tier to analyse with from now on.
+    AnalysisTier OnDrained(std::chrono::steady_clock::time_point now) noexcept;
+
+    [[nodiscard]] AnalysisTier Tier() const noexcept { return m_tier; }
+
+private:
+    [[nodiscard]] std::chrono::nanoseconds FramesToDuration(uint64_t frames) const noexcept;
+    void SetTier(AnalysisTier tier) noexcept;
+
+    UINT32 m_sampleRate{48000};
+    std::chrono::nanoseconds m_devicePeriod{std::chrono::milliseconds(10)};
+    uint64_t m_periodFrames{480};
+
+    std::chrono::steady_clock::time_point m_lastWake{};
+    uint64_t m_wakeFrames{0};
+    // Whether the last wakeup found a backlog, and since when that has held
+    bool m_backlogged{false};
+    std::chrono::steady_clock::time_point m_stateSince{};
+    AnalysisTier m_tier{AnalysisTier::Full};
+
+    Diagnostics::Counter& m_discontinuities;
+    Diagnostics::Counter& m_timestampErrors;
+    Diagnostics::Counter& m_tierChanges;
+    Diagnostics::Gauge& m_backlogFrames;
+    Diagnostics::Gauge& m_tierGauge;
+    Util::LatencyHistogram& m_packetSize;
+    Util::LatencyHistogram& m_wakeInterval;
+    Util::LatencyHistogram& m_wakeJitter;
+    Util::LatencyHistogram& m_backlog;
+};
+}
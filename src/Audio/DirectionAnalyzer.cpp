@@ -0,0 +1,186 @@
+#include "Audio/DirectionAnalyzer.h"
+
+#include <mmreg.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+using namespace Audio;
+
+namespace
+{
+// The reduced tier measures level over the newest quarter of a packet, but
+// never over fewer frames than this
+constexpr UINT32 kReducedTierDivisor = 4;
+constexpr UINT32 kReducedTierMinFrames = 64;
+
+// Interleaving order of the channels present in a WAVEFORMATEXTENSIBLE mask
+constexpr DWORD kSpeakerOrder[] = {
+    SPEAKER_FRONT_LEFT,
+    SPEAKER_FRONT_RIGHT,
+    SPEAKER_FRONT_CENTER,
+    SPEAKER_LOW_FREQUENCY,
+    SPEAKER_BACK_LEFT,
+    SPEAKER_BACK_RIGHT,
+    SPEAKER_FRONT_LEFT_OF_CENTER,
+    SPEAKER_FRONT_RIGHT_OF_CENTER,
+    SPEAKER_BACK_CENTER,
+    SPEAKER_SIDE_LEFT,
+    SPEAKER_SIDE_RIGHT,
+    SPEAKER_TOP_CENTER,
+    SPEAKER_TOP_FRONT_LEFT,
+    SPEAKER_TOP_FRONT_CENTER,
+    SPEAKER_TOP_FRONT_RIGHT,
+    SPEAKER_TOP_BACK_LEFT,
+    SPEAKER_TOP_BACK_CENTER,
+    SPEAKER_TOP_BACK_RIGHT,
+};
+
+DWORD ChannelSpeaker(DWORD mask, UINT32 index)
+{
+    const DWORD positional = kSpeakerOrder[index < std::size(kSpeakerOrder) ? index : 0];
+    if (mask == 0)
+    {
+        return positional;
+    }
+
+    UINT32 bitIndex = 0;
+    for (DWORD speakerBit : kSpeakerOrder)
+    {
+        if ((mask & speakerBit) != 0)
+        {
+            if (bitIndex == index)
+            {
+                return speakerBit;
+            }
+            ++bitIndex;
+        }
+    }
+
+    return positional;
+}
+}
+
+DirectionAnalyzer::DirectionAnalyzer(std::shared_ptr<Config::ConfigManager> config)
+    : m_config(std::move(config))
+{
+}
+
+void DirectionAnalyzer::Configure(UINT32 channelCount, DWORD channelMask, KernelChoice kernel) noexcept
+{
+    m_channelCount = channelCount;
+    m_kernel = (kernel == KernelChoice::Specialized) ? SelectEnergyKernel(channelCount, channelMask)
+                                                     : GenericEnergyKernel();
+
+    const UINT32 analysedChannels = std::min(channelCount, kMaxAnalysedChannels);
+    for (UINT32 channel = 0; channel < analysedChannels; ++channel)
+    {
+        m_speakers[channel] = ChannelSpeaker(channelMask, channel);
+    }
+
+    // 立体声（典型耳机 / 虚拟环绕终端）
+    m_isStereo = (channelCount <= 2) &&
+        ((channelMask & ~(SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT)) == 0);
+
+    // 多声道（5.1 / 7.1 等）
+    m_isMultichannel = (channelCount >= 6);
+
+    // 是否有明显的空间声道（顶部/后方/侧面）
+    m_isSpatialAudio = (channelMask & (SPEAKER_TOP_FRONT_LEFT | SPEAKER_BACK_LEFT | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT)) != 0;
+
+    m_tier = AnalysisTier::Full;
+    m_tracker.Reset();
+}
+
+AudioDirection DirectionAnalyzer::Analyze(const float* samples, UINT32 frames, std::chrono::steady_clock::time_point captureTime)
+{
+    ChannelEnergy energy;
+    if (samples && m_channelCount > 0)
+    {
+        if (m_tier == AnalysisTier::Reduced && frames > kReducedTierMinFrames)
+        {
+            const UINT32 window = std::max(kReducedTierMinFrames, frames / kReducedTierDivisor);
+            samples += static_cast<size_t>(frames - window) * m_channelCount;
+            frames = window;
+        }
+        energy = m_kernel.kernel(samples, frames, m_channelCount, m_speakers.data(), m_config->Sensitivity().thresholdDb);
+    }
+
+    auto direction = ResolveDirection(energy);
+    direction.captureTime = captureTime;
+    const auto motion = m_tracker.Update(direction.azimuth,
+                                         !direction.isBackground && direction.magnitude > 0.0f,
+                                         captureTime);
+    direction.azimuthVelocity = motion.velocity;
+    direction.velocityConfidence = motion.confidence;
+    return direction;
+}
+
+AudioDirection DirectionAnalyzer::ResolveDirection(const ChannelEnergy& energy) const
+{
+    AudioDirection direction;
+
+    float front = m_config->Filter().front ? energy.front : 0.0f;
+    float back = m_config->Filter().back ? energy.back : 0.0f;
+    float left = m_config->Filter().left ? energy.left : 0.0f;
+    float right = m_config->Filter().right ? energy.right : 0.0f;
+    float top = m_config->Filter().up ? energy.top : 0.0f;
+    float bottom = m_config->Filter().down ? energy.bottom : 0.0f;
+
+    // 根据配置和检测结果决定当前是否按“耳机模式（仅左右）”展示
+    const auto overrideMode = m_config->AudioMode();
+    bool headphoneMode = false;
+    if (overrideMode == Config::AudioModeOverride::Headphone)
+    {
+        headphoneMode = true;
+    }
+    else if (overrideMode == Config::AudioModeOverride::Multichannel)
+    {
+        headphoneMode = false;
+    }
+    else // Auto
+    {
+        headphoneMode = m_isStereo;
+    }
+
+    if (headphoneMode)
+    {
+        front = back = 0.0f;
+        top = bottom = 0.0f;
+    }
+
+    const float horizontalTotal = front + back + left + right;
+    const float verticalTotal = top + bottom;
+    const float magnitude = horizontalTotal + verticalTotal;
+
+    // BGM 检测：左右几乎完全平衡时视为背景音，忽略
+    const float lrTotal = left + right;
+    if (lrTotal > 0.0001f)
+    {
+        const float lrDiff = std::fabs(left - right);
+        const float balance = lrDiff / lrTotal;
+        if (balance < 0.1f) // 左右差异低于 10%
+        {
+            direction.isBackground = true;
+            direction.magnitude = 0.0f;
+            return direction;
+        }
+    }
+
+    if (magnitude <= 0.001f)
+    {
+        direction.magnitude = 0.0f;
+        return direction;
+    }
+
+    const float x = right - left;
+    const float z = front - back;
+    const float y = top - bottom;
+
+    direction.azimuth = std::atan2(x, z);
+    direction.elevation = std::atan2(y, std::sqrt(x * x + z * z));
+    direction.magnitude = magnitude / 6.0f;
+
+    return direction;
+}
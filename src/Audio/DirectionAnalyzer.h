@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include <windows.h>
+
+#include "Audio/AngularTracker.h"
+#include "Audio/EnergyKernels.h"
+#include "Config/ConfigManager.h"
+#include "Util/FixedWString.h"
+
+namespace Audio
+{
+// Display name of an audio session, stored inline so direction snapshots
+// copy without allocating
+using SessionName = Util::FixedWString<64>;
+
+struct AudioDirection
+{
+    float azimuth{0.0f};
+    float elevation{0.0f};
+    float magnitude{0.0f};
+    bool isBackground{false};
+    SessionName dominantSessionName;
+    // Midpoint of the analysed capture packet on the steady clock
+    std::chrono::steady_clock::time_point captureTime;
+    // Azimuth rate of change (rad/s) and how far it can be trusted (0..1)
+    float azimuthVelocity{0.0f};
+    float velocityConfidence{0.0f};
+};
+
+enum class AnalysisTier
+{
+    Full,    // every frame of the packet
+    Reduced, // only the newest quarter of each packet, when capture is behind
+};
+
+// Turns interleaved float packets into a direction estimate. Holds no
+// device state, so the capture thread and the benchmarks run the same
+// analysis; not thread-safe, one instance per stream.
+class DirectionAnalyzer
+{
+public:
+    enum class KernelChoice
+    {
+        Specialized, // the layout's own kernel when there is one
+        Generic,     // always the generic kernel, for comparison
+    };
+
+    explicit DirectionAnalyzer(std::shared_ptr<Config::ConfigManager> config);
+
+    // Sets the stream layout from its SPEAKER_* channel mask; with a zero
+    // mask channels take the standard speaker order. Picks the energy
+    // kernel for the layout and resets tracking and the tier.
+    void Configure(UINT32 channelCount, DWORD channelMask, KernelChoice kernel = KernelChoice::Specialized) noexcept;
+
+    // Analyses one packet; samples may be null for a silent packet.
+    AudioDirection Analyze(const float* samples, UINT32 frames, std::chrono::steady_clock::time_point captureTime);
+
+    void SetTier(AnalysisTier tier) noexcept { m_tier = tier; }
+    [[nodiscard]] AnalysisTier Tier() const noexcept { return m_tier; }
+
+    [[nodiscard]] UINT32 ChannelCount() const noexcept { return m_channelCount; }
+    [[nodiscard]] const char* KernelName() const noexcept { return m_kernel.name; }
+    [[nodiscard]] bool IsSpatialAudio() const noexcept { return m_isSpatialAudio; }
+    [[nodiscard]] bool IsStereo() const noexcept { return m_isStereo; }
+    [[nodiscard]] bool IsMultichannel() const noexcept { return m_isMultichannel; }
+
+private:
+    AudioDirection ResolveDirection(const ChannelEnergy& energy) const;
+
+    std::shared_ptr<Config::ConfigManager> m_config;
+
+    UINT32 m_channelCount{0};
+    // Speaker position (SPEAKER_* bit) of each interleaved channel
+    std::array<DWORD, kMaxAnalysedChannels> m_speakers{};
+    EnergyKernelInfo m_kernel{GenericEnergyKernel()};
+    AnalysisTier m_tier{AnalysisTier::Full};
+    bool m_isSpatialAudio{false};
+    bool m_isStereo{false};
+    bool m_isMultichannel{false};
+
+    AngularTracker m_tracker;
+};
+}
@@ -0,0 +1,172 @@
+#include "Audio/EnergyKernels.h"
+
+#include <mmreg.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace Audio;
+
+namespace
+{
+constexpr DWORD kStereo = SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT;
+constexpr DWORD kSurround51 = kStereo | SPEAKER_FRONT_CENTER | SPEAKER_LOW_FREQUENCY |
+                              SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT;
+// 5.1 with the surrounds reported as side speakers
+constexpr DWORD kSurround51Side = kStereo | SPEAKER_FRONT_CENTER | SPEAKER_LOW_FREQUENCY |
+                                  SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT;
+constexpr DWORD kSurround71 = kSurround51 | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT;
+constexpr DWORD kSurround714 = kSurround71 | SPEAKER_TOP_FRONT_LEFT | SPEAKER_TOP_FRONT_RIGHT |
+                               SPEAKER_TOP_BACK_LEFT | SPEAKER_TOP_BACK_RIGHT;
+
+constexpr size_t CountChannels(DWORD mask)
+{
+    size_t count = 0;
+    for (; mask != 0; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+// SPEAKER_* bit of each interleaved channel: present speakers in ascending
+// bit order, which is the WAVEFORMATEXTENSIBLE channel order
+template <DWORD Mask>
+constexpr std::array<DWORD, CountChannels(Mask)> SpeakerTable()
+{
+    std::array<DWORD, CountChannels(Mask)> table{};
+    size_t channel = 0;
+    for (DWORD bit = 1; channel < table.size(); bit <<= 1)
+    {
+        if ((Mask & bit) != 0)
+        {
+            table[channel++] = bit;
+        }
+    }
+    return table;
+}
+
+float ToDecibels(float value)
+{
+    constexpr float epsilon = 1e-6f;
+    return 20.0f * std::log10(std::max(value, epsilon));
+}
+
+float NormalizedLevel(double sumOfSquares, UINT32 frames, float thresholdDb)
+{
+    const double rms = std::sqrt(sumOfSquares / std::max<UINT32>(1, frames));
+    const double db = ToDecibels(static_cast<float>(rms));
+    return static_cast<float>(std::clamp((db - thresholdDb) / 60.0, 0.0, 1.0));
+}
+
+void AddSpeaker(ChannelEnergy& energy, DWORD speaker, float normalized)
+{
+    if (speaker & (SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT | SPEAKER_FRONT_CENTER))
+    {
+        energy.front += normalized;
+    }
+    // 把 SIDE 通道也计入“后方”，因为很多 7.1 配置用 SIDE_* 做后环绕
+    if (speaker & (SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT | SPEAKER_BACK_CENTER))
+    {
+        energy.back += normalized;
+    }
+    if (speaker & (SPEAKER_SIDE_LEFT | SPEAKER_BACK_LEFT | SPEAKER_FRONT_LEFT))
+    {
+        energy.left += normalized;
+    }
+    if (speaker & (SPEAKER_SIDE_RIGHT | SPEAKER_BACK_RIGHT | SPEAKER_FRONT_RIGHT))
+    {
+        energy.right += normalized;
+    }
+    if (speaker & (SPEAKER_TOP_FRONT_LEFT | SPEAKER_TOP_FRONT_RIGHT | SPEAKER_TOP_BACK_LEFT | SPEAKER_TOP_BACK_RIGHT))
+    {
+        energy.top += normalized;
+    }
+    if (speaker & (SPEAKER_LOW_FREQUENCY | SPEAKER_BACK_CENTER))
+    {
+        energy.bottom += normalized;
+    }
+}
+
+// The channel count is a compile-time constant, so the per-frame loop over
+// channels is fully unrolled and the stride is known; sums accumulate in
+// the same order as the generic kernel, so results match bit for bit.
+template <DWORD Mask>
+ChannelEnergy FixedLayoutEnergy(const float* samples, UINT32 frames, UINT32, const DWORD*, float thresholdDb)
+{
+    static constexpr auto kSpeakers = SpeakerTable<Mask>();
+    constexpr size_t kChannels = kSpeakers.size();
+
+    std::array<double, kChannels> sums{};
+    for (UINT32 frame = 0; frame < frames; ++frame)
+    {
+        const float* frameSamples = samples + static_cast<size_t>(frame) * kChannels;
+        for (size_t channel = 0; channel < kChannels; ++channel)
+        {
+            const float sample = frameSamples[channel];
+            sums[channel] += sample * sample;
+        }
+    }
+
+    ChannelEnergy energy;
+    for (size_t channel = 0; channel < kChannels; ++channel)
+    {
+        AddSpeaker(energy, kSpeakers[channel], NormalizedLevel(sums[channel], frames, thresholdDb));
+    }
+    return energy;
+}
+
+ChannelEnergy GenericEnergy(const float* samples, UINT32 frames, UINT32 channelCount, const DWORD* speakers, float thresholdDb)
+{
+    std::array<double, kMaxAnalysedChannels> sums{};
+    const UINT32 analysedChannels = std::min(channelCount, kMaxAnalysedChannels);
+
+    for (UINT32 frame = 0; frame < frames; ++frame)
+    {
+        for (UINT32 channel = 0; channel < analysedChannels; ++channel)
+        {
+            const float sample = samples[static_cast<size_t>(frame) * channelCount + channel];
+            sums[channel] += sample * sample;
+        }
+    }
+
+    ChannelEnergy energy;
+    for (UINT32 channel = 0; channel < analysedChannels; ++channel)
+    {
+        AddSpeaker(energy, speakers[channel], NormalizedLevel(sums[channel], frames, thresholdDb));
+    }
+    return energy;
+}
+
+struct LayoutKernel
+{
+    DWORD mask;
+    EnergyKernelInfo info;
+};
+
+constexpr LayoutKernel kLayoutKernels[] = {
+    {kStereo, {"2.0", &FixedLayoutEnergy<kStereo>}},
+    {kSurround51, {"5.1", &FixedLayoutEnergy<kSurround51>}},
+    {kSurround51Side, {"5.1(side)", &FixedLayoutEnergy<kSurround51Side>}},
+    {kSurround71, {"7.1", &FixedLayoutEnergy<kSurround71>}},
+    {kSurround714, {"7.1.4", &FixedLayoutEnergy<kSurround714>}},
+};
+}
+
+EnergyKernelInfo Audio::SelectEnergyKernel(UINT32 channelCount, DWORD channelMask) noexcept
+{
+    for (const auto& layout : kLayoutKernels)
+    {
+        if (layout.mask == channelMask && CountChannels(layout.mask) == channelCount)
+        {
+            return layout.info;
+        }
+    }
+    return GenericEnergyKernel();
+}
+
+EnergyKernelInfo Audio::GenericEnergyKernel() noexcept
+{
+    return {"generic", &GenericEnergy};
+}
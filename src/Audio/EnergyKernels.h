@@ -0,0 +1,39 @@
+#pragma once
+
+#include <windows.h>
+
+namespace Audio
+{
+// Channels past this have no speaker position and are ignored
+constexpr UINT32 kMaxAnalysedChannels = 32;
+
+// Loudness of one packet per direction: every speaker adds its level,
+// normalised to 0..1 above the sensitivity threshold, to each direction it
+// faces.
+struct ChannelEnergy
+{
+    float front{0.0f};
+    float back{0.0f};
+    float left{0.0f};
+    float right{0.0f};
+    float top{0.0f};
+    float bottom{0.0f};
+};
+
+// Computes ChannelEnergy from interleaved float samples. speakers holds the
+// SPEAKER_* bit of each channel; layout-specialised kernels ignore it and
+// use their own compile-time table. All kernels give identical results.
+using EnergyKernel = ChannelEnergy (*)(const float* samples, UINT32 frames, UINT32 channelCount,
+                                       const DWORD* speakers, float thresholdDb);
+
+struct EnergyKernelInfo
+{
+    const char* name; // layout it is specialised for, or "generic"
+    EnergyKernel kernel;
+};
+
+// Kernel specialised for the layout (2.0, 5.1, 7.1, 7.1.4) when there is
+// one, otherwise the generic kernel.
+EnergyKernelInfo SelectEnergyKernel(UINT32 channelCount, DWORD channelMask) noexcept;
+EnergyKernelInfo GenericEnergyKernel() noexcept;
+}
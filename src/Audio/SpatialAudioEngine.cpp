@@ -1,18 +1,21 @@
 #include "Audio/SpatialAudioEngine.h"
 
 #include "Config/ConfigManager.h"
+#include "Diagnostics/AllocationCounter.h"
+#include "Diagnostics/TraceRecorder.h"
 #include "Util/ComException.h"
+#include "Util/PerformanceCounter.h"
+#include "Util/RealtimeScheduling.h"
 
 #include <Functiondiscoverykeys_devpkey.h>
 #include <audiopolicy.h>
 #include <endpointvolume.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <filesystem>
-#include <iterator>
 #include <stdexcept>
-#include <vector>
 
 using namespace Audio;
 
@@ -20,39 +23,113 @@ namespace
 {
 constexpr DWORD kStreamFlags = AUDCLNT_STREAMFLAGS_LOOPBACK | AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
 constexpr REFERENCE_TIME kBufferDuration100ns = 2000000; // 200ms
+constexpr auto kSessionPollInterval = std::chrono::milliseconds(250);
+
+// WASAPI stamps packets with QPC time in 100 ns units. steady_clock is
+// QPC-based on Windows, so the packet's age against QPC now maps it across.
+std::chrono::steady_clock::time_point QpcToSteady(UINT64 qpcPosition)
+{
+    const long long now100ns = static_cast<long long>(Util::QpcNow100ns());
+    const auto now = std::chrono::steady_clock::now();
+    const long long age = std::clamp<long long>(now100ns - static_cast<long long>(qpcPosition), 0, 10'000'000);
+    return now - std::chrono::duration<long long, std::ratio<1, 10'000'000>>(age);
+}
 
 float ToDecibels(float value)
 {
     constexpr float epsilon = 1e-6f;
-    return 20.0f * std::log10f(std::max(value, epsilon));
+    return 20.0f * std::log10(std::max(value, epsilon));
 }
 
-std::wstring GetSessionDisplayName(Microsoft::WRL::ComPtr<IAudioSessionControl2> session)
+void ResolveSessionName(IAudioSessionControl2* session, SessionName& name)
 {
     LPWSTR displayName{};
     if (SUCCEEDED(session->GetDisplayName(&displayName)) && displayName)
     {
-        std::wstring value{displayName};
+        name.Assign(displayName);
         CoTaskMemFree(displayName);
-        if (!value.empty())
+        if (!name.Empty())
         {
-            return value;
+            return;
         }
     }
 
     DWORD pid{};
     if (SUCCEEDED(session->GetProcessId(&pid)))
     {
-        return L"PID " + std::to_wstring(pid);
+        wchar_t buffer[24];
+        swprintf_s(buffer, L"PID %lu", pid);
+        name.Assign(buffer);
+        return;
     }
 
-    return L"System";
+    name.Assign(L"System");
 }
+
+// Raises the engine's flag when an application opens a session on the
+// endpoint. Runs on a thread of the audio service, so it does nothing else.
+class SessionNotifier final : public IAudioSessionNotification
+{
+public:
+    explicit SessionNotifier(std::atomic<bool>& changed) noexcept
+        : m_changed(changed)
+    {
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+    {
+        if (!object)
+        {
+            return E_POINTER;
+        }
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IAudioSessionNotification))
+        {
+            *object = static_cast<IAudioSessionNotification*>(this);
+            AddRef();
+            return S_OK;
+        }
+        *object = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++m_references; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG remaining = --m_references;
+        if (remaining == 0)
+        {
+            delete this;
+        }
+        return remaining;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnSessionCreated(IAudioSessionControl*) override
+    {
+        m_changed.store(true, std::memory_order_release);
+        return S_OK;
+    }
+
+private:
+    ~SessionNotifier() = default;
+
+    std::atomic<bool>& m_changed;
+    std::atomic<ULONG> m_references{1};
+};
 }
 
-SpatialAudioEngine::SpatialAudioEngine(std::shared_ptr<Config::ConfigManager> config)
+SpatialAudioEngine::SpatialAudioEngine(std::shared_ptr<Config::ConfigManager> config,
+                                       Microsoft::WRL::ComPtr<IMMDeviceEnumerator> deviceEnumerator)
     : m_config(std::move(config))
+    , m_deviceEnumerator(std::move(deviceEnumerator))
+    , m_analyzer(m_config)
+    , m_packets(Diagnostics::MetricsRegistry::Instance().GetCounter("audio.packets"))
+    , m_silentPackets(Diagnostics::MetricsRegistry::Instance().GetCounter("audio.silent_packets"))
+    , m_captureFailures(Diagnostics::MetricsRegistry::Instance().GetCounter("audio.capture_failures"))
+    , m_realtime(Diagnostics::MetricsRegistry::Instance().GetGauge("audio.realtime"))
+    , m_analysisTime(Diagnostics::MetricsRegistry::Instance().GetHistogram("audio.analysis"))
 {
+    m_mutex.ReportWaitsTo(&Diagnostics::MetricsRegistry::Instance().GetHistogram("lock.audio_direction"));
 }
 
 SpatialAudioEngine::~SpatialAudioEngine()
@@ -66,20 +143,17 @@ void SpatialAudioEngine::Initialize()
     InitializeAudioClient();
     InitializeSessions();
 
+    m_captureError = S_OK;
     m_running = true;
-    m_captureThread = std::thread(&SpatialAudioEngine::ProcessingLoop, this);
+    m_captureThread = Util::NamedThread("capture", &SpatialAudioEngine::ProcessingLoop, this);
 }
 
 void SpatialAudioEngine::Shutdown()
 {
-    if (!m_running.exchange(false))
+    // Also releases whatever a failed Initialize had set up
+    if (m_running.exchange(false))
     {
-        return;
-    }
-
-    if (m_stopEvent)
-    {
-        SetEvent(m_stopEvent);
+        m_stopEvent.Set();
     }
 
     if (m_captureThread.joinable())
@@ -98,23 +172,21 @@ void SpatialAudioEngine::Shutdown()
         m_waveFormat = nullptr;
     }
 
-    if (m_sampleEvent)
+    m_captureClient.Reset();
+    m_audioClient.Reset();
+    if (m_sessionManager && m_sessionNotification)
     {
-        CloseHandle(m_sampleEvent);
-        m_sampleEvent = nullptr;
+        m_sessionManager->UnregisterSessionNotification(m_sessionNotification.Get());
     }
-
-    if (m_stopEvent)
+    m_sessionNotification.Reset();
+    for (auto& session : m_sessions)
     {
-        CloseHandle(m_stopEvent);
-        m_stopEvent = nullptr;
+        session.meter.Reset();
     }
-
-    m_captureClient.Reset();
-    m_audioClient.Reset();
+    m_sessionCount = 0;
+    m_sessionEnumerator.Reset();
     m_sessionManager.Reset();
     m_device.Reset();
-    m_deviceEnumerator.Reset();
 }
 
 AudioDirection SpatialAudioEngine::GetDirectionSnapshot()
@@ -125,7 +197,10 @@ AudioDirection SpatialAudioEngine::GetDirectionSnapshot()
 
 void SpatialAudioEngine::InitializeDevice()
 {
-    THROW_IF_FAILED(CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&m_deviceEnumerator)));
+    if (!m_deviceEnumerator)
+    {
+        THROW_IF_FAILED(CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&m_deviceEnumerator)));
+    }
     THROW_IF_FAILED(m_deviceEnumerator->GetDefaultAudioEndpoint(eRender, eConsole, &m_device));
 }
 
@@ -146,18 +221,15 @@ void SpatialAudioEngine::InitializeAudioClient()
     const bool isExtensible = (m_waveFormat->wFormatTag == WAVE_FORMAT_EXTENSIBLE);
     const DWORD channelMask = isExtensible ? wfx->dwChannelMask : (SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT);
  
-    // 立体声（典型耳机 / 虚拟环绕终端）
-    m_isStereo = (m_waveFormat->nChannels <= 2) &&
-        ((channelMask & ~(SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT)) == 0);
- 
-    // 多声道（5.1 / 7.1 等）
-    m_isMultichannel = (m_waveFormat->nChannels >= 6);
- 
-    // 是否有明显的空间声道（顶部/后方/侧面）
-    m_isSpatialAudio = (channelMask & (SPEAKER_TOP_FRONT_LEFT | SPEAKER_BACK_LEFT | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT)) != 0;
+    m_analyzer.Configure(m_waveFormat->nChannels, channelMask);
 
-    m_sampleEvent = CreateEventExW(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE);
-    m_stopEvent = CreateEventExW(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE);
+    REFERENCE_TIME devicePeriod{}, minimumPeriod{};
+    THROW_IF_FAILED(m_audioClient->GetDevicePeriod(&devicePeriod, &minimumPeriod));
+    m_health.Configure(m_waveFormat->nSamplesPerSec, devicePeriod);
+
+    // Left over from a previous capture otherwise
+    m_sampleEvent.Reset();
+    m_stopEvent.Reset();
 
     THROW_IF_FAILED(m_audioClient->Initialize(AUDCLNT_SHAREMODE_SHARED,
                                               kStreamFlags,
@@ -166,301 +238,189 @@ void SpatialAudioEngine::InitializeAudioClient()
                                               m_waveFormat,
                                               nullptr));
 
-    THROW_IF_FAILED(m_audioClient->SetEventHandle(m_sampleEvent));
+    THROW_IF_FAILED(m_audioClient->SetEventHandle(m_sampleEvent.Native()));
     THROW_IF_FAILED(m_audioClient->GetService(IID_PPV_ARGS(&m_captureClient)));
 }
 
 void SpatialAudioEngine::InitializeSessions()
 {
     THROW_IF_FAILED(m_device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr, &m_sessionManager));
+
+    // Resolved here rather than on the capture thread; afterwards only when
+    // an application opens a session. Registering needs an enumerator to
+    // have been taken first. Without notifications the set stays as it
+    // was at start.
+    m_sessionsChanged.store(false, std::memory_order_relaxed);
+    RefreshSessions();
+    m_sessionNotification.Attach(new SessionNotifier(m_sessionsChanged));
+    if (FAILED(m_sessionManager->RegisterSessionNotification(m_sessionNotification.Get())))
+    {
+        m_sessionNotification.Reset();
+    }
 }
 
 void SpatialAudioEngine::ProcessingLoop()
 {
-    THROW_IF_FAILED(m_audioClient->Start());
+    TRACE_THREAD_NAME("capture");
+    // Before Start, so the first packets are already read at the raised
+    // priority
+    const auto& policy = m_config->Scheduling().capture;
+    Util::RealtimeScope realtime{policy};
+    // 1 while elevated, -1 when the system refused (MMCSS disabled, no
+    // CAP_SYS_NICE), 0 when not asked for
+    m_realtime.Set(realtime.Elevated() ? 1 : policy.enabled ? -1 : 0);
+    try
+    {
+        CaptureLoop();
+    }
+    catch (const Util::ComException& ex)
+    {
+        // An exception escaping the thread would terminate the app. The
+        // last direction stays on screen; the error is kept for whoever
+        // restarts capture.
+        m_captureError = ex.Result();
+        m_captureFailures.Add();
+    }
+    m_realtime.Set(0);
+}
 
-    HANDLE waitHandles[] = { m_stopEvent, m_sampleEvent };
+void SpatialAudioEngine::CaptureLoop()
+{
+    THROW_IF_FAILED(m_audioClient->Start());
 
     while (m_running)
     {
-        const auto waitResult = WaitForMultipleObjects(static_cast<DWORD>(std::size(waitHandles)), waitHandles, FALSE, INFINITE);
-        if (waitResult == WAIT_OBJECT_0)
+        const int woken = Util::WaitableEvent::WaitAny({&m_stopEvent, &m_sampleEvent});
+        if (woken == 0)
         {
             break;
         }
-        else if (waitResult == WAIT_OBJECT_0 + 1)
+        else if (woken == 1)
         {
+            // Everything the capture thread does per wakeup, session poll
+            // included; zero in steady state
+            ALLOCATION_PROBE("alloc.capture_wakeup");
+            m_health.OnWake(std::chrono::steady_clock::now());
             UINT32 packetFrames = 0;
             THROW_IF_FAILED(m_captureClient->GetNextPacketSize(&packetFrames));
 
             while (packetFrames > 0)
             {
+                TRACE_SCOPE("capture.packet");
                 BYTE* data{};
                 UINT32 framesToRead{};
                 DWORD flags{};
-                THROW_IF_FAILED(m_captureClient->GetBuffer(&data, &framesToRead, &flags, nullptr, nullptr));
-
+                UINT64 qpcPosition{};
+                THROW_IF_FAILED(m_captureClient->GetBuffer(&data, &framesToRead, &flags, nullptr, &qpcPosition));
+                m_health.OnPacket(framesToRead, flags);
+
+                // Direction describes the whole packet, so stamp its midpoint
+                auto captureTime = (flags & AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR) ? std::chrono::steady_clock::now()
+                                                                                 : QpcToSteady(qpcPosition);
+                captureTime += std::chrono::microseconds(
+                    static_cast<long long>(framesToRead) * 500'000 / std::max<DWORD>(1, m_waveFormat->nSamplesPerSec));
+
+                const auto analysisStart = std::chrono::steady_clock::now();
+                m_packets.Add();
                 if ((flags & AUDCLNT_BUFFERFLAGS_SILENT) == 0)
                 {
-                    ProcessBuffer(data, framesToRead);
+                    ProcessBuffer(data, framesToRead, captureTime);
                 }
                 else
                 {
-                    ProcessBuffer(nullptr, framesToRead);
+                    m_silentPackets.Add();
+                    ProcessBuffer(nullptr, framesToRead, captureTime);
                 }
-
-                UpdateDominantSession();
+                m_analysisTime.Record(std::chrono::steady_clock::now() - analysisStart);
 
                 THROW_IF_FAILED(m_captureClient->ReleaseBuffer(framesToRead));
                 THROW_IF_FAILED(m_captureClient->GetNextPacketSize(&packetFrames));
             }
+
+            UpdateDominantSession();
+            m_analyzer.SetTier(m_health.OnDrained(std::chrono::steady_clock::now()));
         }
     }
 }
 
-void SpatialAudioEngine::ProcessBuffer(BYTE* data, UINT32 frames)
+void SpatialAudioEngine::ProcessBuffer(BYTE* data, UINT32 frames, std::chrono::steady_clock::time_point captureTime)
 {
-    const UINT32 channelCount = m_waveFormat->nChannels;
-    ChannelEnergy energy;
-
-    if (data)
-    {
-        const auto* samples = reinterpret_cast<const float*>(data);
-        energy = CalculateChannelEnergy(samples, frames, channelCount);
-    }
-
-    const auto direction = ResolveDirection(energy);
+    TRACE_SCOPE("audio.ProcessBuffer");
+    auto direction = m_analyzer.Analyze(reinterpret_cast<const float*>(data), frames, captureTime);
+    direction.dominantSessionName = m_dominantSession;
 
     std::scoped_lock lock{m_mutex};
     m_latestDirection = direction;
 }
 
-SpatialAudioEngine::ChannelEnergy SpatialAudioEngine::CalculateChannelEnergy(const float* samples, UINT32 frames, UINT32 channelCount) const
+void SpatialAudioEngine::RefreshSessions()
 {
-    ChannelEnergy energy;
-
-    if (!samples || channelCount == 0)
+    TRACE_SCOPE("audio.RefreshSessions");
+    for (size_t i = 0; i < m_sessionCount; ++i)
     {
-        return energy;
+        m_sessions[i].meter.Reset();
     }
+    m_sessionCount = 0;
 
-    std::vector<double> rms(channelCount, 0.0);
-
-    for (UINT32 frame = 0; frame < frames; ++frame)
-    {
-        for (UINT32 channel = 0; channel < channelCount; ++channel)
-        {
-            const auto sample = samples[frame * channelCount + channel];
-            rms[channel] += sample * sample;
-        }
-    }
-
-    for (auto& value : rms)
+    int sessionCount = 0;
+    if (FAILED(m_sessionManager->GetSessionEnumerator(&m_sessionEnumerator)) ||
+        FAILED(m_sessionEnumerator->GetCount(&sessionCount)))
     {
-        value = std::sqrt(value / std::max<UINT32>(1, frames));
+        return;
     }
 
-    const auto wfx = reinterpret_cast<const WAVEFORMATEXTENSIBLE*>(m_waveFormat);
-    const DWORD mask = (m_waveFormat->wFormatTag == WAVE_FORMAT_EXTENSIBLE) ? wfx->dwChannelMask : (SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT);
-
-    auto channelSpeaker = [&](UINT32 index) -> DWORD
+    // Sessions beyond kMaxSessions are not considered
+    for (int i = 0; i < sessionCount && m_sessionCount < kMaxSessions; ++i)
     {
-        static const DWORD speakerOrder[] = {
-            SPEAKER_FRONT_LEFT,
-            SPEAKER_FRONT_RIGHT,
-            SPEAKER_FRONT_CENTER,
-            SPEAKER_LOW_FREQUENCY,
-            SPEAKER_BACK_LEFT,
-            SPEAKER_BACK_RIGHT,
-            SPEAKER_FRONT_LEFT_OF_CENTER,
-            SPEAKER_FRONT_RIGHT_OF_CENTER,
-            SPEAKER_BACK_CENTER,
-            SPEAKER_SIDE_LEFT,
-            SPEAKER_SIDE_RIGHT,
-            SPEAKER_TOP_CENTER,
-            SPEAKER_TOP_FRONT_LEFT,
-            SPEAKER_TOP_FRONT_CENTER,
-            SPEAKER_TOP_FRONT_RIGHT,
-            SPEAKER_TOP_BACK_LEFT,
-            SPEAKER_TOP_BACK_CENTER,
-            SPEAKER_TOP_BACK_RIGHT,
-        };
-
-        if (mask == 0)
-        {
-            return speakerOrder[index < std::size(speakerOrder) ? index : 0];
-        }
-
-        UINT32 bitIndex = 0;
-        for (DWORD speakerBit : speakerOrder)
+        Microsoft::WRL::ComPtr<IAudioSessionControl> control;
+        if (FAILED(m_sessionEnumerator->GetSession(i, &control)))
         {
-            if ((mask & speakerBit) != 0)
-            {
-                if (bitIndex == index)
-                {
-                    return speakerBit;
-                }
-                ++bitIndex;
-            }
+            continue;
         }
 
-        return speakerOrder[index < std::size(speakerOrder) ? index : 0];
-    };
-
-    for (UINT32 channel = 0; channel < channelCount; ++channel)
-    {
-        const double level = rms[channel];
-        const double db = ToDecibels(static_cast<float>(level));
-        const double clampedDb = db - m_config->Sensitivity().thresholdDb;
-        const float normalized = static_cast<float>(std::clamp(clampedDb / 60.0, 0.0, 1.0));
-
-        const DWORD speaker = channelSpeaker(channel);
-
-        if (speaker & (SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT | SPEAKER_FRONT_CENTER))
-        {
-            energy.front += normalized;
-        }
-        // 把 SIDE 通道也计入“后方”，因为很多 7.1 配置用 SIDE_* 做后环绕
-        if (speaker & (SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT | SPEAKER_BACK_CENTER))
-        {
-            energy.back += normalized;
-        }
-        if (speaker & (SPEAKER_SIDE_LEFT | SPEAKER_BACK_LEFT | SPEAKER_FRONT_LEFT))
-        {
-            energy.left += normalized;
-        }
-        if (speaker & (SPEAKER_SIDE_RIGHT | SPEAKER_BACK_RIGHT | SPEAKER_FRONT_RIGHT))
-        {
-            energy.right += normalized;
-        }
-        if (speaker & (SPEAKER_TOP_FRONT_LEFT | SPEAKER_TOP_FRONT_RIGHT | SPEAKER_TOP_BACK_LEFT | SPEAKER_TOP_BACK_RIGHT))
-        {
-            energy.top += normalized;
-        }
-        if (speaker & (SPEAKER_LOW_FREQUENCY | SPEAKER_BACK_CENTER))
+        Microsoft::WRL::ComPtr<IAudioSessionControl2> control2;
+        if (FAILED(control.As(&control2)))
         {
-            energy.bottom += normalized;
+            continue;
         }
-    }
-
-    return energy;
-}
-
-AudioDirection SpatialAudioEngine::ResolveDirection(const ChannelEnergy& energy) const
-{
-    AudioDirection direction;
-
-    float front = m_config->Filter().front ? energy.front : 0.0f;
-    float back = m_config->Filter().back ? energy.back : 0.0f;
-    float left = m_config->Filter().left ? energy.left : 0.0f;
-    float right = m_config->Filter().right ? energy.right : 0.0f;
-    float top = m_config->Filter().up ? energy.top : 0.0f;
-    float bottom = m_config->Filter().down ? energy.bottom : 0.0f;
-
-    const auto overrideMode = m_config->AudioMode();
-
-    // 根据配置和检测结果决定当前是否按“耳机模式（仅左右）”展示
-    const auto overrideMode = m_config->AudioMode();
-    bool headphoneMode = false;
-    if (m_config->AudioMode() == Config::AudioModeOverride::Headphone)
-    {
-        headphoneMode = true;
-    }
-    else if (m_config->AudioMode() == Config::AudioModeOverride::Multichannel)
-    {
-        headphoneMode = false;
-    }
-    else // Auto
-    {
-        headphoneMode = m_isStereo;
-    }
 
-    if (headphoneMode)
-    {
-        front = back = 0.0f;
-        top = bottom = 0.0f;
-    }
-
-    const float horizontalTotal = front + back + left + right;
-    const float verticalTotal = top + bottom;
-    const float magnitude = horizontalTotal + verticalTotal;
-    const float lrTotal = left + right;
-
-    // BGM 检测：左右几乎完全平衡时视为背景音，忽略
-    const float lrTotal = left + right;
-    if ((left + right) > 0.0001f)
-    {
-        const float lrDiff = std::fabs(left - right);
-        const float balance = lrDiff / (left + right);
-        if (balance < 0.1f) // 左右差异低于 10%
+        auto& session = m_sessions[m_sessionCount];
+        if (FAILED(control2.As(&session.meter)))
         {
-            direction.isBackground = true;
-            direction.magnitude = 0.0f;
-            return direction;
+            continue;
         }
+        ResolveSessionName(control2.Get(), session.name);
+        ++m_sessionCount;
     }
-
-    if (magnitude <= 0.001f)
-    {
-        direction.magnitude = 0.0f;
-        return direction;
-    }
-
-    const float x = right - left;
-    const float z = front - back;
-    const float y = top - bottom;
-
-    direction.azimuth = std::atan2f(x, z);
-    direction.elevation = std::atan2f(y, std::sqrt(x * x + z * z));
-    direction.magnitude = magnitude / 6.0f;
-
-    return direction;
 }
 
 void SpatialAudioEngine::UpdateDominantSession()
 {
+    TRACE_SCOPE("audio.UpdateDominantSession");
     if (!m_sessionManager)
     {
         return;
     }
 
-    Microsoft::WRL::ComPtr<IAudioSessionEnumerator> enumerator;
-    if (FAILED(m_sessionManager->GetSessionEnumerator(&enumerator)))
+    // The loudest application changes far more slowly than the packet rate
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastSessionPoll < kSessionPollInterval)
     {
         return;
     }
+    m_lastSessionPoll = now;
 
-    int sessionCount = 0;
-    if (FAILED(enumerator->GetCount(&sessionCount)))
+    if (m_sessionsChanged.exchange(false, std::memory_order_acquire))
     {
-        return;
+        RefreshSessions();
     }
 
     float strongestLevel = -1000.0f;
-    std::wstring strongestName;
-
-    for (int i = 0; i < sessionCount; ++i)
+    const SessionSlot* strongest = nullptr;
+    for (size_t i = 0; i < m_sessionCount; ++i)
     {
-        Microsoft::WRL::ComPtr<IAudioSessionControl> control;
-        if (FAILED(enumerator->GetSession(i, &control)))
-        {
-            continue;
-        }
-
-        Microsoft::WRL::ComPtr<IAudioSessionControl2> control2;
-        if (FAILED(control.As(&control2)))
-        {
-            continue;
-        }
-
-        Microsoft::WRL::ComPtr<IAudioMeterInformation> meter;
-        if (FAILED(control2.As(&meter)))
-        {
-            continue;
-        }
-
         float peak = 0.0f;
-        if (FAILED(meter->GetPeakValue(&peak)))
+        if (FAILED(m_sessions[i].meter->GetPeakValue(&peak)))
         {
             continue;
         }
@@ -469,10 +429,12 @@ void SpatialAudioEngine::UpdateDominantSession()
         if (db > strongestLevel)
         {
             strongestLevel = db;
-            strongestName = GetSessionDisplayName(control2);
+            strongest = &m_sessions[i];
         }
     }
 
+    m_dominantSession = strongest ? strongest->name : SessionName{};
+
     std::scoped_lock lock{m_mutex};
-    m_latestDirection.dominantSessionName = strongestName;
+    m_latestDirection.dominantSessionName = m_dominantSession;
 }
@@ -1,64 +1,59 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include <audioclient.h>
 #include <mmdeviceapi.h>
 #include <audiopolicy.h>
+#include <endpointvolume.h>
 #include <spatialaudiohrtf.h>
 #include <wrl/client.h>
 
+#include "Audio/CaptureHealth.h"
+#include "Audio/DirectionAnalyzer.h"
 #include "Config/ConfigManager.h"
+#include "Diagnostics/MetricsRegistry.h"
+#include "Util/InstrumentedMutex.h"
+#include "Util/NamedThread.h"
+#include "Util/WaitableEvent.h"
 
 namespace Audio
 {
-struct AudioDirection
-{
-    float azimuth{0.0f};
-    float elevation{0.0f};
-    float magnitude{0.0f};
-    bool isBackground{false};
-    std::wstring dominantSessionName;
-};
-
 class SpatialAudioEngine
 {
 public:
-    explicit SpatialAudioEngine(std::shared_ptr<Config::ConfigManager> config);
+    // deviceEnumerator replaces the system MMDeviceEnumerator, e.g. with a
+    // fake endpoint for benchmarks
+    explicit SpatialAudioEngine(std::shared_ptr<Config::ConfigManager> config,
+                                Microsoft::WRL::ComPtr<IMMDeviceEnumerator> deviceEnumerator = nullptr);
     ~SpatialAudioEngine();
 
     void Initialize();
     void Shutdown();
 
     [[nodiscard]] AudioDirection GetDirectionSnapshot();
-    [[nodiscard]] bool IsSpatialAudioActive() const noexcept { return m_isSpatialAudio; }
-    [[nodiscard]] bool IsStereo() const noexcept { return m_isStereo; }
-    [[nodiscard]] bool IsMultichannel() const noexcept { return m_isMultichannel; }
+    [[nodiscard]] bool IsSpatialAudioActive() const noexcept { return m_analyzer.IsSpatialAudio(); }
+    [[nodiscard]] bool IsStereo() const noexcept { return m_analyzer.IsStereo(); }
+    [[nodiscard]] bool IsMultichannel() const noexcept { return m_analyzer.IsMultichannel(); }
+    // Why capture stopped on its own (e.g. AUDCLNT_E_DEVICE_INVALIDATED
+    // when the endpoint goes away), or S_OK while it is running normally
+    [[nodiscard]] HRESULT CaptureError() const noexcept { return m_captureError; }
 
 private:
-    struct ChannelEnergy
-    {
-        float front{0.0f};
-        float back{0.0f};
-        float left{0.0f};
-        float right{0.0f};
-        float top{0.0f};
-        float bottom{0.0f};
-    };
-
     void InitializeDevice();
     void InitializeAudioClient();
     void InitializeSessions();
     void ProcessingLoop();
-    void ProcessBuffer(BYTE* data, UINT32 frames);
-    ChannelEnergy CalculateChannelEnergy(const float* samples, UINT32 frames, UINT32 channelCount) const;
-    AudioDirection ResolveDirection(const ChannelEnergy& energy) const;
+    void CaptureLoop();
+    void ProcessBuffer(BYTE* data, UINT32 frames, std::chrono::steady_clock::time_point captureTime);
+    void RefreshSessions();
     void UpdateDominantSession();
 
     std::shared_ptr<Config::ConfigManager> m_config;
@@ -68,18 +63,45 @@ private:
     Microsoft::WRL::ComPtr<IAudioClient3> m_audioClient;
     Microsoft::WRL::ComPtr<IAudioCaptureClient> m_captureClient;
     Microsoft::WRL::ComPtr<IAudioSessionManager2> m_sessionManager;
+    // Set from the audio service's notification thread when an application
+    // opens a session; the capture thread then refreshes m_sessions
+    std::atomic<bool> m_sessionsChanged{false};
+    Microsoft::WRL::ComPtr<IAudioSessionNotification> m_sessionNotification;
 
-    HANDLE m_sampleEvent{nullptr};
-    HANDLE m_stopEvent{nullptr};
-    std::thread m_captureThread;
+    Util::WaitableEvent m_sampleEvent;
+    Util::WaitableEvent m_stopEvent;
+    Util::NamedThread m_captureThread;
     std::atomic<bool> m_running{false};
+    std::atomic<HRESULT> m_captureError{S_OK};
 
     WAVEFORMATEX* m_waveFormat{nullptr};
-    bool m_isSpatialAudio{false};
-    bool m_isStereo{false};
-    bool m_isMultichannel{false};
 
-    mutable std::mutex m_mutex;
+    // Configured in InitializeAudioClient, then used by the capture thread only
+    DirectionAnalyzer m_analyzer;
+    CaptureHealth m_health;
+    SessionName m_dominantSession;
+    std::chrono::steady_clock::time_point m_lastSessionPoll;
+
+    // Sessions on the endpoint with their meters and names, resolved when
+    // the set changes so the periodic poll only reads peak levels and
+    // never allocates
+    static constexpr size_t kMaxSessions = 32;
+    struct SessionSlot
+    {
+        Microsoft::WRL::ComPtr<IAudioMeterInformation> meter;
+        SessionName name;
+    };
+    Microsoft::WRL::ComPtr<IAudioSessionEnumerator> m_sessionEnumerator;
+    std::array<SessionSlot, kMaxSessions> m_sessions;
+    size_t m_sessionCount{0};
+
+    Diagnostics::Counter& m_packets;
+    Diagnostics::Counter& m_silentPackets;
+    Diagnostics::Counter& m_captureFailures;
+    Diagnostics::Gauge& m_realtime; // 1 elevated, -1 refused, 0 off
+    Util::LatencyHistogram& m_analysisTime; // ProcessBuffer, per packet
+
+    mutable Util::InstrumentedMutex m_mutex;
     AudioDirection m_latestDirection;
 };
 }
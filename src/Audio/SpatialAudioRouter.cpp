@@ -1,8 +1,11 @@
 #include "Audio/SpatialAudioRouter.h"
 
 #include "Config/ConfigManager.h"
+#include "Diagnostics/AllocationCounter.h"
+#include "Diagnostics/TraceRecorder.h"
 #include "Rendering/DirectionVisualizer.h"
 #include "Util/DispatcherTimer.h"
+#include "Util/NamedThread.h"
 
 #include <Psapi.h>
 #include <windows.h>
@@ -33,7 +36,7 @@ void SpatialAudioRouter::Start()
         return;
     }
 
-    m_thread = std::thread(&SpatialAudioRouter::Worker, this);
+    m_thread = Util::NamedThread("router", &SpatialAudioRouter::Worker, this);
     ApplySensitivity();
 }
 
@@ -60,11 +63,13 @@ void SpatialAudioRouter::ApplySensitivity()
 
 void SpatialAudioRouter::Worker()
 {
+    TRACE_THREAD_NAME("router");
     using namespace std::chrono_literals;
     Util::DispatcherTimer timer{16ms};
 
     FILETIME lastKernel{}, lastUser{};
     auto lastSampleTime = std::chrono::steady_clock::now();
+    Util::ThreadLoadMeter threadLoad;
 
     auto evaluateLoad = [&](std::chrono::steady_clock::time_point now)
     {
@@ -95,7 +100,28 @@ void SpatialAudioRouter::Worker()
                 }
 
                 const auto& limits = m_config->Limits();
-                if (cpuPercent > limits.maxCpuPercent || memoryMb > limits.maxMemoryMb)
+                bool throttle = cpuPercent > limits.maxCpuPercent;
+                if (throttle)
+                {
+                    // A slower tick only relieves the router and, through
+                    // fewer updates, the renderer. When capture/analysis is
+                    // what pushes the process over the limit, throttling
+                    // would cost responsiveness without saving anything.
+                    // Loads average over the time since the last overrun.
+                    double totalLoad = 0.0;
+                    double throttledLoad = 0.0;
+                    for (const auto& thread : threadLoad.Update())
+                    {
+                        totalLoad += thread.percentOfCore;
+                        if (thread.name == "router" || thread.name == "render")
+                        {
+                            throttledLoad += thread.percentOfCore;
+                        }
+                    }
+                    throttle = totalLoad <= 0.0 || throttledLoad * 2.0 >= totalLoad;
+                }
+
+                if (throttle || memoryMb > limits.maxMemoryMb)
                 {
                     timer.SetInterval(48ms);
                 }
@@ -114,9 +140,15 @@ void SpatialAudioRouter::Worker()
     while (m_running)
     {
         timer.Wait();
+        TRACE_SCOPE("router.tick");
 
+        // Ahead of the allocation probe: over the CPU limit, the per-thread
+        // breakdown is sampled into freshly built vectors. That only happens
+        // on an overrun, which is not the steady state the probe watches.
         evaluateLoad(std::chrono::steady_clock::now());
 
+        ALLOCATION_PROBE("alloc.router_tick");
+
         if (!m_engine || !m_visualizer)
         {
             continue;
@@ -126,28 +158,28 @@ void SpatialAudioRouter::Worker()
 
         // 计算当前可视化模式并更新 UI 文本
         const auto overrideMode = m_config->AudioMode();
-        std::wstring label;
+        Rendering::ModeLabel label; // inline storage: no allocation per tick
         if (overrideMode == Config::AudioModeOverride::Headphone)
         {
-            label = L"Headphone mode (LR only)";
+            label.Assign(L"Headphone mode (LR only)");
         }
         else if (overrideMode == Config::AudioModeOverride::Multichannel)
         {
-            label = L"Multichannel mode (3D)";
+            label.Assign(L"Multichannel mode (3D)");
         }
         else // Auto
         {
             if (m_engine->IsStereo())
             {
-                label = L"Headphone mode (LR only)";
+                label.Assign(L"Headphone mode (LR only)");
             }
             else if (m_engine->IsMultichannel() || m_engine->IsSpatialAudioActive())
             {
-                label = L"Multichannel mode (3D)";
+                label.Assign(L"Multichannel mode (3D)");
             }
             else
             {
-                label = L"Stereo (LR only)";
+                label.Assign(L"Stereo (LR only)");
             }
         }
 
@@ -185,10 +217,10 @@ void SpatialAudioRouter::Worker()
             presetLabel = L"Aggressive";
         }
 
-        label += L" | Pattern: ";
-        label += presetLabel;
+        label.Append(L" | Pattern: ");
+        label.Append(presetLabel);
 
-        m_visualizer->SetModeLabel(label);
+        m_visualizer->SetModeLabel(label.View());
         m_visualizer->UpdateDirection(direction);
     }
 }
@@ -2,9 +2,9 @@
 
 #include <atomic>
 #include <memory>
-#include <thread>
 
 #include "Audio/SpatialAudioEngine.h"
+#include "Util/NamedThread.h"
 
 namespace Config { class ConfigManager; }
 namespace Rendering { class DirectionVisualizer; }
@@ -32,6 +32,6 @@ private:
     Rendering::DirectionVisualizer* m_visualizer;
 
     std::atomic<bool> m_running{false};
-    std::thread m_thread;
+    Util::NamedThread m_thread;
 };
 }
@@ -0,0 +1,284 @@
+#include "Benchmark/AccuracyBenchmark.h"
+
+#include "Audio/DirectionAnalyzer.h"
+#include "Config/ConfigManager.h"
+#include "Rendering/HitClassifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+using namespace Benchmark;
+
+namespace
+{
+constexpr double kPi = 3.14159265358979323846;
+
+float AngularError(float a, float b)
+{
+    const float difference = std::fmod(std::fabs(a - b), 360.0f);
+    return difference > 180.0f ? 360.0f - difference : difference;
+}
+
+// On lateral-only layouts the engine reports hard left or right
+float ExpectedAzimuth(float azimuthDeg, const LayoutInfo& layout)
+{
+    if (!layout.lateralOnly)
+    {
+        return azimuthDeg;
+    }
+    return std::sin(azimuthDeg * kPi / 180.0) >= 0.0 ? 90.0f : -90.0f;
+}
+
+double Percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    return values[index];
+}
+
+// Bursts of equal level, one at a time, separated by silence
+SceneDescription BurstScene(std::string name, double duration, float musicLevel, std::initializer_list<float> azimuths)
+{
+    SceneDescription scene{std::move(name), duration, musicLevel, {}};
+    double onset = 0.3;
+    for (float azimuth : azimuths)
+    {
+        scene.sources.push_back({azimuth, azimuth, 0.3f, onset, 0.4});
+        onset += 0.7;
+    }
+    return scene;
+}
+}
+
+std::vector<SceneDescription> Benchmark::StandardScenes()
+{
+    std::vector<SceneDescription> scenes;
+
+    scenes.push_back(BurstScene("static_bursts", 6.0, 0.0f, {-60.0f, 60.0f, -120.0f, 120.0f, -90.0f, 90.0f, 0.0f, 180.0f}));
+
+    // One full turn, starting and ending behind the listener
+    scenes.push_back({"moving_sweep", 9.0, 0.0f, {{-180.0f, 180.0f, 0.3f, 0.5, 8.0}}});
+
+    // A quick pan across the front and back again, 120 degrees per second
+    scenes.push_back({"moving_fast", 5.0, 0.0f,
+                      {{-120.0f, 120.0f, 0.3f, 0.3, 2.0}, {120.0f, -120.0f, 0.3f, 2.6, 2.0}}});
+
+    // A quiet steady source with louder bursts from elsewhere on top
+    scenes.push_back({"two_sources", 6.0, 0.0f,
+                      {{-60.0f, -60.0f, 0.1f, 0.2, 5.6},
+                       {120.0f, 120.0f, 0.4f, 1.0, 0.5},
+                       {-150.0f, -150.0f, 0.4f, 2.5, 0.5},
+                       {30.0f, 30.0f, 0.4f, 4.0, 0.5}}});
+
+    scenes.push_back(BurstScene("music_with_bursts", 6.0, 0.2f, {-90.0f, 45.0f, 135.0f, -30.0f, 160.0f, -120.0f, 75.0f, 0.0f}));
+
+    // Nothing to find: every hit is a false positive
+    scenes.push_back({"music_only", 5.0, 0.2f, {}});
+
+    return scenes;
+}
+
+AccuracyResult Benchmark::RunAccuracyScenario(const SceneDescription& scene, SpeakerLayout layout, const AccuracyOptions& options)
+{
+    using Clock = std::chrono::steady_clock;
+
+    SceneGenerator generator{scene, layout, options.sampleRate, options.packetFrames};
+    const auto& layoutInfo = generator.Layout();
+
+    // Default settings, not the user's config.ini, so runs are comparable
+    Audio::DirectionAnalyzer analyzer{std::make_shared<Config::ConfigManager>()};
+    analyzer.Configure(layoutInfo.channelCount, layoutInfo.channelMask);
+
+    AccuracyResult result;
+    result.scene = scene.name;
+    result.layout = layoutInfo.name;
+    result.onsets = static_cast<uint32_t>(scene.sources.size());
+
+    std::vector<double> errors;
+    std::vector<double> displayErrors;
+    std::vector<double> predictedErrors;
+    const auto displayLatency = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(options.displayLatencyMs));
+    std::vector<double> latencies;
+    std::vector<bool> onsetPending(scene.sources.size(), true);
+    Clock::duration analysisTime{};
+
+    while (generator.Next())
+    {
+        const double midpoint = (generator.PacketStart() + generator.PacketEnd()) / 2.0;
+        const auto captureTime = Clock::time_point{} + std::chrono::duration_cast<Clock::duration>(
+                                                          std::chrono::duration<double>(midpoint));
+
+        const auto start = Clock::now();
+        const auto direction = analyzer.Analyze(generator.Samples(), generator.Frames(), captureTime);
+        analysisTime += Clock::now() - start;
+
+        ++result.packets;
+        // Same gate the visualizer applies before drawing a hit
+        const bool detected = !direction.isBackground && direction.magnitude > Rendering::HitClassifier::kMinMagnitude;
+        const float reported = static_cast<float>(direction.azimuth * 180.0 / kPi);
+
+        const auto truth = generator.Truth();
+        if (truth.source >= 0)
+        {
+            ++result.activePackets;
+            if (detected)
+            {
+                ++result.detectedPackets;
+                errors.push_back(AngularError(reported, ExpectedAzimuth(truth.azimuthDeg, layoutInfo)));
+
+                const auto displayed = generator.SourceAzimuth(static_cast<size_t>(truth.source),
+                                                               midpoint + options.displayLatencyMs / 1000.0);
+                if (displayed)
+                {
+                    const float expected = ExpectedAzimuth(*displayed, layoutInfo);
+
+                    Rendering::RadarHitRecord hit;
+                    hit.x = std::sin(direction.azimuth);
+                    hit.z = std::cos(direction.azimuth);
+                    hit.captureTime = direction.captureTime;
+                    hit.azimuthVelocity = direction.azimuthVelocity;
+                    hit.velocityConfidence = direction.velocityConfidence;
+                    Rendering::PredictHit(hit, captureTime + displayLatency);
+                    const float predicted = static_cast<float>(std::atan2(hit.x, hit.z) * 180.0 / kPi);
+
+                    ++result.displayedPackets;
+                    displayErrors.push_back(AngularError(reported, expected));
+                    predictedErrors.push_back(AngularError(predicted, expected));
+                }
+            }
+        }
+        if (truth.quiet)
+        {
+            ++result.quietPackets;
+            result.falsePositives += detected ? 1 : 0;
+        }
+
+        for (size_t s = 0; s < scene.sources.size(); ++s)
+        {
+            if (!onsetPending[s])
+            {
+                continue;
+            }
+
+            const auto& source = scene.sources[s];
+            if (generator.PacketStart() >= source.onsetSeconds + source.durationSeconds)
+            {
+                onsetPending[s] = false;
+                ++result.missedOnsets;
+                continue;
+            }
+
+            const auto azimuth = generator.SourceAzimuth(s, midpoint);
+            if (detected && azimuth &&
+                AngularError(reported, ExpectedAzimuth(*azimuth, layoutInfo)) <= options.detectionToleranceDeg)
+            {
+                onsetPending[s] = false;
+                latencies.push_back((generator.PacketEnd() - source.onsetSeconds) * 1000.0);
+            }
+        }
+    }
+
+    // Sources still pending when the scene ran out
+    result.missedOnsets += static_cast<uint32_t>(std::count(onsetPending.begin(), onsetPending.end(), true));
+
+    result.errorP50Deg = Percentile(errors, 0.50);
+    result.errorP90Deg = Percentile(errors, 0.90);
+    result.errorP99Deg = Percentile(errors, 0.99);
+    result.displayErrorP50Deg = Percentile(displayErrors, 0.50);
+    result.displayErrorP90Deg = Percentile(displayErrors, 0.90);
+    result.predictedErrorP50Deg = Percentile(predictedErrors, 0.50);
+    result.predictedErrorP90Deg = Percentile(predictedErrors, 0.90);
+    result.latencyP50Ms = Percentile(latencies, 0.50);
+    result.latencyMaxMs = latencies.empty() ? 0.0 : latencies.back(); // sorted by Percentile
+
+    const double analysisSeconds = std::chrono::duration<double>(analysisTime).count();
+    const double audioSeconds = static_cast<double>(result.packets) * options.packetFrames / options.sampleRate;
+    if (result.packets > 0)
+    {
+        result.nsPerPacket = analysisSeconds * 1e9 / static_cast<double>(result.packets);
+    }
+    if (analysisSeconds > 0.0)
+    {
+        result.realTimeFactor = audioSeconds / analysisSeconds;
+    }
+
+    return result;
+}
+
+std::vector<AccuracyResult> Benchmark::RunAccuracySuite(const AccuracyOptions& options)
+{
+    std::vector<AccuracyResult> results;
+    for (const auto& scene : StandardScenes())
+    {
+        for (auto layout : kAllLayouts)
+        {
+            results.push_back(RunAccuracyScenario(scene, layout, options));
+        }
+    }
+    return results;
+}
+
+bool Benchmark::WriteAccuracyJson(const std::filesystem::path& path, const AccuracyOptions& options,
+                                  const std::vector<AccuracyResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char line[1024];
+    std::snprintf(line, sizeof(line),
+                  "{\"benchmark\":\"accuracy\",\"sampleRate\":%u,\"packetFrames\":%u,\"toleranceDeg\":%.1f,"
+                  "\"displayLatencyMs\":%.1f,\"scenarios\":[",
+                  options.sampleRate, options.packetFrames, options.detectionToleranceDeg, options.displayLatencyMs);
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        const double detectionRate = result.activePackets
+            ? static_cast<double>(result.detectedPackets) / static_cast<double>(result.activePackets) : 0.0;
+        const double falsePositiveRate = result.quietPackets
+            ? static_cast<double>(result.falsePositives) / static_cast<double>(result.quietPackets) : 0.0;
+
+        std::snprintf(line, sizeof(line),
+                      "{\"scene\":\"%s\",\"layout\":\"%s\",\"packets\":%llu,"
+                      "\"activePackets\":%llu,\"detectionRate\":%.4f,"
+                      "\"errorDeg\":{\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f},"
+                      "\"displayedPackets\":%llu,\"displayErrorDeg\":{\"p50\":%.2f,\"p90\":%.2f},"
+                      "\"predictedErrorDeg\":{\"p50\":%.2f,\"p90\":%.2f},"
+                      "\"onsets\":%u,\"missedOnsets\":%u,\"detectionLatencyMs\":{\"p50\":%.1f,\"max\":%.1f},"
+                      "\"quietPackets\":%llu,\"falsePositiveRate\":%.4f,"
+                      "\"nsPerPacket\":%.0f,\"realTimeFactor\":%.1f}",
+                      result.scene.c_str(), result.layout.c_str(), static_cast<unsigned long long>(result.packets),
+                      static_cast<unsigned long long>(result.activePackets), detectionRate,
+                      result.errorP50Deg, result.errorP90Deg, result.errorP99Deg,
+                      static_cast<unsigned long long>(result.displayedPackets), result.displayErrorP50Deg,
+                      result.displayErrorP90Deg, result.predictedErrorP50Deg, result.predictedErrorP90Deg,
+                      result.onsets, result.missedOnsets, result.latencyP50Ms, result.latencyMaxMs,
+                      static_cast<unsigned long long>(result.quietPackets), falsePositiveRate,
+                      result.nsPerPacket, result.realTimeFactor);
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
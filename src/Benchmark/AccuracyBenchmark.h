@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark/SceneGenerator.h"
+
+namespace Benchmark
+{
+struct AccuracyOptions
+{
+    UINT32 sampleRate{48000};
+    UINT32 packetFrames{480}; // 10 ms, WASAPI's default shared-mode period
+    // A detection within this of the true azimuth counts as finding the source
+    float detectionToleranceDeg{30.0f};
+    // Capture to display: the router's poll, waiting for the next frame
+    // and the frame itself, as render.display_latency measures it
+    double displayLatencyMs{50.0};
+};
+
+// One scene on one speaker layout. Angles are in degrees, times in stream
+// milliseconds (the time a packet completes, when capture could deliver it).
+struct AccuracyResult
+{
+    std::string scene;
+    std::string layout;
+    uint64_t packets{0};
+
+    // Packets with a source playing, and how many of those the engine
+    // reported a direction for
+    uint64_t activePackets{0};
+    uint64_t detectedPackets{0};
+    // Absolute azimuth error of the detected packets
+    double errorP50Deg{0.0};
+    double errorP90Deg{0.0};
+    double errorP99Deg{0.0};
+
+    // Detected packets scored against where the source is once the marker
+    // is on screen, displayLatencyMs after capture: the marker as analysed
+    // and as moved by Rendering::PredictHit. Packets whose source has gone
+    // silent by then are left out.
+    uint64_t displayedPackets{0};
+    double displayErrorP50Deg{0.0};
+    double displayErrorP90Deg{0.0};
+    double predictedErrorP50Deg{0.0};
+    double predictedErrorP90Deg{0.0};
+
+    // Onset to the first detection within tolerance; onsets never found
+    // before the source stopped count as missed
+    uint32_t onsets{0};
+    uint32_t missedOnsets{0};
+    double latencyP50Ms{0.0};
+    double latencyMaxMs{0.0};
+
+    // Packets with no source at all, and how many still produced a hit
+    uint64_t quietPackets{0};
+    uint64_t falsePositives{0};
+
+    // Analysis cost only; scene synthesis is excluded
+    double nsPerPacket{0.0};
+    double realTimeFactor{0.0}; // seconds of audio analysed per second of CPU
+};
+
+// Moving sources, simultaneous sources and music beds, sized to run in a
+// few seconds in total.
+std::vector<SceneDescription> StandardScenes();
+
+AccuracyResult RunAccuracyScenario(const SceneDescription& scene, SpeakerLayout layout, const AccuracyOptions& options);
+
+// Every standard scene on every layout
+std::vector<AccuracyResult> RunAccuracySuite(const AccuracyOptions& options);
+
+bool WriteAccuracyJson(const std::filesystem::path& path, const AccuracyOptions& options,
+                       const std::vector<AccuracyResult>& results);
+}
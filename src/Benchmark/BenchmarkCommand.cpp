@@ -0,0 +1,221 @@
+#include "Benchmark/BenchmarkCommand.h"
+
+#include "Benchmark/AccuracyBenchmark.h"
+#include "Benchmark/CaptureBenchmark.h"
+#include "Benchmark/HitBufferBenchmark.h"
+#include "Benchmark/PacingBenchmark.h"
+#include "Benchmark/RasterBenchmark.h"
+#include "Benchmark/RenderPrepBenchmark.h"
+#include "Benchmark/RenderBenchmark.h"
+#include "Benchmark/ThroughputBenchmark.h"
+
+#include <algorithm>
+#include <cwchar>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Benchmark;
+
+namespace
+{
+// The app is a GUI-subsystem program with no console, so results only
+// ever go to the JSON file and the outcome to the exit code.
+constexpr int kExitSuccess = 0;
+constexpr int kExitWriteFailed = 1;
+constexpr int kExitUsage = 2;
+constexpr int kExitOverBudget = 3;
+constexpr int kExitCaptureFailed = 4;
+constexpr int kExitGoldenMismatch = 5;
+constexpr int kExitPacingFailed = 6;
+// Built with SPATIAL_AUDIO_COUNT_ALLOCATIONS: a capture packet or render
+// frame allocated in steady state
+constexpr int kExitSteadyAllocations = 7;
+
+constexpr wchar_t kDefaultOutput[] = L"benchmark.json";
+
+// Splits on whitespace; double quotes group a path containing spaces.
+std::vector<std::wstring> SplitArguments(PCWSTR commandLine)
+{
+    std::vector<std::wstring> arguments;
+    if (!commandLine)
+    {
+        return arguments;
+    }
+
+    std::wstring current;
+    bool quoted = false;
+    bool pending = false;
+    for (const wchar_t* c = commandLine; *c; ++c)
+    {
+        if (*c == L'"')
+        {
+            quoted = !quoted;
+            pending = true;
+        }
+        else if (!quoted && (*c == L' ' || *c == L'\t'))
+        {
+            if (pending)
+            {
+                arguments.push_back(std::move(current));
+                current.clear();
+                pending = false;
+            }
+        }
+        else
+        {
+            current.push_back(*c);
+            pending = true;
+        }
+    }
+    if (pending)
+    {
+        arguments.push_back(std::move(current));
+    }
+    return arguments;
+}
+}
+
+std::optional<int> Benchmark::RunFromCommandLine(PCWSTR commandLine)
+{
+    const auto arguments = SplitArguments(commandLine);
+    if (arguments.empty() || arguments.front() != L"--benchmark")
+    {
+        return std::nullopt;
+    }
+
+    std::wstring suite = L"accuracy";
+    std::filesystem::path output = kDefaultOutput;
+    ThroughputOptions throughput;
+    RenderOptions render;
+    for (size_t i = 1; i < arguments.size(); ++i)
+    {
+        if (arguments[i] == L"--out" && i + 1 < arguments.size())
+        {
+            output = arguments[++i];
+        }
+        else if (arguments[i] == L"--budget" && i + 1 < arguments.size())
+        {
+            wchar_t* end = nullptr;
+            throughput.budgetCpuPercent = std::wcstod(arguments[++i].c_str(), &end);
+            if (*end != L'\0' || throughput.budgetCpuPercent <= 0.0)
+            {
+                return kExitUsage;
+            }
+        }
+        else if (arguments[i] == L"--golden" && i + 1 < arguments.size())
+        {
+            render.goldenDirectory = arguments[++i];
+        }
+        else if (arguments[i] == L"--update-golden")
+        {
+            render.updateGolden = true;
+        }
+        else if (i == 1 && arguments[i].rfind(L"--", 0) != 0)
+        {
+            suite = arguments[i];
+        }
+        else
+        {
+            return kExitUsage;
+        }
+    }
+
+    if (suite == L"accuracy")
+    {
+        AccuracyOptions options;
+        const auto results = RunAccuracySuite(options);
+        return WriteAccuracyJson(output, options, results) ? kExitSuccess : kExitWriteFailed;
+    }
+
+    if (suite == L"throughput")
+    {
+        const auto results = RunThroughputMatrix(throughput);
+        if (!WriteThroughputJson(output, throughput, results))
+        {
+            return kExitWriteFailed;
+        }
+        const bool withinBudget = std::all_of(results.begin(), results.end(),
+                                              [](const ThroughputResult& result) { return result.withinBudget; });
+        return withinBudget ? kExitSuccess : kExitOverBudget;
+    }
+
+    if (suite == L"capture")
+    {
+        CaptureOptions options;
+        const auto results = RunCaptureSuite(options);
+        if (!WriteCaptureJson(output, options, results))
+        {
+            return kExitWriteFailed;
+        }
+        const bool passed = std::all_of(results.begin(), results.end(),
+                                        [](const CaptureResult& result) { return result.passed; });
+        if (!passed)
+        {
+            return kExitCaptureFailed;
+        }
+        const bool allocationFree = std::all_of(results.begin(), results.end(),
+                                                [](const CaptureResult& result) { return result.steadyAllocations == 0; });
+        return allocationFree ? kExitSuccess : kExitSteadyAllocations;
+    }
+
+    if (suite == L"hits")
+    {
+        HitBufferOptions options;
+        const auto results = RunHitBufferSuite(options);
+        return WriteHitBufferJson(output, options, results) ? kExitSuccess : kExitWriteFailed;
+    }
+
+    if (suite == L"pacing")
+    {
+        PacingOptions options;
+        const auto results = RunPacingSuite(options);
+        if (!WritePacingJson(output, options, results))
+        {
+            return kExitWriteFailed;
+        }
+        const bool passed = std::all_of(results.begin(), results.end(),
+                                        [](const PacingResult& result) { return result.passed; });
+        return passed ? kExitSuccess : kExitPacingFailed;
+    }
+
+    if (suite == L"prep")
+    {
+        RenderPrepOptions options;
+        const auto results = RunRenderPrepSuite(options);
+        return WriteRenderPrepJson(output, options, results) ? kExitSuccess : kExitWriteFailed;
+    }
+
+    if (suite == L"raster")
+    {
+        RasterOptions options;
+        const auto results = RunRasterSuite(options);
+        return WriteRasterJson(output, options, results) ? kExitSuccess : kExitWriteFailed;
+    }
+
+    if (suite == L"render")
+    {
+        if (render.updateGolden && render.goldenDirectory.empty())
+        {
+            return kExitUsage;
+        }
+        // Mismatching frames go next to the results
+        render.failureDirectory = output.has_parent_path() ? output.parent_path() : std::filesystem::path{L"."};
+        const auto results = RunRenderSuite(render);
+        if (!WriteRenderJson(output, render, results))
+        {
+            return kExitWriteFailed;
+        }
+        const bool passed = std::all_of(results.begin(), results.end(),
+                                        [](const RenderResult& result) { return result.passed; });
+        if (!passed)
+        {
+            return kExitGoldenMismatch;
+        }
+        const bool allocationFree = std::all_of(results.begin(), results.end(),
+                                                [](const RenderResult& result) { return result.steadyAllocations == 0; });
+        return allocationFree ? kExitSuccess : kExitSteadyAllocations;
+    }
+
+    return kExitUsage;
+}
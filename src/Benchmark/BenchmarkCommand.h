@@ -0,0 +1,15 @@
+#pragma once
+
+#include <optional>
+
+#include <windows.h>
+
+namespace Benchmark
+{
+// Handles `--benchmark [accuracy|throughput|capture|hits|pacing|prep|raster|render]
+// [--out <file.json>] [--budget <cpu%>] [--golden <dir> [--update-golden]]`
+// on the command line (without the program name, as wWinMain receives it).
+// Returns the process exit code, or nothing when the command line does not
+// ask for a benchmark and the app should start normally.
+std::optional<int> RunFromCommandLine(PCWSTR commandLine);
+}
@@ -0,0 +1,314 @@
+#include "Benchmark/CaptureBenchmark.h"
+
+#include "Audio/SpatialAudioEngine.h"
+#include "Config/ConfigManager.h"
+#include "Diagnostics/AllocationCounter.h"
+#include "Util/NamedThread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+using namespace Benchmark;
+
+namespace
+{
+const char* OutcomeName(CaptureOutcome outcome)
+{
+    switch (outcome)
+    {
+    case CaptureOutcome::Ran:
+        return "ran";
+    case CaptureOutcome::Stopped:
+        return "stopped";
+    case CaptureOutcome::Rejected:
+        return "rejected";
+    }
+    return "unknown";
+}
+
+// Normal-priority threads spinning for the lifetime of the object, the
+// way a game keeps every core busy
+class CpuContention
+{
+public:
+    explicit CpuContention(unsigned threads)
+    {
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            m_threads.emplace_back("contention", &CpuContention::Spin, this);
+        }
+    }
+
+    ~CpuContention()
+    {
+        m_stop = true;
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    CpuContention(const CpuContention&) = delete;
+    CpuContention& operator=(const CpuContention&) = delete;
+
+private:
+    void Spin() const
+    {
+        volatile uint64_t work = 0;
+        while (!m_stop.load(std::memory_order_relaxed))
+        {
+            work = work + 1;
+        }
+    }
+
+    std::atomic<bool> m_stop{false};
+    std::vector<Util::NamedThread> m_threads;
+};
+
+// One slow turn around the listener for as long as capture runs, so every
+// packet carries a direction
+PacketSource SweepSource(SpeakerLayout layout, const FakeCaptureScript& script, const CaptureOptions& options)
+{
+    const double seconds = std::chrono::duration<double>(options.duration).count() + 1.0;
+    auto generator = std::make_shared<SceneGenerator>(
+        SceneDescription{"capture_sweep", seconds, 0.0f, {{-180.0f, 180.0f, 0.3f, 0.0, seconds}}},
+        layout, script.sampleRate, script.packetFrames);
+
+    return [generator](float* samples, UINT32 frames, uint64_t)
+    {
+        const size_t count = static_cast<size_t>(frames) * generator->Layout().channelCount;
+        if (generator->Next())
+        {
+            std::copy_n(generator->Samples(), count, samples);
+        }
+        else
+        {
+            std::fill_n(samples, count, 0.0f);
+        }
+    };
+}
+
+CaptureScenario Scenario(std::string name, SpeakerLayout layout, UINT32 sampleRate, UINT32 packetFrames,
+                         std::chrono::microseconds period, UINT32 burstPackets)
+{
+    CaptureScenario scenario;
+    scenario.name = std::move(name);
+    scenario.layout = layout;
+    scenario.script.sampleRate = sampleRate;
+    scenario.script.packetFrames = packetFrames;
+    scenario.script.period = period;
+    scenario.script.burstPackets = burstPackets;
+    return scenario;
+}
+}
+
+std::vector<CaptureScenario> Benchmark::StandardCaptureScenarios()
+{
+    using std::chrono::microseconds;
+    std::vector<CaptureScenario> scenarios;
+
+    scenarios.push_back(Scenario("steady", SpeakerLayout::Surround71, 48000, 480, microseconds(10'000), 1));
+
+    // Three packets per event, each event up to 5 ms early or late
+    auto jitter = Scenario("jitter_bursts", SpeakerLayout::Surround71, 48000, 480, microseconds(30'000), 3);
+    jitter.script.jitter = microseconds(5'000);
+    scenarios.push_back(std::move(jitter));
+
+    // 3000 packets a second; delivered 30 at a time since no timer wakes
+    // every 333 us
+    scenarios.push_back(Scenario("small_packets_192k", SpeakerLayout::Surround714, 192000, 64, microseconds(10'000), 30));
+
+    auto flags = Scenario("buffer_flags", SpeakerLayout::Surround51, 48000, 480, microseconds(10'000), 1);
+    flags.script.silentEvery = 7;
+    flags.script.discontinuityEvery = 11;
+    flags.script.timestampErrorEvery = 13;
+    scenarios.push_back(std::move(flags));
+
+    // The capture thread only wakes every fourth period, finding four
+    // packets queued each time: sustained backlog
+    auto late = Scenario("late_wakeups", SpeakerLayout::Surround71, 48000, 480, microseconds(10'000), 1);
+    late.script.signalEvery = 4;
+    late.expectReducedTier = true;
+    scenarios.push_back(std::move(late));
+
+    // The endpoint is unplugged one second in
+    auto invalidated = Scenario("device_invalidated", SpeakerLayout::Stereo, 48000, 480, microseconds(10'000), 1);
+    invalidated.script.invalidateAfterPackets = 100;
+    invalidated.expected = CaptureOutcome::Stopped;
+    scenarios.push_back(std::move(invalidated));
+
+    // Plain WAVEFORMATEX carries no channel mask; the engine assumes stereo
+    auto plain = Scenario("plain_float_format", SpeakerLayout::Stereo, 48000, 480, microseconds(10'000), 1);
+    plain.script.extensibleFormat = false;
+    scenarios.push_back(std::move(plain));
+
+    auto pcm = Scenario("pcm_format", SpeakerLayout::Surround71, 48000, 480, microseconds(10'000), 1);
+    pcm.script.floatFormat = false;
+    pcm.expected = CaptureOutcome::Rejected;
+    scenarios.push_back(std::move(pcm));
+
+    // IAudioClient3's low-latency period with two busy threads per core; the
+    // device thread is real-time in both runs, like the system audio engine
+    for (const bool realtime : {false, true})
+    {
+        auto contended = Scenario(realtime ? "contention_realtime" : "contention_normal", SpeakerLayout::Surround71,
+                                  48000, 144, microseconds(3'000), 1);
+        contended.script.realtimeDevice = true;
+        contended.contentionPerCore = 2;
+        contended.realtime = realtime;
+        scenarios.push_back(std::move(contended));
+    }
+
+    return scenarios;
+}
+
+CaptureResult Benchmark::RunCaptureScenario(const CaptureScenario& scenario, const CaptureOptions& options)
+{
+    const auto& layoutInfo = DescribeLayout(scenario.layout);
+
+    FakeCaptureScript script = scenario.script;
+    script.channelCount = layoutInfo.channelCount;
+    script.channelMask = layoutInfo.channelMask;
+    if (!script.source)
+    {
+        script.source = SweepSource(scenario.layout, script, options);
+    }
+
+    CaptureResult result;
+    result.scenario = scenario.name;
+    result.layout = layoutInfo.name;
+    result.contentionThreads = scenario.contentionPerCore * std::max(1u, std::thread::hardware_concurrency());
+
+    auto& registry = Diagnostics::MetricsRegistry::Instance();
+    auto& packets = registry.GetCounter("audio.packets");
+    auto& discontinuities = registry.GetCounter("audio.discontinuities");
+    auto& timestampErrors = registry.GetCounter("audio.timestamp_errors");
+    auto& wakeupAllocations = registry.GetCounter("alloc.capture_wakeup");
+    const uint64_t packetsBefore = packets.Total();
+    const uint64_t discontinuitiesBefore = discontinuities.Total();
+    const uint64_t timestampErrorsBefore = timestampErrors.Total();
+    {
+        FakeAudioEndpoint endpoint{std::move(script)};
+        // Default settings, not the user's config.ini, so runs are comparable
+        auto config = std::make_shared<Config::ConfigManager>();
+        config->Scheduling().capture.enabled = scenario.realtime;
+        Audio::SpatialAudioEngine engine{config, endpoint.Enumerator()};
+        CpuContention contention{result.contentionThreads};
+        try
+        {
+            engine.Initialize();
+            std::this_thread::sleep_for(options.warmup);
+            const uint64_t allocationsBefore = wakeupAllocations.Total();
+            std::this_thread::sleep_for(options.duration - options.warmup);
+            result.steadyAllocations = wakeupAllocations.Total() - allocationsBefore;
+            result.captureError = engine.CaptureError();
+            result.reducedTier = registry.GetGauge("audio.analysis_tier").Value() != 0;
+            result.realtime = registry.GetGauge("audio.realtime").Value() > 0;
+            result.outcome = FAILED(result.captureError) ? CaptureOutcome::Stopped : CaptureOutcome::Ran;
+        }
+        catch (const std::runtime_error&)
+        {
+            result.outcome = CaptureOutcome::Rejected;
+        }
+        engine.Shutdown();
+        result.device = endpoint.Stats();
+    }
+    if (result.outcome != CaptureOutcome::Ran)
+    {
+        // Error paths may allocate; only the packet loop is held to zero
+        result.steadyAllocations = 0;
+    }
+    result.enginePackets = packets.Total() - packetsBefore;
+    result.engineDiscontinuities = discontinuities.Total() - discontinuitiesBefore;
+    result.engineTimestampErrors = timestampErrors.Total() - timestampErrorsBefore;
+
+    // At most one wakeup's worth of packets can be queued at shutdown
+    const uint64_t unread = result.device.delivered - result.device.released - result.device.overflowed;
+    const uint64_t pendingAtShutdown = std::max<uint64_t>(1, scenario.script.burstPackets) *
+                                       std::max<uint64_t>(1, scenario.script.signalEvery);
+    const bool starved = result.contentionThreads > 0 && !result.realtime;
+    result.passed = result.outcome == scenario.expected &&
+                    result.engineDiscontinuities == result.device.discontinuities &&
+                    result.engineTimestampErrors == result.device.timestampErrors &&
+                    (starved || (result.reducedTier == scenario.expectReducedTier && result.device.overflowed == 0 &&
+                                 (result.outcome != CaptureOutcome::Ran || unread <= pendingAtShutdown)));
+    return result;
+}
+
+std::vector<CaptureResult> Benchmark::RunCaptureSuite(const CaptureOptions& options)
+{
+    std::vector<CaptureResult> results;
+    for (const auto& scenario : StandardCaptureScenarios())
+    {
+        results.push_back(RunCaptureScenario(scenario, options));
+    }
+    return results;
+}
+
+bool Benchmark::WriteCaptureJson(const std::filesystem::path& path, const CaptureOptions& options,
+                                 const std::vector<CaptureResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    const bool passed = std::all_of(results.begin(), results.end(),
+                                    [](const CaptureResult& result) { return result.passed; });
+
+    char line[768];
+    std::snprintf(line, sizeof(line), "{\"benchmark\":\"capture\",\"durationMs\":%lld,\"passed\":%s,\"scenarios\":[",
+                  static_cast<long long>(options.duration.count()), passed ? "true" : "false");
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        // null when allocation counting is not compiled in
+        char allocations[24] = "null";
+        if (Diagnostics::kAllocationCountingEnabled)
+        {
+            std::snprintf(allocations, sizeof(allocations), "%llu",
+                          static_cast<unsigned long long>(result.steadyAllocations));
+        }
+        std::snprintf(line, sizeof(line),
+                      "{\"scenario\":\"%s\",\"layout\":\"%s\",\"outcome\":\"%s\",\"captureError\":\"0x%08X\","
+                      "\"delivered\":%llu,\"released\":%llu,\"overflowed\":%llu,\"enginePackets\":%llu,"
+                      "\"discontinuities\":%llu,\"timestampErrors\":%llu,\"analysisTier\":\"%s\","
+                      "\"contentionThreads\":%u,\"realtime\":%s,"
+                      "\"queueLatencyUs\":{\"p50\":%lld,\"p99\":%lld,\"max\":%lld},\"steadyAllocations\":%s,"
+                      "\"passed\":%s}",
+                      result.scenario.c_str(), result.layout.c_str(), OutcomeName(result.outcome),
+                      static_cast<unsigned int>(result.captureError),
+                      static_cast<unsigned long long>(result.device.delivered),
+                      static_cast<unsigned long long>(result.device.released),
+                      static_cast<unsigned long long>(result.device.overflowed),
+                      static_cast<unsigned long long>(result.enginePackets),
+                      static_cast<unsigned long long>(result.engineDiscontinuities),
+                      static_cast<unsigned long long>(result.engineTimestampErrors),
+                      result.reducedTier ? "reduced" : "full", result.contentionThreads,
+                      result.realtime ? "true" : "false",
+                      static_cast<long long>(result.device.latencyP50.count()),
+                      static_cast<long long>(result.device.latencyP99.count()),
+                      static_cast<long long>(result.device.latencyMax.count()), allocations,
+                      result.passed ? "true" : "false");
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark/FakeWasapi.h"
+#include "Benchmark/SceneGenerator.h"
+
+namespace Benchmark
+{
+struct CaptureOptions
+{
+    std::chrono::milliseconds duration{2000}; // of capture per scenario
+    // Start of the steady-state window the allocation check covers
+    std::chrono::milliseconds warmup{500};
+};
+
+enum class CaptureOutcome
+{
+    Ran,      // captured until shut down
+    Stopped,  // the capture thread stopped on a device error
+    Rejected, // SpatialAudioEngine::Initialize threw
+};
+
+// The real SpatialAudioEngine capturing from a scripted fake endpoint
+struct CaptureScenario
+{
+    std::string name;
+    SpeakerLayout layout{SpeakerLayout::Surround71};
+    FakeCaptureScript script; // format fields are filled from the layout
+    CaptureOutcome expected{CaptureOutcome::Ran};
+    // Whether capture should end up on the reduced analysis tier
+    bool expectReducedTier{false};
+    // Busy normal-priority threads per logical processor competing with
+    // capture for the run; 0 none
+    unsigned contentionPerCore{0};
+    // Capture thread on real-time scheduling (SchedulingConfig::capture)
+    bool realtime{false};
+};
+
+struct CaptureResult
+{
+    std::string scenario;
+    std::string layout;
+    CaptureOutcome outcome{CaptureOutcome::Ran};
+    HRESULT captureError{S_OK};
+    // Engine metrics over the run: audio.packets, audio.discontinuities,
+    // audio.timestamp_errors, and audio.analysis_tier at the end
+    uint64_t enginePackets{0};
+    uint64_t engineDiscontinuities{0};
+    uint64_t engineTimestampErrors{0};
+    bool reducedTier{false};
+    unsigned contentionThreads{0};
+    // Whether the capture thread actually got real-time priority
+    bool realtime{false};
+    FakeCaptureStats device;
+    // Heap allocations inside the capture thread's per-wakeup work
+    // (alloc.capture_wakeup: packets, session poll, tier update) from
+    // warmup to shutdown, for runs that captured until shut down. Only
+    // counted with SPATIAL_AUDIO_COUNT_ALLOCATIONS; must stay at zero.
+    uint64_t steadyAllocations{0};
+    // Expected outcome and tier, nothing lost to overflow, every flag the
+    // device set counted once, and every packet the device queued read
+    // except for what was still pending at shutdown. Under contention
+    // without real-time priority only the flag counts are checked; loss is
+    // what the run measures.
+    bool passed{false};
+};
+
+// Steady and jittery delivery, bursts, small packets at 192 kHz, buffer
+// flags, late wakeups, device invalidation, formats the engine must
+// reject, and a 3 ms stream read under CPU contention at normal and at
+// real-time priority.
+std::vector<CaptureScenario> StandardCaptureScenarios();
+
+CaptureResult RunCaptureScenario(const CaptureScenario& scenario, const CaptureOptions& options);
+
+std::vector<CaptureResult> RunCaptureSuite(const CaptureOptions& options);
+
+bool WriteCaptureJson(const std::filesystem::path& path, const CaptureOptions& options,
+                      const std::vector<CaptureResult>& results);
+}
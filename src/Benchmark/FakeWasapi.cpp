@@ -0,0 +1,973 @@
+#include "Benchmark/FakeWasapi.h"
+
+#include "Util/LatencyHistogram.h"
+#include "Util/NamedThread.h"
+#include "Util/PerformanceCounter.h"
+#include "Util/RealtimeScheduling.h"
+#include "Util/WaitableEvent.h"
+
+#include <audiopolicy.h>
+#include <endpointvolume.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <cwchar>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using namespace Benchmark;
+
+namespace
+{
+constexpr long long k100nsPerSecond = 10'000'000;
+constexpr wchar_t kDeviceId[] = L"{fake-loopback-endpoint}";
+
+bool IsEvery(uint64_t packetIndex, UINT32 every)
+{
+    return every != 0 && (packetIndex + 1) % every == 0;
+}
+
+WAVEFORMATEXTENSIBLE BuildFormat(const FakeCaptureScript& script)
+{
+    WAVEFORMATEXTENSIBLE format{};
+    auto& wfx = format.Format;
+    wfx.nChannels = static_cast<WORD>(script.channelCount);
+    wfx.nSamplesPerSec = script.sampleRate;
+    wfx.wBitsPerSample = script.floatFormat ? 32 : 16;
+    wfx.nBlockAlign = static_cast<WORD>(wfx.nChannels * wfx.wBitsPerSample / 8);
+    wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+
+    if (script.extensibleFormat)
+    {
+        wfx.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+        wfx.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+        format.Samples.wValidBitsPerSample = wfx.wBitsPerSample;
+        format.dwChannelMask = script.channelMask;
+        format.SubFormat = script.floatFormat ? KSDATAFORMAT_SUBTYPE_IEEE_FLOAT : KSDATAFORMAT_SUBTYPE_PCM;
+    }
+    else
+    {
+        wfx.wFormatTag = script.floatFormat ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+        wfx.cbSize = 0;
+    }
+    return format;
+}
+
+// IUnknown for a fake implementing Interface. QueryInterface also answers
+// for the interfaces Interface derives from, listed in Bases.
+template <typename Interface, typename... Bases>
+class ComObject : public Interface
+{
+public:
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+    {
+        if (!object)
+        {
+            return E_POINTER;
+        }
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(Interface) || ((riid == __uuidof(Bases)) || ...))
+        {
+            *object = static_cast<Interface*>(this);
+            AddRef();
+            return S_OK;
+        }
+        *object = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++m_references; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        const ULONG remaining = --m_references;
+        if (remaining == 0)
+        {
+            delete this;
+        }
+        return remaining;
+    }
+
+protected:
+    virtual ~ComObject() = default;
+
+private:
+    std::atomic<ULONG> m_references{1};
+};
+
+template <typename Fake, typename... Args>
+HRESULT CreateFake(REFIID riid, void** object, Args&&... args)
+{
+    if (!object)
+    {
+        return E_POINTER;
+    }
+    Microsoft::WRL::ComPtr<Fake> fake;
+    fake.Attach(new Fake(std::forward<Args>(args)...));
+    return fake->QueryInterface(riid, object);
+}
+}
+
+namespace Benchmark::Detail
+{
+// State of the endpoint shared by every interface handed out for it; also
+// runs the device thread that produces packets.
+class FakeDevice
+{
+public:
+    explicit FakeDevice(FakeCaptureScript script)
+        : m_script(std::move(script))
+        , m_format(BuildFormat(m_script))
+        , m_packetBytes(static_cast<size_t>(m_script.packetFrames) * m_format.Format.nBlockAlign)
+        , m_scratch(static_cast<size_t>(m_script.packetFrames) * m_script.channelCount)
+    {
+    }
+
+    ~FakeDevice() { Stop(); }
+
+    FakeDevice(const FakeDevice&) = delete;
+    FakeDevice& operator=(const FakeDevice&) = delete;
+
+    HRESULT Health() const
+    {
+        std::scoped_lock lock{m_mutex};
+        return m_invalidated ? AUDCLNT_E_DEVICE_INVALIDATED : S_OK;
+    }
+
+    HRESULT CopyFormat(WAVEFORMATEX** format) const
+    {
+        if (!format)
+        {
+            return E_POINTER;
+        }
+        const size_t bytes = sizeof(WAVEFORMATEX) + m_format.Format.cbSize;
+        *format = static_cast<WAVEFORMATEX*>(CoTaskMemAlloc(bytes));
+        if (!*format)
+        {
+            return E_OUTOFMEMORY;
+        }
+        std::memcpy(*format, &m_format, bytes);
+        return S_OK;
+    }
+
+    bool MatchesFormat(const WAVEFORMATEX* format) const
+    {
+        return format && format->wFormatTag == m_format.Format.wFormatTag &&
+               format->nChannels == m_format.Format.nChannels &&
+               format->nSamplesPerSec == m_format.Format.nSamplesPerSec &&
+               format->wBitsPerSample == m_format.Format.wBitsPerSample;
+    }
+
+    [[nodiscard]] UINT32 PacketFrames() const noexcept { return m_script.packetFrames; }
+
+    [[nodiscard]] REFERENCE_TIME PacketDuration100ns() const noexcept
+    {
+        return static_cast<REFERENCE_TIME>(m_script.packetFrames) * k100nsPerSecond / m_script.sampleRate;
+    }
+
+    // Reported as the device period: the interval between events
+    [[nodiscard]] REFERENCE_TIME EventPeriod100ns() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::duration<REFERENCE_TIME, std::ratio<1, k100nsPerSecond>>>(
+            m_script.period).count();
+    }
+
+    HRESULT Initialize(REFERENCE_TIME bufferDuration, DWORD streamFlags)
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        if (m_initialized)
+        {
+            return AUDCLNT_E_ALREADY_INITIALIZED;
+        }
+
+        // Shared mode rounds the buffer up to at least one period's worth
+        // of packets; the ring is allocated once, here.
+        const auto bufferFrames = static_cast<UINT32>(
+            std::max(bufferDuration, EventPeriod100ns()) * m_script.sampleRate / k100nsPerSecond);
+        const size_t capacity = std::max<size_t>(1, bufferFrames / m_script.packetFrames);
+        m_ring.assign(capacity, Packet{});
+        for (auto& packet : m_ring)
+        {
+            packet.data.resize(m_packetBytes);
+        }
+        m_eventDriven = (streamFlags & AUDCLNT_STREAMFLAGS_EVENTCALLBACK) != 0;
+        m_initialized = true;
+        return S_OK;
+    }
+
+    HRESULT SetEventHandle(HANDLE event)
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_initialized)
+        {
+            return AUDCLNT_E_NOT_INITIALIZED;
+        }
+        if (!event)
+        {
+            return E_INVALIDARG;
+        }
+        m_event = event;
+        return S_OK;
+    }
+
+    HRESULT GetBufferSize(UINT32* frames) const
+    {
+        if (!frames)
+        {
+            return E_POINTER;
+        }
+        std::scoped_lock lock{m_mutex};
+        if (!m_initialized)
+        {
+            return AUDCLNT_E_NOT_INITIALIZED;
+        }
+        *frames = static_cast<UINT32>(m_ring.size()) * m_script.packetFrames;
+        return S_OK;
+    }
+
+    HRESULT GetPadding(UINT32* frames) const
+    {
+        if (!frames)
+        {
+            return E_POINTER;
+        }
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        *frames = static_cast<UINT32>(m_queued) * m_script.packetFrames;
+        return S_OK;
+    }
+
+    HRESULT Start()
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        if (!m_initialized)
+        {
+            return AUDCLNT_E_NOT_INITIALIZED;
+        }
+        if (m_started)
+        {
+            return AUDCLNT_E_NOT_STOPPED;
+        }
+        if (m_eventDriven && !m_event)
+        {
+            return AUDCLNT_E_EVENTHANDLE_NOT_SET;
+        }
+        m_started = true;
+        m_thread = Util::NamedThread("fake-device", &FakeDevice::DeviceLoop, this);
+        return S_OK;
+    }
+
+    HRESULT Stop()
+    {
+        bool wasStarted = false;
+        {
+            std::scoped_lock lock{m_mutex};
+            wasStarted = m_started;
+            m_started = false;
+        }
+        m_wake.notify_all();
+
+        // The device thread also exits by itself on invalidation
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        return wasStarted ? S_OK : S_FALSE;
+    }
+
+    HRESULT Reset()
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        if (m_started)
+        {
+            return AUDCLNT_E_NOT_STOPPED;
+        }
+        if (m_packetOut)
+        {
+            return AUDCLNT_E_BUFFER_OPERATION_PENDING;
+        }
+        m_queued = 0;
+        m_devicePosition = 0;
+        return S_OK;
+    }
+
+    HRESULT GetNextPacketSize(UINT32* frames) const
+    {
+        if (!frames)
+        {
+            return E_POINTER;
+        }
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        *frames = m_queued > 0 ? m_script.packetFrames : 0;
+        return S_OK;
+    }
+
+    HRESULT GetBuffer(BYTE** data, UINT32* frames, DWORD* flags, UINT64* devicePosition, UINT64* qpcPosition)
+    {
+        if (!data || !frames || !flags)
+        {
+            return E_POINTER;
+        }
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        if (m_packetOut)
+        {
+            return AUDCLNT_E_OUT_OF_ORDER;
+        }
+        if (m_queued == 0)
+        {
+            *data = nullptr;
+            *frames = 0;
+            *flags = 0;
+            return AUDCLNT_S_BUFFER_EMPTY;
+        }
+
+        // The device never writes the head slot while it is handed out
+        auto& packet = m_ring[m_head];
+        *data = packet.data.data();
+        *frames = m_script.packetFrames;
+        *flags = packet.flags;
+        if (devicePosition)
+        {
+            *devicePosition = packet.devicePosition;
+        }
+        if (qpcPosition)
+        {
+            *qpcPosition = packet.qpcPosition;
+        }
+        m_packetOut = true;
+        return S_OK;
+    }
+
+    HRESULT ReleaseBuffer(UINT32 frames)
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_invalidated)
+        {
+            return AUDCLNT_E_DEVICE_INVALIDATED;
+        }
+        if (!m_packetOut)
+        {
+            return AUDCLNT_E_OUT_OF_ORDER;
+        }
+        // Capture packets are released whole, or not at all to read again
+        if (frames != 0 && frames != m_script.packetFrames)
+        {
+            return AUDCLNT_E_INVALID_SIZE;
+        }
+
+        m_packetOut = false;
+        if (frames != 0)
+        {
+            const auto& packet = m_ring[m_head];
+            m_latency.Record(std::chrono::steady_clock::now() - packet.queued);
+            m_silent += (packet.flags & AUDCLNT_BUFFERFLAGS_SILENT) ? 1 : 0;
+            m_discontinuities += (packet.flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) ? 1 : 0;
+            m_timestampErrors += (packet.flags & AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR) ? 1 : 0;
+            m_head = (m_head + 1) % m_ring.size();
+            --m_queued;
+            ++m_released;
+        }
+        return S_OK;
+    }
+
+    FakeCaptureStats Stats() const
+    {
+        std::scoped_lock lock{m_mutex};
+        FakeCaptureStats stats;
+        stats.delivered = m_delivered;
+        stats.released = m_released;
+        stats.overflowed = m_overflowed;
+        stats.silent = m_silent;
+        stats.discontinuities = m_discontinuities;
+        stats.timestampErrors = m_timestampErrors;
+        stats.invalidated = m_invalidated;
+        stats.latencyP50 = m_latency.Percentile(0.50);
+        stats.latencyP99 = m_latency.Percentile(0.99);
+        stats.latencyMax = m_latency.Max();
+        return stats;
+    }
+
+private:
+    struct Packet
+    {
+        std::vector<BYTE> data;
+        DWORD flags{0};
+        UINT64 devicePosition{0};
+        UINT64 qpcPosition{0};
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    void DeviceLoop()
+    {
+        Util::RealtimeScope realtime{Util::RealtimePolicy{m_script.realtimeDevice}};
+
+        // Fixed seed so a script replays the same jitter every run
+        std::minstd_rand random{20240601};
+        const auto jitter = m_script.jitter.count();
+        std::uniform_int_distribution<long long> offset(-jitter, jitter);
+
+        auto due = std::chrono::steady_clock::now();
+        std::unique_lock lock{m_mutex};
+        while (m_started && !m_invalidated)
+        {
+            due += m_script.period;
+            const auto wake = due + std::chrono::microseconds(jitter > 0 ? offset(random) : 0);
+            if (m_wake.wait_until(lock, wake, [this] { return !m_started; }))
+            {
+                break;
+            }
+
+            const auto burstEnd = Util::QpcNow100ns();
+            const UINT32 burst = std::max<UINT32>(1, m_script.burstPackets);
+            for (UINT32 i = 0; i < burst && !m_invalidated; ++i)
+            {
+                // Packets in a burst are consecutive; the last ends now
+                QueuePacket(burstEnd - (burst - i) * PacketDuration100ns());
+            }
+
+            // Signalled without the lock, as the audio engine would
+            ++m_events;
+            const bool signal = m_invalidated || m_events % std::max<UINT32>(1, m_script.signalEvery) == 0;
+            HANDLE event = signal ? m_event : nullptr;
+            lock.unlock();
+            if (event)
+            {
+                Util::WaitableEvent::Set(event);
+            }
+            lock.lock();
+        }
+    }
+
+    // Called with m_mutex held.
+    void QueuePacket(UINT64 qpcPosition)
+    {
+        const uint64_t index = m_delivered;
+        if (m_queued == m_ring.size())
+        {
+            ++m_overflowed;
+            m_pendingDiscontinuity = true;
+            if (m_packetOut)
+            {
+                // The oldest packet is being read; lose this one instead
+                AdvanceDevice(index);
+                return;
+            }
+            m_head = (m_head + 1) % m_ring.size();
+            --m_queued;
+        }
+
+        auto& packet = m_ring[(m_head + m_queued) % m_ring.size()];
+        FillPacket(packet, index);
+
+        packet.flags = 0;
+        if (m_pendingDiscontinuity || IsEvery(index, m_script.discontinuityEvery))
+        {
+            packet.flags |= AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY;
+            m_pendingDiscontinuity = false;
+        }
+        if (IsEvery(index, m_script.silentEvery))
+        {
+            packet.flags |= AUDCLNT_BUFFERFLAGS_SILENT;
+            std::fill(packet.data.begin(), packet.data.end(), BYTE{0});
+        }
+        if (IsEvery(index, m_script.timestampErrorEvery))
+        {
+            packet.flags |= AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR;
+        }
+        packet.devicePosition = m_devicePosition;
+        packet.qpcPosition = qpcPosition;
+        packet.queued = std::chrono::steady_clock::now();
+
+        ++m_queued;
+        AdvanceDevice(index);
+    }
+
+    void AdvanceDevice(uint64_t index)
+    {
+        m_devicePosition += m_script.packetFrames;
+        m_delivered = index + 1;
+        if (m_script.invalidateAfterPackets != 0 && m_delivered >= m_script.invalidateAfterPackets)
+        {
+            m_invalidated = true;
+        }
+    }
+
+    void FillPacket(Packet& packet, uint64_t index)
+    {
+        if (m_script.source)
+        {
+            m_script.source(m_scratch.data(), m_script.packetFrames, index);
+        }
+        else
+        {
+            std::fill(m_scratch.begin(), m_scratch.end(), 0.0f);
+        }
+
+        if (m_script.floatFormat)
+        {
+            std::memcpy(packet.data.data(), m_scratch.data(), m_packetBytes);
+            return;
+        }
+
+        auto* pcm = reinterpret_cast<int16_t*>(packet.data.data());
+        for (size_t i = 0; i < m_scratch.size(); ++i)
+        {
+            pcm[i] = static_cast<int16_t>(std::clamp(m_scratch[i], -1.0f, 1.0f) * 32767.0f);
+        }
+    }
+
+    const FakeCaptureScript m_script;
+    const WAVEFORMATEXTENSIBLE m_format;
+    const size_t m_packetBytes;
+    std::vector<float> m_scratch; // device thread only
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    Util::NamedThread m_thread;
+
+    bool m_initialized{false};
+    bool m_eventDriven{false};
+    bool m_started{false};
+    bool m_invalidated{false};
+    HANDLE m_event{nullptr};
+    uint64_t m_events{0};
+
+    std::vector<Packet> m_ring;
+    size_t m_head{0};
+    size_t m_queued{0};
+    bool m_packetOut{false};
+    bool m_pendingDiscontinuity{false};
+    UINT64 m_devicePosition{0};
+
+    uint64_t m_delivered{0};
+    uint64_t m_released{0};
+    uint64_t m_overflowed{0};
+    uint64_t m_silent{0};
+    uint64_t m_discontinuities{0};
+    uint64_t m_timestampErrors{0};
+    Util::LatencyHistogram m_latency;
+};
+}
+
+using Benchmark::Detail::FakeDevice;
+
+namespace
+{
+class FakeCaptureClient final : public ComObject<IAudioCaptureClient>
+{
+public:
+    explicit FakeCaptureClient(std::shared_ptr<FakeDevice> device) : m_device(std::move(device)) {}
+
+    STDMETHODIMP GetBuffer(BYTE** data, UINT32* frames, DWORD* flags, UINT64* devicePosition, UINT64* qpcPosition) override
+    {
+        return m_device->GetBuffer(data, frames, flags, devicePosition, qpcPosition);
+    }
+
+    STDMETHODIMP ReleaseBuffer(UINT32 frames) override { return m_device->ReleaseBuffer(frames); }
+
+    STDMETHODIMP GetNextPacketSize(UINT32* frames) override { return m_device->GetNextPacketSize(frames); }
+
+private:
+    std::shared_ptr<FakeDevice> m_device;
+};
+
+class FakeAudioClient final : public ComObject<IAudioClient3, IAudioClient2, IAudioClient>
+{
+public:
+    explicit FakeAudioClient(std::shared_ptr<FakeDevice> device) : m_device(std::move(device)) {}
+
+    STDMETHODIMP Initialize(AUDCLNT_SHAREMODE shareMode, DWORD streamFlags, REFERENCE_TIME bufferDuration,
+                            REFERENCE_TIME, const WAVEFORMATEX* format, LPCGUID) override
+    {
+        if (shareMode != AUDCLNT_SHAREMODE_SHARED || (streamFlags & AUDCLNT_STREAMFLAGS_LOOPBACK) == 0)
+        {
+            // Only shared-mode loopback capture is simulated
+            return AUDCLNT_E_WRONG_ENDPOINT_TYPE;
+        }
+        if (!m_device->MatchesFormat(format))
+        {
+            return AUDCLNT_E_UNSUPPORTED_FORMAT;
+        }
+        return m_device->Initialize(bufferDuration, streamFlags);
+    }
+
+    STDMETHODIMP GetBufferSize(UINT32* frames) override { return m_device->GetBufferSize(frames); }
+
+    STDMETHODIMP GetStreamLatency(REFERENCE_TIME* latency) override
+    {
+        if (!latency)
+        {
+            return E_POINTER;
+        }
+        *latency = m_device->EventPeriod100ns();
+        return m_device->Health();
+    }
+
+    STDMETHODIMP GetCurrentPadding(UINT32* frames) override { return m_device->GetPadding(frames); }
+
+    STDMETHODIMP IsFormatSupported(AUDCLNT_SHAREMODE shareMode, const WAVEFORMATEX* format, WAVEFORMATEX** closestMatch) override
+    {
+        if (closestMatch)
+        {
+            *closestMatch = nullptr;
+        }
+        return shareMode == AUDCLNT_SHAREMODE_SHARED && m_device->MatchesFormat(format) ? S_OK : AUDCLNT_E_UNSUPPORTED_FORMAT;
+    }
+
+    STDMETHODIMP GetMixFormat(WAVEFORMATEX** format) override
+    {
+        const HRESULT health = m_device->Health();
+        return FAILED(health) ? health : m_device->CopyFormat(format);
+    }
+
+    STDMETHODIMP GetDevicePeriod(REFERENCE_TIME* defaultPeriod, REFERENCE_TIME* minimumPeriod) override
+    {
+        if (defaultPeriod)
+        {
+            *defaultPeriod = m_device->EventPeriod100ns();
+        }
+        if (minimumPeriod)
+        {
+            *minimumPeriod = m_device->EventPeriod100ns();
+        }
+        return m_device->Health();
+    }
+
+    STDMETHODIMP Start() override { return m_device->Start(); }
+    STDMETHODIMP Stop() override { return m_device->Stop(); }
+    STDMETHODIMP Reset() override { return m_device->Reset(); }
+    STDMETHODIMP SetEventHandle(HANDLE event) override { return m_device->SetEventHandle(event); }
+
+    STDMETHODIMP GetService(REFIID riid, void** service) override
+    {
+        if (riid != __uuidof(IAudioCaptureClient))
+        {
+            if (service)
+            {
+                *service = nullptr;
+            }
+            return E_NOINTERFACE;
+        }
+        const HRESULT health = m_device->Health();
+        return FAILED(health) ? health : CreateFake<FakeCaptureClient>(riid, service, m_device);
+    }
+
+    STDMETHODIMP IsOffloadCapable(AUDIO_STREAM_CATEGORY, BOOL* offloadCapable) override
+    {
+        if (!offloadCapable)
+        {
+            return E_POINTER;
+        }
+        *offloadCapable = FALSE;
+        return S_OK;
+    }
+
+    STDMETHODIMP SetClientProperties(const AudioClientProperties*) override { return S_OK; }
+
+    STDMETHODIMP GetBufferSizeLimits(const WAVEFORMATEX*, BOOL, REFERENCE_TIME*, REFERENCE_TIME*) override
+    {
+        return E_NOTIMPL;
+    }
+
+    STDMETHODIMP GetSharedModeEnginePeriod(const WAVEFORMATEX*, UINT32* defaultPeriod, UINT32* fundamentalPeriod,
+                                           UINT32* minPeriod, UINT32* maxPeriod) override
+    {
+        for (UINT32* frames : {defaultPeriod, fundamentalPeriod, minPeriod, maxPeriod})
+        {
+            if (frames)
+            {
+                *frames = m_device->PacketFrames();
+            }
+        }
+        return m_device->Health();
+    }
+
+    STDMETHODIMP GetCurrentSharedModeEnginePeriod(WAVEFORMATEX** format, UINT32* periodFrames) override
+    {
+        if (periodFrames)
+        {
+            *periodFrames = m_device->PacketFrames();
+        }
+        return GetMixFormat(format);
+    }
+
+    STDMETHODIMP InitializeSharedAudioStream(DWORD streamFlags, UINT32, const WAVEFORMATEX* format, LPCGUID sessionGuid) override
+    {
+        return Initialize(AUDCLNT_SHAREMODE_SHARED, streamFlags, 0, 0, format, sessionGuid);
+    }
+
+private:
+    std::shared_ptr<FakeDevice> m_device;
+};
+
+// No application is playing anything
+class FakeSessionMeter final : public ComObject<IAudioMeterInformation>
+{
+public:
+    STDMETHODIMP GetPeakValue(float* peak) override
+    {
+        if (!peak)
+        {
+            return E_POINTER;
+        }
+        *peak = 0.5f;
+        return S_OK;
+    }
+};
+
+// The one application playing on the endpoint, so the engine's session
+// poll has a meter to read on every wakeup it runs
+class FakeSession final : public ComObject<IAudioSessionControl2, IAudioSessionControl>
+{
+public:
+    FakeSession() { m_meter.Attach(new FakeSessionMeter); }
+
+    STDMETHODIMP QueryInterface(REFIID riid, void** object) override
+    {
+        if (object && riid == __uuidof(IAudioMeterInformation))
+        {
+            return m_meter.CopyTo(reinterpret_cast<IAudioMeterInformation**>(object));
+        }
+        return ComObject::QueryInterface(riid, object);
+    }
+
+    STDMETHODIMP GetDisplayName(LPWSTR* name) override
+    {
+        if (!name)
+        {
+            return E_POINTER;
+        }
+        static constexpr wchar_t kName[] = L"Benchmark";
+        *name = static_cast<LPWSTR>(CoTaskMemAlloc(sizeof(kName)));
+        if (!*name)
+        {
+            return E_OUTOFMEMORY;
+        }
+        std::memcpy(*name, kName, sizeof(kName));
+        return S_OK;
+    }
+
+    STDMETHODIMP GetProcessId(DWORD* pid) override
+    {
+        if (!pid)
+        {
+            return E_POINTER;
+        }
+        *pid = 1;
+        return S_OK;
+    }
+
+private:
+    Microsoft::WRL::ComPtr<IAudioMeterInformation> m_meter;
+};
+
+class FakeSessionEnumerator final : public ComObject<IAudioSessionEnumerator>
+{
+public:
+    STDMETHODIMP GetCount(int* count) override
+    {
+        if (!count)
+        {
+            return E_POINTER;
+        }
+        *count = 1;
+        return S_OK;
+    }
+
+    STDMETHODIMP GetSession(int index, IAudioSessionControl** session) override
+    {
+        if (index != 0)
+        {
+            if (session)
+            {
+                *session = nullptr;
+            }
+            return E_INVALIDARG;
+        }
+        return CreateFake<FakeSession>(__uuidof(IAudioSessionControl), reinterpret_cast<void**>(session));
+    }
+};
+
+class FakeSessionManager final : public ComObject<IAudioSessionManager2, IAudioSessionManager>
+{
+public:
+    explicit FakeSessionManager(std::shared_ptr<FakeDevice> device) : m_device(std::move(device)) {}
+
+    STDMETHODIMP GetAudioSessionControl(LPCGUID, DWORD, IAudioSessionControl**) override { return E_NOTIMPL; }
+    STDMETHODIMP GetSimpleAudioVolume(LPCGUID, DWORD, ISimpleAudioVolume**) override { return E_NOTIMPL; }
+
+    STDMETHODIMP GetSessionEnumerator(IAudioSessionEnumerator** sessions) override
+    {
+        const HRESULT health = m_device->Health();
+        if (FAILED(health))
+        {
+            return health;
+        }
+        return CreateFake<FakeSessionEnumerator>(__uuidof(IAudioSessionEnumerator), reinterpret_cast<void**>(sessions));
+    }
+
+    STDMETHODIMP RegisterSessionNotification(IAudioSessionNotification*) override { return S_OK; }
+    STDMETHODIMP UnregisterSessionNotification(IAudioSessionNotification*) override { return S_OK; }
+    STDMETHODIMP RegisterDuckNotification(LPCWSTR, IAudioVolumeDuckNotification*) override { return S_OK; }
+    STDMETHODIMP UnregisterDuckNotification(IAudioVolumeDuckNotification*) override { return S_OK; }
+
+private:
+    std::shared_ptr<FakeDevice> m_device;
+};
+
+class FakeMMDevice final : public ComObject<IMMDevice>
+{
+public:
+    explicit FakeMMDevice(std::shared_ptr<FakeDevice> device) : m_device(std::move(device)) {}
+
+    STDMETHODIMP Activate(REFIID iid, DWORD, PROPVARIANT*, void** object) override
+    {
+        const HRESULT health = m_device->Health();
+        if (FAILED(health))
+        {
+            return health;
+        }
+        if (iid == __uuidof(IAudioClient3) || iid == __uuidof(IAudioClient2) || iid == __uuidof(IAudioClient))
+        {
+            return CreateFake<FakeAudioClient>(iid, object, m_device);
+        }
+        if (iid == __uuidof(IAudioSessionManager2) || iid == __uuidof(IAudioSessionManager))
+        {
+            return CreateFake<FakeSessionManager>(iid, object, m_device);
+        }
+        if (object)
+        {
+            *object = nullptr;
+        }
+        return E_NOINTERFACE;
+    }
+
+    STDMETHODIMP OpenPropertyStore(DWORD, IPropertyStore**) override { return E_NOTIMPL; }
+
+    STDMETHODIMP GetId(LPWSTR* id) override
+    {
+        if (!id)
+        {
+            return E_POINTER;
+        }
+        *id = static_cast<LPWSTR>(CoTaskMemAlloc(sizeof(kDeviceId)));
+        if (!*id)
+        {
+            return E_OUTOFMEMORY;
+        }
+        std::memcpy(*id, kDeviceId, sizeof(kDeviceId));
+        return S_OK;
+    }
+
+    STDMETHODIMP GetState(DWORD* state) override
+    {
+        if (!state)
+        {
+            return E_POINTER;
+        }
+        *state = SUCCEEDED(m_device->Health()) ? DEVICE_STATE_ACTIVE : DEVICE_STATE_NOTPRESENT;
+        return S_OK;
+    }
+
+private:
+    std::shared_ptr<FakeDevice> m_device;
+};
+
+// Knows a single render endpoint, which is also the default
+class FakeDeviceEnumerator final : public ComObject<IMMDeviceEnumerator>
+{
+public:
+    explicit FakeDeviceEnumerator(std::shared_ptr<FakeDevice> device) : m_device(std::move(device)) {}
+
+    STDMETHODIMP EnumAudioEndpoints(EDataFlow, DWORD, IMMDeviceCollection**) override { return E_NOTIMPL; }
+
+    STDMETHODIMP GetDefaultAudioEndpoint(EDataFlow dataFlow, ERole, IMMDevice** endpoint) override
+    {
+        if (!endpoint)
+        {
+            return E_POINTER;
+        }
+        *endpoint = nullptr;
+        if (dataFlow != eRender || FAILED(m_device->Health()))
+        {
+            return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+        }
+        return CreateFake<FakeMMDevice>(__uuidof(IMMDevice), reinterpret_cast<void**>(endpoint), m_device);
+    }
+
+    STDMETHODIMP GetDevice(LPCWSTR id, IMMDevice** device) override
+    {
+        if (!id || !device)
+        {
+            return E_POINTER;
+        }
+        if (std::wcscmp(id, kDeviceId) != 0)
+        {
+            *device = nullptr;
+            return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+        }
+        return GetDefaultAudioEndpoint(eRender, eConsole, device);
+    }
+
+    STDMETHODIMP RegisterEndpointNotificationCallback(IMMNotificationClient*) override { return S_OK; }
+    STDMETHODIMP UnregisterEndpointNotificationCallback(IMMNotificationClient*) override { return S_OK; }
+
+private:
+    std::shared_ptr<FakeDevice> m_device;
+};
+}
+
+FakeAudioEndpoint::FakeAudioEndpoint(FakeCaptureScript script)
+    : m_device(std::make_shared<FakeDevice>(std::move(script)))
+{
+}
+
+FakeAudioEndpoint::~FakeAudioEndpoint()
+{
+    // Clients may still hold interfaces; the device itself lives on until
+    // they are released, but stops producing now
+    m_device->Stop();
+}
+
+Microsoft::WRL::ComPtr<IMMDeviceEnumerator> FakeAudioEndpoint::Enumerator() const
+{
+    Microsoft::WRL::ComPtr<IMMDeviceEnumerator> enumerator;
+    enumerator.Attach(new FakeDeviceEnumerator(m_device));
+    return enumerator;
+}
+
+FakeCaptureStats FakeAudioEndpoint::Stats() const
+{
+    return m_device->Stats();
+}
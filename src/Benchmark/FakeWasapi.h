@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <audioclient.h>
+#include <mmdeviceapi.h>
+#include <mmreg.h>
+#include <wrl/client.h>
+
+namespace Benchmark
+{
+// Fills one packet of interleaved float samples; packetIndex counts from 0
+using PacketSource = std::function<void(float* samples, UINT32 frames, uint64_t packetIndex)>;
+
+// Behaviour of a simulated loopback endpoint
+struct FakeCaptureScript
+{
+    UINT32 channelCount{2};
+    DWORD channelMask{SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT};
+    UINT32 sampleRate{48000};
+    bool extensibleFormat{true}; // WAVEFORMATEXTENSIBLE rather than a plain WAVEFORMATEX
+    bool floatFormat{true};      // IEEE float; 16-bit PCM otherwise
+
+    UINT32 packetFrames{480};
+    std::chrono::microseconds period{10'000}; // between device events; the device period
+    std::chrono::microseconds jitter{0};      // each event lands up to this early or late
+    UINT32 burstPackets{1};                   // packets queued per event
+    // The event handle is only set on every Nth event, leaving the client
+    // N periods behind each time it wakes, as when it is starved of CPU
+    UINT32 signalEvery{1};
+
+    // Every Nth packet carries the flag; 0 never
+    UINT32 silentEvery{0};         // AUDCLNT_BUFFERFLAGS_SILENT
+    UINT32 discontinuityEvery{0};  // AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY
+    UINT32 timestampErrorEvery{0}; // AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR
+
+    // After this many packets every call fails with
+    // AUDCLNT_E_DEVICE_INVALIDATED, as when the endpoint is unplugged; 0 never
+    uint64_t invalidateAfterPackets{0};
+
+    // Run the device thread at real-time priority, as the Windows audio
+    // engine does, so CPU contention delays the client and not the device
+    bool realtimeDevice{false};
+
+    PacketSource source; // silence when empty
+};
+
+struct FakeCaptureStats
+{
+    uint64_t delivered{0};  // packets queued by the device
+    uint64_t released{0};   // packets the client read and released
+    uint64_t overflowed{0}; // dropped because the client fell a whole buffer behind
+    // Released packets that carried each flag
+    uint64_t silent{0};
+    uint64_t discontinuities{0};
+    uint64_t timestampErrors{0};
+    bool invalidated{false};
+    // Packet ready to ReleaseBuffer
+    std::chrono::microseconds latencyP50{0};
+    std::chrono::microseconds latencyP99{0};
+    std::chrono::microseconds latencyMax{0};
+};
+
+namespace Detail { class FakeDevice; }
+
+// A loopback endpoint implemented in-process, for driving the real
+// SpatialAudioEngine without audio hardware. Enumerator() hands out fakes
+// of IMMDeviceEnumerator, IMMDevice, IAudioClient3, IAudioCaptureClient and
+// IAudioSessionManager2 (with no sessions). After IAudioClient::Start a
+// device thread queues scripted packets and signals the event handle the
+// way WASAPI does; a client that falls a whole buffer behind loses the
+// oldest packet and sees a discontinuity on the next.
+class FakeAudioEndpoint
+{
+public:
+    explicit FakeAudioEndpoint(FakeCaptureScript script);
+    ~FakeAudioEndpoint();
+
+    FakeAudioEndpoint(const FakeAudioEndpoint&) = delete;
+    FakeAudioEndpoint& operator=(const FakeAudioEndpoint&) = delete;
+
+    [[nodiscard]] Microsoft::WRL::ComPtr<IMMDeviceEnumerator> Enumerator() const;
+    [[nodiscard]] FakeCaptureStats Stats() const;
+
+private:
+    std::shared_ptr<Detail::FakeDevice> m_device;
+};
+}
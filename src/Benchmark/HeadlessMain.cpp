@@ -0,0 +1,49 @@
+#include "Benchmark/BenchmarkCommand.h"
+
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Console entry point of SpatialAudioBenchmark, which runs the benchmark
+// suites without the overlay - on CI, and on hosts without WASAPI where the
+// capture suite still drives the real capture loop against the fake
+// endpoint. Takes the same arguments as the app:
+//   SpatialAudioBenchmark --benchmark capture --out capture.json
+namespace
+{
+std::wstring Widen(const char* argument)
+{
+    const size_t length = std::mbstowcs(nullptr, argument, 0);
+    if (length == static_cast<size_t>(-1))
+    {
+        // Not valid in the locale's encoding; keep the bytes as they are
+        return std::wstring(argument, argument + std::strlen(argument));
+    }
+    std::wstring wide(length, L'\0');
+    std::mbstowcs(wide.data(), argument, length);
+    return wide;
+}
+}
+
+int main(int argc, char** argv)
+{
+    std::setlocale(LC_ALL, "");
+
+    // RunFromCommandLine splits the way wWinMain's command line is split
+    std::wstring commandLine;
+    for (int i = 1; i < argc; ++i)
+    {
+        commandLine += commandLine.empty() ? L"\"" : L" \"";
+        commandLine += Widen(argv[i]);
+        commandLine += L'"';
+    }
+
+    if (const auto exitCode = Benchmark::RunFromCommandLine(commandLine.c_str()))
+    {
+        return *exitCode;
+    }
+    std::fprintf(stderr, "usage: %s --benchmark <suite> [--out <file.json>] [--budget <cpu%%>] [--golden <dir> [--update-golden]]\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,255 @@
+#include "Benchmark/HitBufferBenchmark.h"
+
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/RadarPainter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <system_error>
+
+using namespace Benchmark;
+using namespace Rendering;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr float kPi = 3.14159265358979323846f;
+constexpr double kFrameRate = 60.0;
+
+double Percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    return values[index];
+}
+
+// Hits of the whole run, generated up front so only the store is timed;
+// frame f owns hits [frameStart[f], frameStart[f + 1])
+struct HitStream
+{
+    std::vector<RadarHitRecord> hits;
+    std::vector<size_t> frameStart;
+    std::vector<Clock::time_point> frameTime;
+};
+
+HitStream GenerateStream(uint32_t hitsPerSecond, double seconds)
+{
+    HitStream stream;
+    const auto epoch = Clock::time_point{} + std::chrono::hours(1);
+    const auto frames = static_cast<size_t>(seconds * kFrameRate);
+    std::mt19937 generator{hitsPerSecond};
+
+    for (size_t frame = 0; frame < frames; ++frame)
+    {
+        stream.frameStart.push_back(stream.hits.size());
+        stream.frameTime.push_back(epoch + std::chrono::duration_cast<Clock::duration>(
+                                               std::chrono::duration<double>((frame + 1) / kFrameRate)));
+
+        const auto first = static_cast<uint64_t>(hitsPerSecond * frame / kFrameRate);
+        const auto last = static_cast<uint64_t>(hitsPerSecond * (frame + 1) / kFrameRate);
+        for (uint64_t k = first; k < last; ++k)
+        {
+            const float azimuth = static_cast<float>(generator() % 3600) / 3600.0f * 2.0f * kPi - kPi;
+            RadarHitRecord hit;
+            hit.x = std::sin(azimuth);
+            hit.z = std::cos(azimuth);
+            hit.radiusFactor = 0.12f + static_cast<float>(generator() % 880) / 1000.0f;
+            hit.magnitude = 0.15f + static_cast<float>(generator() % 850) / 1000.0f;
+            hit.pattern = static_cast<RadarPattern>(1 + generator() % 3);
+            hit.time = epoch + std::chrono::duration_cast<Clock::duration>(
+                                   std::chrono::duration<double>(static_cast<double>(k) / hitsPerSecond));
+            hit.captureTime = hit.time;
+            stream.hits.push_back(hit);
+        }
+    }
+    stream.frameStart.push_back(stream.hits.size());
+    return stream;
+}
+
+// The radar as it is, through RadarHitBuffer
+class RingStore
+{
+public:
+    explicit RingStore(bool coalesce)
+        : m_coalesce(coalesce)
+    {
+    }
+
+    void Insert(const RadarHitRecord& hit) noexcept
+    {
+        if (m_coalesce)
+        {
+            m_hits.PushCoalesced(hit, kRadarHitCoalesceWindow);
+        }
+        else
+        {
+            m_hits.Push(hit);
+        }
+    }
+
+    void Frame(Clock::time_point now) noexcept
+    {
+        m_hits.ExpireBefore(now - kRadarTrailDuration);
+        m_hits.UpdateFades(now, kRadarTrailDuration);
+    }
+
+    [[nodiscard]] size_t Stored() const noexcept { return m_hits.Size(); }
+
+    [[nodiscard]] size_t Live() const noexcept
+    {
+        size_t live = 0;
+        for (size_t i = 0; i < m_hits.Size(); ++i)
+        {
+            live += m_hits.Live(i) && m_hits.Fade(i) >= 0.0f ? 1 : 0;
+        }
+        return live;
+    }
+
+private:
+    bool m_coalesce;
+    RadarHitBuffer m_hits; // ~40 KB, hence make_unique below
+};
+
+// What the radar did before RadarHitBuffer: one growing array compacted
+// with erase(remove_if) and a per-hit fade from its age
+class VectorStore
+{
+public:
+    void Insert(const RadarHitRecord& hit) { m_hits.push_back({hit, 0.0f}); }
+
+    void Frame(Clock::time_point now)
+    {
+        const auto cutoff = now - kRadarTrailDuration;
+        m_hits.erase(std::remove_if(m_hits.begin(), m_hits.end(),
+                                    [cutoff](const Entry& entry) { return entry.hit.time <= cutoff; }),
+                     m_hits.end());
+
+        const float trailSeconds = std::chrono::duration<float>(kRadarTrailDuration).count();
+        for (auto& entry : m_hits)
+        {
+            const float age = std::chrono::duration<float>(now - entry.hit.time).count();
+            entry.fade = std::clamp(1.0f - age / trailSeconds, 0.0f, 1.0f);
+        }
+    }
+
+    [[nodiscard]] size_t Stored() const noexcept { return m_hits.size(); }
+    [[nodiscard]] size_t Live() const noexcept { return m_hits.size(); }
+
+private:
+    struct Entry
+    {
+        RadarHitRecord hit;
+        float fade;
+    };
+    std::vector<Entry> m_hits;
+};
+
+template <typename Store>
+HitBufferResult Measure(Store& store, const HitStream& stream, const char* name, uint32_t hitsPerSecond)
+{
+    HitBufferResult result;
+    result.store = name;
+    result.hitsPerSecond = hitsPerSecond;
+    result.hits = stream.hits.size();
+    result.frames = stream.frameTime.size();
+
+    // Frames before the store first holds a full trail are not steady state
+    const auto warmup = stream.frameTime.front() + kRadarTrailDuration;
+
+    std::vector<double> frameTimes;
+    Clock::duration insertTime{};
+    for (size_t frame = 0; frame < stream.frameTime.size(); ++frame)
+    {
+        const auto insertStart = Clock::now();
+        for (size_t i = stream.frameStart[frame]; i < stream.frameStart[frame + 1]; ++i)
+        {
+            store.Insert(stream.hits[i]);
+        }
+        const auto frameStart = Clock::now();
+        store.Frame(stream.frameTime[frame]);
+        const auto frameEnd = Clock::now();
+
+        insertTime += frameStart - insertStart;
+        if (stream.frameTime[frame] >= warmup)
+        {
+            frameTimes.push_back(std::chrono::duration<double, std::micro>(frameEnd - frameStart).count());
+        }
+        result.peakStored = std::max(result.peakStored, store.Stored());
+        result.peakLive = std::max(result.peakLive, store.Live());
+    }
+
+    if (result.hits > 0)
+    {
+        result.nsPerHit = std::chrono::duration<double, std::nano>(insertTime).count() / static_cast<double>(result.hits);
+    }
+    result.frameP50Us = Percentile(frameTimes, 0.50);
+    result.frameP99Us = Percentile(frameTimes, 0.99);
+    return result;
+}
+}
+
+std::vector<HitBufferResult> Benchmark::RunHitBufferSuite(const HitBufferOptions& options)
+{
+    std::vector<HitBufferResult> results;
+    for (uint32_t rate : options.hitsPerSecond)
+    {
+        const auto stream = GenerateStream(rate, options.seconds);
+
+        auto coalesced = std::make_unique<RingStore>(true);
+        results.push_back(Measure(*coalesced, stream, "ring_coalesced", rate));
+
+        auto ring = std::make_unique<RingStore>(false);
+        results.push_back(Measure(*ring, stream, "ring", rate));
+
+        VectorStore vector;
+        results.push_back(Measure(vector, stream, "vector", rate));
+    }
+    return results;
+}
+
+bool Benchmark::WriteHitBufferJson(const std::filesystem::path& path, const HitBufferOptions& options,
+                                   const std::vector<HitBufferResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "{\"benchmark\":\"hits\",\"seconds\":%.1f,\"capacity\":%zu,\"runs\":[",
+                  options.seconds, RadarHitBuffer::kCapacity);
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        std::snprintf(line, sizeof(line),
+                      "{\"store\":\"%s\",\"hitsPerSecond\":%u,\"hits\":%llu,\"frames\":%llu,\"nsPerHit\":%.1f,"
+                      "\"frameUs\":{\"p50\":%.2f,\"p99\":%.2f},\"peakStored\":%zu,\"peakLive\":%zu}",
+                      result.store.c_str(), result.hitsPerSecond, static_cast<unsigned long long>(result.hits),
+                      static_cast<unsigned long long>(result.frames), result.nsPerHit, result.frameP50Us,
+                      result.frameP99Us, result.peakStored, result.peakLive);
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
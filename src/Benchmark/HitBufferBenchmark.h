@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+struct HitBufferOptions
+{
+    double seconds{4.0}; // of scene time per run, frames at 60 Hz
+    std::vector<uint32_t> hitsPerSecond{1000, 4000, 16000};
+};
+
+// One hit store fed a steady stream of scattered hits. Per frame the hits
+// that arrived since the last one are inserted, then the store expires
+// everything older than the radar trail and computes the fade of what is
+// left - the work DirectionVisualizer does before painting.
+struct HitBufferResult
+{
+    // ring_coalesced: RadarHitBuffer::PushCoalesced, as the radar uses it
+    // ring: RadarHitBuffer::Push, which overwrites the oldest hit when full
+    // vector: std::vector with push_back and erase(remove_if), for reference
+    std::string store;
+    uint32_t hitsPerSecond{0};
+    uint64_t hits{0};
+    uint64_t frames{0};
+    double nsPerHit{0.0}; // insert cost
+    // Expiry plus fade pass, after the first trail duration filled the store
+    double frameP50Us{0.0};
+    double frameP99Us{0.0};
+    size_t peakStored{0}; // entries, including ones merged away
+    size_t peakLive{0};   // hits that would be drawn
+};
+
+std::vector<HitBufferResult> RunHitBufferSuite(const HitBufferOptions& options);
+
+bool WriteHitBufferJson(const std::filesystem::path& path, const HitBufferOptions& options,
+                        const std::vector<HitBufferResult>& results);
+}
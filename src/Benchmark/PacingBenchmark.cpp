@@ -0,0 +1,233 @@
+#include "Benchmark/PacingBenchmark.h"
+
+#include "Rendering/FrameClock.h"
+#include "Util/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+using namespace Benchmark;
+using namespace Rendering;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+enum class Compositor
+{
+    None,        // IntervalFrameClock alone
+    Vblank,      // waits for the next vblank
+    Unavailable, // fails at once
+    Immediate,   // succeeds at once
+    Occasional,  // waits for vblank, except that every tenth wait succeeds at once
+    Lost,        // waits for vblank for the first half of the run, then fails
+};
+
+struct PacingScenario
+{
+    const char* name;
+    Compositor compositor;
+    bool expectFallback;
+};
+
+constexpr PacingScenario kScenarios[] = {
+    {"interval", Compositor::None, false},
+    {"compositor", Compositor::Vblank, false},
+    {"compositor_unavailable", Compositor::Unavailable, true},
+    {"compositor_immediate", Compositor::Immediate, true},
+    {"compositor_short_waits", Compositor::Occasional, false},
+    {"compositor_lost", Compositor::Lost, true},
+};
+
+// Stands in for DwmFlush: vblanks fall on a fixed grid from the start of
+// the run
+class SimulatedCompositor
+{
+public:
+    SimulatedCompositor(Compositor mode, Clock::duration interval, uint32_t workingWaits)
+        : m_mode(mode)
+        , m_interval(interval)
+        , m_origin(Clock::now())
+        , m_workingWaits(workingWaits)
+    {
+    }
+
+    bool Wait()
+    {
+        switch (m_mode)
+        {
+        case Compositor::Unavailable:
+            return false;
+        case Compositor::Immediate:
+            return true;
+        case Compositor::Occasional:
+            if (++m_waits % 10 == 0)
+            {
+                return true;
+            }
+            break;
+        case Compositor::Lost:
+            if (m_waits >= m_workingWaits)
+            {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+
+        if (m_mode != Compositor::Occasional)
+        {
+            ++m_waits;
+        }
+        const auto vblanks = (Clock::now() - m_origin) / m_interval + 1;
+        std::this_thread::sleep_until(m_origin + vblanks * m_interval);
+        return true;
+    }
+
+private:
+    Compositor m_mode;
+    Clock::duration m_interval;
+    Clock::time_point m_origin;
+    uint32_t m_workingWaits;
+    uint32_t m_waits{0};
+};
+
+void Spin(Clock::duration work)
+{
+    const auto end = Clock::now() + work;
+    while (Clock::now() < end)
+    {
+    }
+}
+
+PacingResult RunScenario(const PacingScenario& scenario, const PacingOptions& options)
+{
+    PacingResult result;
+    result.scenario = scenario.name;
+
+    auto compositor = std::make_shared<SimulatedCompositor>(scenario.compositor, options.interval, options.frames / 2);
+    std::unique_ptr<FrameClock> clock;
+    CompositorFrameClock* compositorClock = nullptr;
+    if (scenario.compositor == Compositor::None)
+    {
+        clock = std::make_unique<IntervalFrameClock>(options.interval);
+    }
+    else
+    {
+        auto paced = std::make_unique<CompositorFrameClock>([compositor] { return compositor->Wait(); },
+                                                            options.interval);
+        compositorClock = paced.get();
+        clock = std::move(paced);
+    }
+
+    // Same bucketing as the render thread's present-interval histogram
+    Util::LatencyHistogram intervals;
+    const auto half = options.interval / 2;
+    const auto stall = options.interval + options.interval / 2;
+
+    auto lastWake = Clock::now();
+    for (uint32_t frame = 0; frame < options.frames; ++frame)
+    {
+        clock->WaitForNextFrame();
+        const auto wake = Clock::now();
+        const auto interval = wake - lastWake;
+        lastWake = wake;
+
+        const bool fellBack = compositorClock && compositorClock->FellBack();
+        if (fellBack && result.fallbackFrame < 0)
+        {
+            // The frame that noticed draws straight away; pacing by the
+            // fallback starts with the next one
+            result.fallbackFrame = frame + 1;
+        }
+
+        // Intervals before the first wake, and for the fallback scenarios
+        // before the fallback paced a frame, are not steady state
+        const bool measured = frame > 0 && (!scenario.expectFallback ||
+                                            (result.fallbackFrame >= 0 && frame >= result.fallbackFrame));
+        if (measured)
+        {
+            intervals.Record(interval);
+            result.bursts += interval < half ? 1 : 0;
+            result.stalls += interval > stall ? 1 : 0;
+        }
+
+        Spin(options.work);
+    }
+
+    result.fellBack = compositorClock && compositorClock->FellBack();
+    result.intervalP50 = intervals.Percentile(0.50);
+    result.intervalP99 = intervals.Percentile(0.99);
+    result.intervalMax = intervals.Max();
+
+    // Histogram percentiles are bucket upper bounds, up to a quarter octave
+    // above the samples
+    const auto lowest = options.interval * 5 / 6;
+    const auto highest = options.interval * 6 / 5;
+    result.passed = result.fellBack == scenario.expectFallback && intervals.Count() > 0 &&
+                    result.intervalP50 >= lowest && result.intervalP50 <= highest;
+    return result;
+}
+}
+
+std::vector<PacingResult> Benchmark::RunPacingSuite(const PacingOptions& options)
+{
+    std::vector<PacingResult> results;
+    for (const auto& scenario : kScenarios)
+    {
+        results.push_back(RunScenario(scenario, options));
+    }
+    return results;
+}
+
+bool Benchmark::WritePacingJson(const std::filesystem::path& path, const PacingOptions& options,
+                                const std::vector<PacingResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    const bool passed = std::all_of(results.begin(), results.end(),
+                                    [](const PacingResult& result) { return result.passed; });
+
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "{\"benchmark\":\"pacing\",\"frames\":%u,\"intervalUs\":%lld,\"workUs\":%lld,\"passed\":%s,"
+                  "\"scenarios\":[",
+                  options.frames, static_cast<long long>(options.interval.count()),
+                  static_cast<long long>(options.work.count()), passed ? "true" : "false");
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        std::snprintf(line, sizeof(line),
+                      "{\"scenario\":\"%s\",\"fellBack\":%s,\"fallbackFrame\":%lld,"
+                      "\"intervalUs\":{\"p50\":%lld,\"p99\":%lld,\"max\":%lld},\"bursts\":%llu,\"stalls\":%llu,"
+                      "\"passed\":%s}",
+                      result.scenario.c_str(), result.fellBack ? "true" : "false",
+                      static_cast<long long>(result.fallbackFrame), static_cast<long long>(result.intervalP50.count()),
+                      static_cast<long long>(result.intervalP99.count()),
+                      static_cast<long long>(result.intervalMax.count()),
+                      static_cast<unsigned long long>(result.bursts), static_cast<unsigned long long>(result.stalls),
+                      result.passed ? "true" : "false");
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+struct PacingOptions
+{
+    uint32_t frames{120}; // per scenario
+    std::chrono::microseconds interval{16667}; // simulated vblank and fallback
+    std::chrono::microseconds work{1000};      // busy render time per frame
+};
+
+// The render loop's frame clock driven for a fixed number of frames against
+// a simulated compositor: the fixed-interval clock alone, a compositor wait
+// that blocks until the next vblank, one that fails (composition off), one
+// that returns at once (DwmFlush with nothing changing), one that only
+// occasionally returns at once, which must not fall back, and one that
+// stops working halfway through.
+struct PacingResult
+{
+    std::string scenario;
+    bool fellBack{false};
+    // First frame paced by the fixed interval instead of the compositor;
+    // -1 when the clock never fell back
+    int64_t fallbackFrame{-1};
+    // Wake-to-wake intervals, as render.present_interval records them, and
+    // after the fallback for the fallback scenarios
+    std::chrono::microseconds intervalP50{0};
+    std::chrono::microseconds intervalP99{0};
+    std::chrono::microseconds intervalMax{0};
+    // Late wakes: a stall, and with the interval clock's fixed deadlines a
+    // short interval after it
+    uint64_t bursts{0}; // intervals under half the frame interval
+    uint64_t stalls{0}; // intervals over one and a half
+    // The clock fell back exactly when expected and the median paced
+    // interval is within a histogram bucket of the frame interval - not
+    // the render time alone (no wait) or two intervals (a double wait)
+    bool passed{false};
+};
+
+std::vector<PacingResult> RunPacingSuite(const PacingOptions& options);
+
+bool WritePacingJson(const std::filesystem::path& path, const PacingOptions& options,
+                     const std::vector<PacingResult>& results);
+}
@@ -0,0 +1,182 @@
+#include "Benchmark/RasterBenchmark.h"
+
+#include "Rendering/PolarHeatmap.h"
+#include "Rendering/RadarFrame.h"
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/RadarPainter.h"
+#include "Rendering/SoftwareRenderBackend.h"
+#include "Rendering/WaterfallStrip.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <system_error>
+
+using namespace Benchmark;
+using namespace Rendering;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr float kPi = 3.14159265358979323846f;
+
+double Percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    return values[index];
+}
+
+// One frame's worth of every content type, independent of surface size
+struct RasterContent
+{
+    RadarHitBuffer hits;
+    PolarHeatmap heatmap;
+    WaterfallStrip waterfall;
+};
+
+std::unique_ptr<RasterContent> BuildContent(size_t hitCount)
+{
+    auto content = std::make_unique<RasterContent>();
+    content->heatmap.SetPalette(0x40, 0xC0, 0xFF, 0.85f);
+    content->waterfall.SetPalette(0x40, 0xC0, 0xFF, 0.85f);
+
+    const auto now = Clock::time_point{} + std::chrono::hours(1);
+    const auto trail = std::chrono::duration_cast<Clock::duration>(kRadarTrailDuration);
+    std::mt19937 generator{34};
+    for (size_t i = 0; i < hitCount; ++i)
+    {
+        // Spread over the trail so the markers cover the whole fade range
+        const float azimuth = static_cast<float>(generator() % 3600) / 3600.0f * 2.0f * kPi - kPi;
+        RadarHitRecord hit;
+        hit.x = std::sin(azimuth);
+        hit.z = std::cos(azimuth);
+        hit.radiusFactor = 0.12f + static_cast<float>(generator() % 880) / 1000.0f;
+        hit.magnitude = static_cast<float>(generator() % 2000) / 1000.0f;
+        hit.pattern = static_cast<RadarPattern>(1 + generator() % 3);
+        hit.time = now - trail + trail * static_cast<Clock::rep>(i) / static_cast<Clock::rep>(hitCount + 1);
+        content->hits.Push(hit);
+
+        content->heatmap.Accumulate(hit.x, hit.z, HitRadiusFraction(hit.radiusFactor, hit.pattern, 1.0f),
+                                    0.5f + hit.magnitude);
+    }
+    content->hits.UpdateFades(now, kRadarTrailDuration);
+
+    // A full strip: a few hits per column
+    content->waterfall.Advance(now);
+    for (size_t column = 1; column <= WaterfallStrip::kColumns; ++column)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const float azimuth = static_cast<float>(generator() % 3600) / 3600.0f * 2.0f * kPi - kPi;
+            content->waterfall.Accumulate(std::sin(azimuth), std::cos(azimuth), 0.5f + (generator() % 1000) / 1000.0f);
+        }
+        content->waterfall.Advance(now + column * WaterfallStrip::kColumnPeriod);
+    }
+    return content;
+}
+
+RasterResult MeasureSize(RasterContent& content, const char* name, size_t size, const RasterOptions& options)
+{
+    RasterResult result;
+    result.content = name;
+    result.size = size;
+
+    SoftwareRenderBackend surface{size, size};
+    SoftwareRenderBackend staticLayer{size, size};
+
+    const float extent = static_cast<float>(size);
+    RadarFrame frame;
+    frame.center = {extent / 2.0f, extent / 2.0f};
+    frame.radius = extent * 0.45f;
+    PaintRadarBackground(staticLayer, frame.style, frame.center, frame.radius);
+    const RenderRect whole{0.0f, 0.0f, extent, extent};
+
+    const bool heatmap = result.content == "heatmap";
+    const bool waterfall = result.content == "waterfall";
+    std::vector<double> frameTimes;
+    std::vector<double> cachedFrameTimes;
+    for (uint32_t i = 0; i < options.frames; ++i)
+    {
+        for (const bool cached : {false, true})
+        {
+            const auto start = Clock::now();
+            // The heatmap texture is rebuilt every frame it decays
+            frame.heatmap = heatmap ? content.heatmap.Rasterize() : nullptr;
+            frame.waterfall = waterfall ? &content.waterfall : nullptr;
+            frame.hits = heatmap || waterfall ? nullptr : &content.hits;
+            frame.background = cached ? &staticLayer : nullptr;
+            PaintRadarFrame(surface, frame, whole);
+            (cached ? cachedFrameTimes : frameTimes)
+                .push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+    }
+
+    result.frameP50Us = Percentile(frameTimes, 0.50);
+    result.frameP99Us = Percentile(frameTimes, 0.99);
+    result.nsPerPixel = result.frameP50Us * 1000.0 / static_cast<double>(size * size);
+    result.cachedFrameP50Us = Percentile(cachedFrameTimes, 0.50);
+    result.cachedFrameP99Us = Percentile(cachedFrameTimes, 0.99);
+    return result;
+}
+}
+
+std::vector<RasterResult> Benchmark::RunRasterSuite(const RasterOptions& options)
+{
+    const auto content = BuildContent(options.hits);
+
+    std::vector<RasterResult> results;
+    for (const char* name : {"radar", "heatmap", "waterfall"})
+    {
+        for (size_t size : options.sizes)
+        {
+            results.push_back(MeasureSize(*content, name, size, options));
+        }
+    }
+    return results;
+}
+
+bool Benchmark::WriteRasterJson(const std::filesystem::path& path, const RasterOptions& options,
+                                const std::vector<RasterResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "{\"benchmark\":\"raster\",\"frames\":%u,\"hits\":%zu,\"vectorized\":%s,\"runs\":[",
+                  options.frames, options.hits, SoftwareRenderBackend::Vectorized() ? "true" : "false");
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        std::snprintf(line, sizeof(line),
+                      "{\"content\":\"%s\",\"size\":%zu,\"frameUs\":{\"p50\":%.1f,\"p99\":%.1f},\"nsPerPixel\":%.2f,"
+                      "\"cachedFrameUs\":{\"p50\":%.1f,\"p99\":%.1f}}",
+                      result.content.c_str(), result.size, result.frameP50Us, result.frameP99Us, result.nsPerPixel,
+                      result.cachedFrameP50Us, result.cachedFrameP99Us);
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+struct RasterOptions
+{
+    std::vector<size_t> sizes{320, 512, 768, 1024}; // square surfaces, pixels
+    uint32_t frames{30}; // repaints timed per size and content
+    size_t hits{200};    // live markers in the radar content
+};
+
+// SoftwareRenderBackend repainting one fixed frame - what the layered
+// window draws for a full redraw - at a range of window sizes
+struct RasterResult
+{
+    std::string content; // radar (markers), heatmap or waterfall
+    size_t size{0};
+    // Whole surface, background painted
+    double frameP50Us{0.0};
+    double frameP99Us{0.0};
+    double nsPerPixel{0.0}; // p50 over the surface area
+    // Whole surface over the cached static layer
+    double cachedFrameP50Us{0.0};
+    double cachedFrameP99Us{0.0};
+};
+
+std::vector<RasterResult> RunRasterSuite(const RasterOptions& options);
+
+bool WriteRasterJson(const std::filesystem::path& path, const RasterOptions& options,
+                     const std::vector<RasterResult>& results);
+}
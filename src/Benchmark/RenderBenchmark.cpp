@@ -0,0 +1,535 @@
+#include "Benchmark/RenderBenchmark.h"
+
+#include "Audio/DirectionAnalyzer.h"
+#include "Config/ConfigManager.h"
+#include "Diagnostics/AllocationCounter.h"
+#include "Rendering/HitClassifier.h"
+#include "Rendering/RadarFrame.h"
+#include "Rendering/RadarScene.h"
+#include "Rendering/SoftwareRenderBackend.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <system_error>
+
+using namespace Benchmark;
+using namespace Rendering;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr float kPi = 3.14159265358979323846f;
+// One analysed direction every 10 ms, frames at 60 Hz of scene time
+constexpr auto kDirectionPeriod = std::chrono::milliseconds(10);
+constexpr double kFrameRate = 60.0;
+
+// Direction for tick t (kDirectionPeriod apart); magnitude 0 is silence
+using DirectionSource = std::function<Audio::AudioDirection(uint32_t tick)>;
+
+struct RenderScene
+{
+    std::string name;
+    Config::VisualizationMode mode{Config::VisualizationMode::Radar};
+    uint32_t ticks{0};
+    DirectionSource source;
+};
+
+Audio::AudioDirection Direction(float azimuthDeg, float elevationDeg, float magnitude)
+{
+    Audio::AudioDirection direction;
+    direction.azimuth = azimuthDeg * kPi / 180.0f;
+    direction.elevation = elevationDeg * kPi / 180.0f;
+    direction.magnitude = magnitude;
+    return direction;
+}
+
+// One turn in three seconds, loudness swelling twice per second
+Audio::AudioDirection Sweep(uint32_t tick)
+{
+    const float t = static_cast<float>(tick) / 100.0f;
+    return Direction(-180.0f + 120.0f * t, 10.0f * std::sin(t), 0.45f + 0.3f * std::sin(4.0f * kPi * t));
+}
+
+// 40 ms bursts every half second, twice from each direction so the
+// second one classifies as rhythmic
+Audio::AudioDirection Bursts(uint32_t tick)
+{
+    constexpr float kAzimuths[] = {-60.0f, 60.0f, 150.0f, -120.0f};
+    if (tick % 50 >= 4)
+    {
+        return Direction(0.0f, 0.0f, 0.0f);
+    }
+    const auto burst = tick / 50;
+    return Direction(kAzimuths[(burst / 2) % std::size(kAzimuths)], 0.0f, burst % 2 ? 0.5f : 0.8f);
+}
+
+// Half a second of bursts, then silence: once the trail has faded the
+// radar is clean and dirty tracking skips every frame
+Audio::AudioDirection Idle(uint32_t tick)
+{
+    return tick < 50 ? Bursts(tick) : Direction(0.0f, 0.0f, 0.0f);
+}
+
+// Very loud sources up close, each followed by a quieter (but still loud)
+// one on an axis: relative to the loud reference the second lands on the
+// ring, where the largest markers reach furthest past it
+Audio::AudioDirection Loud(uint32_t tick)
+{
+    constexpr float kAzimuths[] = {90.0f, 180.0f, -90.0f, 0.0f};
+    const auto phase = tick % 10;
+    if (phase < 3)
+    {
+        return Direction(45.0f, 0.0f, 50.0f);
+    }
+    if (phase == 5)
+    {
+        return Direction(kAzimuths[(tick / 10) % std::size(kAzimuths)], 0.0f, 4.0f);
+    }
+    return Direction(0.0f, 0.0f, 0.0f);
+}
+
+// Uniformly scattered directions and levels. Only raw mt19937 outputs are
+// used: the standard distributions differ between library implementations,
+// and the goldens must not.
+DirectionSource Scatter(uint32_t seed)
+{
+    auto generator = std::make_shared<std::mt19937>(seed);
+    return [generator](uint32_t) {
+        const float azimuth = static_cast<float>((*generator)() % 3600) / 10.0f - 180.0f;
+        const float elevation = static_cast<float>((*generator)() % 600) / 10.0f - 30.0f;
+        const float magnitude = 0.1f + static_cast<float>((*generator)() % 900) / 1000.0f;
+        return Direction(azimuth, elevation, magnitude);
+    };
+}
+
+std::vector<RenderScene> StandardRenderScenes()
+{
+    return {
+        {"radar_sweep", Config::VisualizationMode::Radar, 300, Sweep},
+        {"radar_bursts", Config::VisualizationMode::Radar, 300, Bursts},
+        {"radar_scatter", Config::VisualizationMode::Radar, 300, Scatter(33)},
+        {"radar_idle", Config::VisualizationMode::Radar, 300, Idle},
+        {"radar_loud", Config::VisualizationMode::Radar, 300, Loud},
+        {"heatmap_scatter", Config::VisualizationMode::Heatmap, 300, Scatter(34)},
+        {"waterfall_sweep", Config::VisualizationMode::Waterfall, 300, Sweep},
+    };
+}
+
+const char* ModeName(Config::VisualizationMode mode)
+{
+    switch (mode)
+    {
+    case Config::VisualizationMode::Heatmap:
+        return "heatmap";
+    case Config::VisualizationMode::Waterfall:
+        return "waterfall";
+    case Config::VisualizationMode::Radar:
+    default:
+        return "radar";
+    }
+}
+
+const char* OutcomeName(GoldenOutcome outcome)
+{
+    switch (outcome)
+    {
+    case GoldenOutcome::Matched:
+        return "matched";
+    case GoldenOutcome::Mismatched:
+        return "mismatched";
+    case GoldenOutcome::Missing:
+        return "missing";
+    case GoldenOutcome::Updated:
+        return "updated";
+    case GoldenOutcome::Skipped:
+    default:
+        return "skipped";
+    }
+}
+
+double Percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    return values[index];
+}
+
+// The visualizer's state for one scene: a RadarScene fed by the same
+// classifier DirectionVisualizer::UpdateDirection uses
+class SceneState
+{
+public:
+    explicit SceneState(Config::VisualizationMode mode)
+    {
+        m_scene.SetMode(mode);
+        // Fixed rather than theme-derived, so the goldens do not depend on config.ini
+        m_scene.Heatmap().SetPalette(0x40, 0xC0, 0xFF, 0.85f);
+        m_scene.Waterfall().SetPalette(0x40, 0xC0, 0xFF, 0.85f);
+        m_distanceScale = std::clamp(m_sensitivity.distanceScale, 0.5f, 2.0f);
+    }
+
+    // Classifies and adds every direction up to now, then advances the
+    // scene. Returns whether the radar needs repainting.
+    bool Update(const RenderScene& scene, uint32_t& tick, Clock::time_point epoch, Clock::time_point now)
+    {
+        for (; tick < scene.ticks && epoch + tick * kDirectionPeriod <= now; ++tick)
+        {
+            auto direction = scene.source(tick);
+            direction.captureTime = epoch + tick * kDirectionPeriod;
+
+            RadarHitRecord hit;
+            if (!m_classifier.Classify(direction, m_sensitivity, direction.captureTime, hit))
+            {
+                continue;
+            }
+            ++m_classified;
+            m_scene.Add(hit, m_distanceScale);
+        }
+        return m_scene.Advance(now).dirty;
+    }
+
+    // Repaints region with the visualizer's geometry, copying the static
+    // layer from background when given
+    void Paint(SoftwareRenderBackend& target, const RenderRect& region,
+               const SoftwareRenderBackend* background = nullptr)
+    {
+        RadarFrame frame = Geometry(target);
+        frame.distanceScale = m_distanceScale;
+        frame.background = background;
+        m_scene.Fill(frame);
+        PaintRadarFrame(target, frame, region);
+    }
+
+    void Paint(SoftwareRenderBackend& target, const SoftwareRenderBackend* background = nullptr)
+    {
+        Paint(target, {0.0f, 0.0f, static_cast<float>(target.Width()), static_cast<float>(target.Height())}, background);
+    }
+
+    // What DirectionVisualizer::RebuildStaticLayer renders for the software path
+    static void PaintStaticLayer(SoftwareRenderBackend& target)
+    {
+        const RadarFrame frame = Geometry(target);
+        PaintRadarBackground(target, frame.style, frame.center, frame.radius);
+    }
+
+    // The ring's bounds grown by the marker padding: what a dirty radar repaints
+    static RenderRect RadarBounds(const SoftwareRenderBackend& target)
+    {
+        const float width = static_cast<float>(target.Width());
+        const float height = static_cast<float>(target.Height());
+        const float extent = std::min(width, height) * 0.45f + kRadarMarkerPadding;
+        return {width / 2.0f - extent, height / 2.0f - extent, width / 2.0f + extent, height / 2.0f + extent};
+    }
+
+    [[nodiscard]] uint64_t Classified() const noexcept { return m_classified; }
+
+private:
+    static RadarFrame Geometry(const SoftwareRenderBackend& target)
+    {
+        const float width = static_cast<float>(target.Width());
+        const float height = static_cast<float>(target.Height());
+
+        RadarFrame frame;
+        frame.center = {width / 2.0f, height / 2.0f};
+        frame.radius = std::min(width, height) * 0.45f;
+        return frame;
+    }
+
+    Config::SensitivityConfig m_sensitivity;
+    float m_distanceScale{1.0f};
+    HitClassifier m_classifier;
+    RadarScene m_scene;
+    uint64_t m_classified{0};
+};
+
+// PAM (netpbm P7) with straight RGBA channel order; the values are the
+// surface's premultiplied ones, unconverted
+bool WritePam(const std::filesystem::path& path, const SoftwareRenderBackend& surface)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char header[256];
+    std::snprintf(header, sizeof(header),
+                  "P7\n# premultiplied alpha; SpatialAudioBenchmark --benchmark render --update-golden\n"
+                  "WIDTH %zu\nHEIGHT %zu\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n",
+                  surface.Width(), surface.Height());
+    file << header;
+
+    const size_t count = surface.Width() * surface.Height();
+    std::vector<uint8_t> bytes(count * 4);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t pixel = surface.Pixels()[i];
+        bytes[i * 4 + 0] = static_cast<uint8_t>(pixel >> 16);
+        bytes[i * 4 + 1] = static_cast<uint8_t>(pixel >> 8);
+        bytes[i * 4 + 2] = static_cast<uint8_t>(pixel);
+        bytes[i * 4 + 3] = static_cast<uint8_t>(pixel >> 24);
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+// Reads what WritePam wrote, as RGBA bytes; false when missing or malformed
+bool ReadPam(const std::filesystem::path& path, size_t& width, size_t& height, std::vector<uint8_t>& rgba)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::string line;
+    if (!file || !std::getline(file, line) || line != "P7")
+    {
+        return false;
+    }
+
+    width = height = 0;
+    size_t depth = 0;
+    while (std::getline(file, line) && line != "ENDHDR")
+    {
+        std::istringstream field(line);
+        std::string key;
+        field >> key;
+        if (key == "WIDTH")
+        {
+            field >> width;
+        }
+        else if (key == "HEIGHT")
+        {
+            field >> height;
+        }
+        else if (key == "DEPTH")
+        {
+            field >> depth;
+        }
+    }
+    if (line != "ENDHDR" || depth != 4 || width == 0 || height == 0)
+    {
+        return false;
+    }
+
+    rgba.resize(width * height * 4);
+    file.read(reinterpret_cast<char*>(rgba.data()), static_cast<std::streamsize>(rgba.size()));
+    return file.gcount() == static_cast<std::streamsize>(rgba.size());
+}
+
+void CompareGolden(const RenderScene& scene, const RenderOptions& options, const SoftwareRenderBackend& surface,
+                   RenderResult& result)
+{
+    if (options.goldenDirectory.empty())
+    {
+        return;
+    }
+
+    const auto golden = options.goldenDirectory / (scene.name + ".pam");
+    if (options.updateGolden)
+    {
+        result.golden = WritePam(golden, surface) ? GoldenOutcome::Updated : GoldenOutcome::Missing;
+        return;
+    }
+
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<uint8_t> expected;
+    if (!ReadPam(golden, width, height, expected) || width != surface.Width() || height != surface.Height())
+    {
+        result.golden = GoldenOutcome::Missing;
+        return;
+    }
+
+    for (size_t i = 0; i < width * height; ++i)
+    {
+        const uint32_t pixel = surface.Pixels()[i];
+        const int actual[4] = {static_cast<int>((pixel >> 16) & 0xFF), static_cast<int>((pixel >> 8) & 0xFF),
+                               static_cast<int>(pixel & 0xFF), static_cast<int>(pixel >> 24)};
+        int delta = 0;
+        for (size_t c = 0; c < 4; ++c)
+        {
+            delta = std::max(delta, std::abs(actual[c] - static_cast<int>(expected[i * 4 + c])));
+        }
+        result.maxChannelDelta = std::max(result.maxChannelDelta, delta);
+        result.mismatchedPixels += delta > options.tolerance ? 1 : 0;
+    }
+
+    result.golden = result.mismatchedPixels == 0 ? GoldenOutcome::Matched : GoldenOutcome::Mismatched;
+    if (result.golden == GoldenOutcome::Mismatched && !options.failureDirectory.empty())
+    {
+        WritePam(options.failureDirectory / (scene.name + ".actual.pam"), surface);
+    }
+}
+
+RenderResult RunRenderScene(const RenderScene& scene, const RenderOptions& options)
+{
+    RenderResult result;
+    result.scene = scene.name;
+    result.mode = ModeName(scene.mode);
+
+    // A fixed epoch well clear of zero, so nothing depends on when the run happens
+    const auto epoch = Clock::time_point{} + std::chrono::hours(1);
+    const auto sceneEnd = epoch + scene.ticks * kDirectionPeriod;
+
+    SceneState state{scene.mode};
+    SoftwareRenderBackend surface{options.frameSize, options.frameSize};
+    SoftwareRenderBackend cached{options.frameSize, options.frameSize};
+    SoftwareRenderBackend partial{options.frameSize, options.frameSize};
+    SoftwareRenderBackend staticLayer{options.frameSize, options.frameSize};
+    SceneState::PaintStaticLayer(staticLayer);
+    const RenderRect radarBounds = SceneState::RadarBounds(partial);
+    const size_t pixelCount = options.frameSize * options.frameSize;
+
+    std::vector<double> frameTimes;
+    std::vector<double> cachedFrameTimes;
+    std::vector<double> partialFrameTimes;
+    uint32_t tick = 0;
+    Clock::time_point now = epoch;
+    for (uint64_t frame = 1; now < sceneEnd; ++frame)
+    {
+        now = epoch + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(frame / kFrameRate));
+
+        const uint64_t allocationsBefore = Diagnostics::ThreadAllocationCount();
+        const auto start = Clock::now();
+        const bool dirty = state.Update(scene, tick, epoch, now);
+        const auto updated = Clock::now();
+        state.Paint(surface);
+        const auto painted = Clock::now();
+        state.Paint(cached, &staticLayer);
+        const auto cachedPainted = Clock::now();
+        // As the layered window draws: full frame first, then dirty regions
+        // over the cached static layer
+        if (frame == 1)
+        {
+            state.Paint(partial, &staticLayer);
+        }
+        else if (dirty)
+        {
+            state.Paint(partial, radarBounds, &staticLayer);
+        }
+        else
+        {
+            ++result.skippedFrames;
+        }
+        const auto partialPainted = Clock::now();
+        // The first frame sizes the heatmap texture and other lazy buffers
+        if (frame > 1)
+        {
+            result.steadyAllocations += Diagnostics::ThreadAllocationCount() - allocationsBefore;
+        }
+
+        frameTimes.push_back(std::chrono::duration<double, std::micro>(painted - start).count());
+        cachedFrameTimes.push_back(
+            std::chrono::duration<double, std::micro>((updated - start) + (cachedPainted - painted)).count());
+        partialFrameTimes.push_back(
+            std::chrono::duration<double, std::micro>((updated - start) + (partialPainted - cachedPainted)).count());
+
+        if (!std::equal(surface.Pixels(), surface.Pixels() + pixelCount, cached.Pixels()))
+        {
+            ++result.cachedMismatches;
+        }
+        if (!std::equal(surface.Pixels(), surface.Pixels() + pixelCount, partial.Pixels()))
+        {
+            ++result.partialMismatches;
+        }
+    }
+
+    result.frames = frameTimes.size();
+    result.hits = state.Classified();
+    result.frameP50Us = Percentile(frameTimes, 0.50);
+    result.frameP99Us = Percentile(frameTimes, 0.99);
+    result.frameMaxUs = frameTimes.empty() ? 0.0 : frameTimes.back(); // sorted by Percentile
+    result.cachedFrameP50Us = Percentile(cachedFrameTimes, 0.50);
+    result.cachedFrameP99Us = Percentile(cachedFrameTimes, 0.99);
+    result.partialFrameP50Us = Percentile(partialFrameTimes, 0.50);
+    result.partialFrameP99Us = Percentile(partialFrameTimes, 0.99);
+
+    // The last frame again at the golden size
+    SoftwareRenderBackend golden{options.goldenSize, options.goldenSize};
+    state.Paint(golden);
+    CompareGolden(scene, options, golden, result);
+
+    result.passed = result.golden != GoldenOutcome::Mismatched && result.golden != GoldenOutcome::Missing &&
+                    result.cachedMismatches == 0 && result.partialMismatches == 0;
+    return result;
+}
+}
+
+std::vector<RenderResult> Benchmark::RunRenderSuite(const RenderOptions& options)
+{
+    std::vector<RenderResult> results;
+    for (const auto& scene : StandardRenderScenes())
+    {
+        results.push_back(RunRenderScene(scene, options));
+    }
+    return results;
+}
+
+bool Benchmark::WriteRenderJson(const std::filesystem::path& path, const RenderOptions& options,
+                                const std::vector<RenderResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char line[1024];
+    std::snprintf(line, sizeof(line),
+                  "{\"benchmark\":\"render\",\"frameSize\":%zu,\"goldenSize\":%zu,\"tolerance\":%d,\"scenes\":[",
+                  options.frameSize, options.goldenSize, options.tolerance);
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        // null when allocation counting is not compiled in
+        char allocations[24] = "null";
+        if (Diagnostics::kAllocationCountingEnabled)
+        {
+            std::snprintf(allocations, sizeof(allocations), "%llu",
+                          static_cast<unsigned long long>(result.steadyAllocations));
+        }
+        std::snprintf(line, sizeof(line),
+                      "{\"scene\":\"%s\",\"mode\":\"%s\",\"frames\":%llu,\"hits\":%llu,"
+                      "\"frameUs\":{\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f},"
+                      "\"cachedFrameUs\":{\"p50\":%.1f,\"p99\":%.1f},\"cachedMismatches\":%llu,"
+                      "\"partialFrameUs\":{\"p50\":%.1f,\"p99\":%.1f},\"skippedFrames\":%llu,\"partialMismatches\":%llu,"
+                      "\"golden\":\"%s\",\"mismatchedPixels\":%llu,\"maxChannelDelta\":%d,"
+                      "\"steadyAllocations\":%s,\"passed\":%s}",
+                      result.scene.c_str(), result.mode.c_str(), static_cast<unsigned long long>(result.frames),
+                      static_cast<unsigned long long>(result.hits), result.frameP50Us, result.frameP99Us,
+                      result.frameMaxUs, result.cachedFrameP50Us, result.cachedFrameP99Us,
+                      static_cast<unsigned long long>(result.cachedMismatches), result.partialFrameP50Us, result.partialFrameP99Us,
+                      static_cast<unsigned long long>(result.skippedFrames),
+                      static_cast<unsigned long long>(result.partialMismatches), OutcomeName(result.golden),
+                      static_cast<unsigned long long>(result.mismatchedPixels), result.maxChannelDelta, allocations,
+                      result.passed ? "true" : "false");
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+struct RenderOptions
+{
+    // Committed golden images (test/golden); empty skips the comparison
+    std::filesystem::path goldenDirectory;
+    // Rewrite the goldens from this run instead of comparing against them
+    bool updateGolden{false};
+    // Where a mismatching frame is written for inspection
+    std::filesystem::path failureDirectory;
+    size_t goldenSize{128}; // square surface, pixels
+    // Largest per-channel difference that still matches; absorbs libm and
+    // SIMD rounding differences between compilers
+    int tolerance{2};
+    size_t frameSize{320}; // square surface the frame time is measured on
+};
+
+enum class GoldenOutcome
+{
+    Skipped,    // no golden directory given
+    Matched,
+    Mismatched, // some pixel differs by more than the tolerance
+    Missing,    // no golden image for the scene
+    Updated,    // rewritten from this run
+};
+
+// One generated direction sequence played through HitClassifier, the
+// radar's hit buffer (or heatmap/waterfall) and PaintRadarFrame on a
+// SoftwareRenderBackend, at 60 frames per second of scene time.
+struct RenderResult
+{
+    std::string scene;
+    std::string mode; // radar, heatmap or waterfall
+
+    // Last frame at goldenSize against test/golden/<scene>.pam
+    GoldenOutcome golden{GoldenOutcome::Skipped};
+    uint64_t mismatchedPixels{0};
+    int maxChannelDelta{0};
+
+    // CPU time of every frame at frameSize: draining new hits, expiring and
+    // fading, then repainting the whole surface. Text is not included.
+    uint64_t frames{0};
+    double frameP50Us{0.0};
+    double frameP99Us{0.0};
+    double frameMaxUs{0.0};
+    uint64_t hits{0}; // classified over the scene
+
+    // The same full repaint with the background, crosshair and ring copied
+    // from a static layer rendered once, as the layered window does
+    double cachedFrameP50Us{0.0};
+    double cachedFrameP99Us{0.0};
+    uint64_t cachedMismatches{0}; // frames that differ from the uncached repaint
+
+    // Cached, and with DirectionVisualizer's dirty tracking: clean frames
+    // are skipped and dirty ones repaint only the ring's bounds. After
+    // every frame that surface must equal the full repaint.
+    double partialFrameP50Us{0.0};
+    double partialFrameP99Us{0.0};
+    uint64_t skippedFrames{0};
+    uint64_t partialMismatches{0}; // frames where the two surfaces differ
+
+    // Heap allocations made by every frame after the first (update and all
+    // three repaints). Only counted with SPATIAL_AUDIO_COUNT_ALLOCATIONS;
+    // must stay at zero.
+    uint64_t steadyAllocations{0};
+
+    bool passed{true};
+};
+
+std::vector<RenderResult> RunRenderSuite(const RenderOptions& options);
+
+bool WriteRenderJson(const std::filesystem::path& path, const RenderOptions& options, const std::vector<RenderResult>& results);
+}
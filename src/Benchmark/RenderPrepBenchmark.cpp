@@ -0,0 +1,254 @@
+#include "Benchmark/RenderPrepBenchmark.h"
+
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/RadarPainter.h"
+#include "Rendering/RenderBackend.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <system_error>
+
+using namespace Benchmark;
+using namespace Rendering;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kRadius = 144.0f;
+constexpr RenderPoint kCenter{160.0f, 160.0f};
+
+double Percentile(std::vector<double>& values, double fraction)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    return values[index];
+}
+
+// Takes the markers and draws nothing. PaintRadarHits and PaintRadarMarker
+// live in another translation unit and call through the vtable, so the
+// preparation is not optimised away.
+class NullRenderBackend final : public RenderBackend
+{
+public:
+    void Clear(const RenderColor&) override {}
+    void DrawLine(RenderPoint, RenderPoint, const RenderColor&, float) override {}
+    void DrawCircle(RenderPoint, float, const RenderColor&, float) override {}
+    void FillCircle(RenderPoint, float, const RenderColor&) override {}
+    void FillRect(const RenderRect&, const RenderColor&) override {}
+    void PushClip(const RenderRect&) override {}
+    void PopClip() override {}
+};
+
+struct GeneratedHit
+{
+    float azimuth;
+    float elevation;
+    float radiusFactor;
+    float magnitude;
+    RadarPattern pattern;
+    Clock::time_point time;
+};
+
+// Spread over the trail, so every hit is live and faded differently
+std::vector<GeneratedHit> GenerateHits(size_t count, Clock::time_point now)
+{
+    const auto trail = std::chrono::duration_cast<Clock::duration>(kRadarTrailDuration);
+    std::mt19937 generator{static_cast<uint32_t>(count)};
+    std::vector<GeneratedHit> hits;
+    for (size_t i = 0; i < count; ++i)
+    {
+        GeneratedHit hit;
+        hit.azimuth = static_cast<float>(generator() % 3600) / 3600.0f * 2.0f * kPi - kPi;
+        hit.elevation = static_cast<float>(generator() % 600) / 3600.0f * 2.0f * kPi - kPi / 6.0f;
+        hit.radiusFactor = 0.12f + static_cast<float>(generator() % 880) / 1000.0f;
+        hit.magnitude = 0.15f + static_cast<float>(generator() % 850) / 1000.0f;
+        hit.pattern = static_cast<RadarPattern>(1 + generator() % 3);
+        hit.time = now - trail + trail * static_cast<Clock::rep>(i + 1) / static_cast<Clock::rep>(count + 1);
+        hits.push_back(hit);
+    }
+    return hits;
+}
+
+// The radar as it is: everything fixed at insert time stored precomputed
+class PrecomputedStore
+{
+public:
+    explicit PrecomputedStore(const std::vector<GeneratedHit>& hits)
+    {
+        for (const auto& generated : hits)
+        {
+            const float cosElevation = std::cos(generated.elevation);
+            RadarHitRecord hit;
+            hit.x = std::sin(generated.azimuth) * cosElevation;
+            hit.z = std::cos(generated.azimuth) * cosElevation;
+            hit.radiusFactor = generated.radiusFactor;
+            hit.magnitude = generated.magnitude;
+            hit.pattern = generated.pattern;
+            hit.time = generated.time;
+            m_hits.Push(hit);
+        }
+    }
+
+    void Frame(RenderBackend& target, const RadarStyle& style, Clock::time_point now) noexcept
+    {
+        m_hits.UpdateFades(now, kRadarTrailDuration);
+        PaintRadarHits(target, style, m_hits, kCenter, kRadius, 1.0f);
+    }
+
+private:
+    RadarHitBuffer m_hits;
+};
+
+// What the radar did before the hit store kept precomputed layout
+class PerHitTrigStore
+{
+public:
+    explicit PerHitTrigStore(const std::vector<GeneratedHit>& hits)
+        : m_hits(hits)
+    {
+    }
+
+    void Frame(RenderBackend& target, const RadarStyle& style, Clock::time_point now)
+    {
+        const float trailSeconds = std::chrono::duration<float>(kRadarTrailDuration).count();
+        for (const auto& hit : m_hits)
+        {
+            const float age = std::chrono::duration<float>(now - hit.time).count();
+            if (age < 0.0f || age >= trailSeconds)
+            {
+                continue;
+            }
+            const float fade = 1.0f - age / trailSeconds;
+
+            const float cosElevation = std::cos(hit.elevation);
+            const float x = std::sin(hit.azimuth) * cosElevation;
+            const float z = std::cos(hit.azimuth) * cosElevation;
+            const float r = kRadius * std::clamp(hit.radiusFactor * PatternScale(hit.pattern), 0.05f, 1.0f);
+            const RenderPoint position{kCenter.x + r * x, kCenter.y - r * z};
+
+            RenderColor color = PatternColor(style, hit.pattern);
+            color.a *= fade;
+            PaintRadarMarker(target, hit.pattern, position, HitMarkerRadius(hit.magnitude), color);
+        }
+    }
+
+private:
+    struct PatternStyle
+    {
+        RadarPattern id;
+        float distanceScale;
+    };
+
+    static float PatternScale(RadarPattern pattern) noexcept
+    {
+        static constexpr PatternStyle kStyles[] = {
+            {RadarPattern::Strong, 0.7f},
+            {RadarPattern::Medium, 1.0f},
+            {RadarPattern::Weak, 1.2f},
+            {RadarPattern::Unknown, 1.0f},
+        };
+        for (const auto& style : kStyles)
+        {
+            if (style.id == pattern)
+            {
+                return style.distanceScale;
+            }
+        }
+        return 1.0f;
+    }
+
+    std::vector<GeneratedHit> m_hits;
+};
+
+template <typename Store>
+RenderPrepResult Measure(Store& store, const char* name, size_t hits, const RenderPrepOptions& options,
+                         Clock::time_point now)
+{
+    RenderPrepResult result;
+    result.store = name;
+    result.hits = hits;
+
+    NullRenderBackend target;
+    const RadarStyle style;
+    std::vector<double> frameTimes;
+    frameTimes.reserve(options.frames);
+    for (uint32_t frame = 0; frame < options.frames; ++frame)
+    {
+        // The same frame time every time keeps every hit live
+        const auto start = Clock::now();
+        store.Frame(target, style, now);
+        frameTimes.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+
+    result.frameP50Us = Percentile(frameTimes, 0.50);
+    result.frameP99Us = Percentile(frameTimes, 0.99);
+    if (hits > 0)
+    {
+        result.nsPerHit = result.frameP50Us * 1000.0 / static_cast<double>(hits);
+    }
+    return result;
+}
+}
+
+std::vector<RenderPrepResult> Benchmark::RunRenderPrepSuite(const RenderPrepOptions& options)
+{
+    const auto now = Clock::time_point{} + std::chrono::hours(1);
+
+    std::vector<RenderPrepResult> results;
+    for (size_t count : options.hits)
+    {
+        const auto hits = GenerateHits(std::min(count, RadarHitBuffer::kCapacity), now);
+
+        auto precomputed = std::make_unique<PrecomputedStore>(hits); // ~40 KB
+        results.push_back(Measure(*precomputed, "precomputed", hits.size(), options, now));
+
+        PerHitTrigStore perHit{hits};
+        results.push_back(Measure(perHit, "per_hit_trig", hits.size(), options, now));
+    }
+    return results;
+}
+
+bool Benchmark::WriteRenderPrepJson(const std::filesystem::path& path, const RenderPrepOptions& options,
+                                    const std::vector<RenderPrepResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char line[512];
+    std::snprintf(line, sizeof(line), "{\"benchmark\":\"prep\",\"frames\":%u,\"vectorized\":%s,\"runs\":[",
+                  options.frames, RadarHitBuffer::Vectorized() ? "true" : "false");
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        std::snprintf(line, sizeof(line),
+                      "{\"store\":\"%s\",\"hits\":%zu,\"nsPerHit\":%.2f,\"frameUs\":{\"p50\":%.2f,\"p99\":%.2f}}",
+                      result.store.c_str(), result.hits, result.nsPerHit, result.frameP50Us, result.frameP99Us);
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
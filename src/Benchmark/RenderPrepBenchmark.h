@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+struct RenderPrepOptions
+{
+    std::vector<size_t> hits{64, 256, 1024}; // live hits per frame
+    uint32_t frames{2000};                    // timed per store and hit count
+};
+
+// The per-frame, per-hit work between the hit store and the draw calls:
+// trail fade, distance, screen position, colour and marker size. Markers
+// go to a backend that draws nothing, so only the preparation is timed.
+struct RenderPrepResult
+{
+    // precomputed: RadarHitBuffer::UpdateFades then PaintRadarHits, as the
+    // radar draws
+    // per_hit_trig: azimuth/elevation stored, with sin/cos, a chrono age and
+    // a pattern table scan per hit and frame, as the radar used to draw
+    std::string store;
+    size_t hits{0};
+    double nsPerHit{0.0}; // p50 frame over the hit count
+    double frameP50Us{0.0};
+    double frameP99Us{0.0};
+};
+
+std::vector<RenderPrepResult> RunRenderPrepSuite(const RenderPrepOptions& options);
+
+bool WriteRenderPrepJson(const std::filesystem::path& path, const RenderPrepOptions& options,
+                         const std::vector<RenderPrepResult>& results);
+}
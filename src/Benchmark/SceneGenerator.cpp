@@ -0,0 +1,283 @@
+#include "Benchmark/SceneGenerator.h"
+
+#include <mmreg.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+using namespace Benchmark;
+
+namespace
+{
+constexpr double kPi = 3.14159265358979323846;
+// A major chord; three partials keep the bed from cancelling at any instant
+constexpr double kMusicFrequencies[] = {220.0, 277.18, 329.63};
+
+constexpr DWORD kStereoMask = SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT;
+constexpr DWORD kSurround51Mask = kStereoMask | SPEAKER_FRONT_CENTER | SPEAKER_LOW_FREQUENCY |
+                                  SPEAKER_BACK_LEFT | SPEAKER_BACK_RIGHT;
+constexpr DWORD kSurround71Mask = kSurround51Mask | SPEAKER_SIDE_LEFT | SPEAKER_SIDE_RIGHT;
+constexpr DWORD kSurround714Mask = kSurround71Mask | SPEAKER_TOP_FRONT_LEFT | SPEAKER_TOP_FRONT_RIGHT |
+                                   SPEAKER_TOP_BACK_LEFT | SPEAKER_TOP_BACK_RIGHT;
+
+const LayoutInfo kLayouts[] = {
+    {"2.0", 2, kStereoMask, true},
+    {"5.1", 6, kSurround51Mask, false},
+    {"7.1", 8, kSurround71Mask, false},
+    {"7.1.4", 12, kSurround714Mask, false},
+};
+
+// Nominal speaker azimuth (ITU-R BS.775 / Dolby placement). Back speakers
+// are the surrounds in 5.1 but sit further back once side speakers exist.
+float SpeakerAzimuth(DWORD speaker, DWORD mask)
+{
+    const bool hasSides = (mask & SPEAKER_SIDE_LEFT) != 0;
+    switch (speaker)
+    {
+    case SPEAKER_FRONT_LEFT: return -30.0f;
+    case SPEAKER_FRONT_RIGHT: return 30.0f;
+    case SPEAKER_BACK_LEFT: return hasSides ? -150.0f : -110.0f;
+    case SPEAKER_BACK_RIGHT: return hasSides ? 150.0f : 110.0f;
+    case SPEAKER_FRONT_LEFT_OF_CENTER: return -15.0f;
+    case SPEAKER_FRONT_RIGHT_OF_CENTER: return 15.0f;
+    case SPEAKER_BACK_CENTER: return 180.0f;
+    case SPEAKER_SIDE_LEFT: return -90.0f;
+    case SPEAKER_SIDE_RIGHT: return 90.0f;
+    case SPEAKER_TOP_FRONT_LEFT: return -45.0f;
+    case SPEAKER_TOP_FRONT_RIGHT: return 45.0f;
+    case SPEAKER_TOP_BACK_LEFT: return -135.0f;
+    case SPEAKER_TOP_BACK_RIGHT: return 135.0f;
+    default: return 0.0f;
+    }
+}
+
+bool IsHeightSpeaker(DWORD speaker)
+{
+    return speaker >= SPEAKER_TOP_CENTER;
+}
+
+// Wraps to [-180, 180)
+float WrapDegrees(float degrees)
+{
+    degrees = std::fmod(degrees + 180.0f, 360.0f);
+    return (degrees < 0.0f ? degrees + 360.0f : degrees) - 180.0f;
+}
+
+// Uniform in [-1, 1) from a xorshift32 state
+float NextNoise(uint32_t& state) noexcept
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state) / 2147483648.0f - 1.0f;
+}
+}
+
+const LayoutInfo& Benchmark::DescribeLayout(SpeakerLayout layout) noexcept
+{
+    return kLayouts[static_cast<size_t>(layout)];
+}
+
+SceneGenerator::SceneGenerator(SceneDescription scene, SpeakerLayout layout, UINT32 sampleRate, UINT32 packetFrames)
+    : m_scene(std::move(scene))
+    , m_layout(DescribeLayout(layout))
+    , m_sampleRate(sampleRate)
+    , m_packetFrames(packetFrames)
+    , m_totalFrames(static_cast<uint64_t>(m_scene.durationSeconds * sampleRate))
+{
+    // Channels interleave in ascending SPEAKER_* bit order
+    for (DWORD bit = 1; bit != 0 && bit <= m_layout.channelMask; bit <<= 1)
+    {
+        if ((m_layout.channelMask & bit) != 0)
+        {
+            const bool height = IsHeightSpeaker(bit);
+            const bool lfe = bit == SPEAKER_LOW_FREQUENCY;
+            m_speakers.push_back({SpeakerAzimuth(bit, m_layout.channelMask), !height && !lfe, !lfe});
+        }
+    }
+
+    for (size_t i = 0; i < m_speakers.size(); ++i)
+    {
+        if (m_speakers[i].earLevel)
+        {
+            m_panOrder.push_back(i);
+        }
+    }
+    std::sort(m_panOrder.begin(), m_panOrder.end(),
+              [this](size_t a, size_t b) { return m_speakers[a].azimuthDeg < m_speakers[b].azimuthDeg; });
+
+    m_noiseState.resize(m_scene.sources.size());
+    for (size_t i = 0; i < m_noiseState.size(); ++i)
+    {
+        m_noiseState[i] = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+    }
+
+    m_gains.resize(m_scene.sources.size() * m_speakers.size());
+    m_buffer.resize(static_cast<size_t>(packetFrames) * m_speakers.size());
+}
+
+bool SceneGenerator::Next()
+{
+    if (m_started)
+    {
+        m_packetStartFrame += m_packetFrames;
+    }
+    m_started = true;
+    if (m_packetStartFrame + m_packetFrames > m_totalFrames)
+    {
+        return false;
+    }
+
+    const size_t channels = m_speakers.size();
+    const double midpoint = (PacketStart() + PacketEnd()) / 2.0;
+
+    // Panning is fixed per packet; sweeps move a fraction of a degree in that time
+    for (size_t s = 0; s < m_scene.sources.size(); ++s)
+    {
+        const auto& source = m_scene.sources[s];
+        const double progress = source.durationSeconds > 0.0
+            ? std::clamp((midpoint - source.onsetSeconds) / source.durationSeconds, 0.0, 1.0)
+            : 0.0;
+        const float azimuth = source.startAzimuthDeg +
+            static_cast<float>(progress) * (source.endAzimuthDeg - source.startAzimuthDeg);
+        PanSource(azimuth, &m_gains[s * channels]);
+    }
+
+    const float musicAmplitude = m_scene.musicLevel / std::sqrt(std::size(kMusicFrequencies) / 2.0f);
+
+    for (UINT32 frame = 0; frame < m_packetFrames; ++frame)
+    {
+        float* out = &m_buffer[static_cast<size_t>(frame) * channels];
+        const uint64_t absoluteFrame = m_packetStartFrame + frame;
+        const double seconds = static_cast<double>(absoluteFrame) / m_sampleRate;
+
+        float music = 0.0f;
+        if (musicAmplitude > 0.0f)
+        {
+            for (double frequency : kMusicFrequencies)
+            {
+                music += static_cast<float>(std::sin(2.0 * kPi * frequency * seconds));
+            }
+            music *= musicAmplitude;
+        }
+
+        for (size_t c = 0; c < channels; ++c)
+        {
+            out[c] = m_speakers[c].fullRange ? music : 0.0f;
+        }
+
+        for (size_t s = 0; s < m_scene.sources.size(); ++s)
+        {
+            const auto& source = m_scene.sources[s];
+            if (seconds < source.onsetSeconds || seconds >= source.onsetSeconds + source.durationSeconds)
+            {
+                continue;
+            }
+
+            // Uniform noise has an RMS of 1/sqrt(3) of its peak
+            const float sample = NextNoise(m_noiseState[s]) * source.level * 1.7320508f;
+            const float* gains = &m_gains[s * channels];
+            for (size_t c = 0; c < channels; ++c)
+            {
+                out[c] += sample * gains[c];
+            }
+        }
+    }
+
+    return true;
+}
+
+double SceneGenerator::PacketStart() const noexcept
+{
+    return static_cast<double>(m_packetStartFrame) / m_sampleRate;
+}
+
+double SceneGenerator::PacketEnd() const noexcept
+{
+    return static_cast<double>(m_packetStartFrame + m_packetFrames) / m_sampleRate;
+}
+
+GroundTruth SceneGenerator::Truth() const
+{
+    GroundTruth truth;
+    const double start = PacketStart();
+    const double end = PacketEnd();
+    const double midpoint = (start + end) / 2.0;
+
+    float loudest = 0.0f;
+    for (size_t s = 0; s < m_scene.sources.size(); ++s)
+    {
+        const auto& source = m_scene.sources[s];
+        if (source.onsetSeconds < end && source.onsetSeconds + source.durationSeconds > start)
+        {
+            truth.quiet = false;
+        }
+
+        const auto azimuth = SourceAzimuth(s, midpoint);
+        if (azimuth && source.level > loudest)
+        {
+            loudest = source.level;
+            truth.source = static_cast<int>(s);
+            truth.azimuthDeg = *azimuth;
+        }
+    }
+
+    return truth;
+}
+
+std::optional<float> SceneGenerator::SourceAzimuth(size_t index, double seconds) const
+{
+    const auto& source = m_scene.sources[index];
+    if (seconds < source.onsetSeconds || seconds >= source.onsetSeconds + source.durationSeconds)
+    {
+        return std::nullopt;
+    }
+
+    const double progress = source.durationSeconds > 0.0 ? (seconds - source.onsetSeconds) / source.durationSeconds : 0.0;
+    return WrapDegrees(source.startAzimuthDeg + static_cast<float>(progress) * (source.endAzimuthDeg - source.startAzimuthDeg));
+}
+
+void SceneGenerator::PanSource(float azimuthDeg, float* gains) const
+{
+    std::fill_n(gains, m_speakers.size(), 0.0f);
+    const float azimuth = WrapDegrees(azimuthDeg);
+
+    if (m_layout.lateralOnly)
+    {
+        // Front and back fold together; only the lateral position survives
+        const double lateral = std::sin(azimuth * kPi / 180.0);
+        const double angle = (lateral + 1.0) * kPi / 4.0;
+        gains[m_panOrder.front()] = static_cast<float>(std::cos(angle));
+        gains[m_panOrder.back()] = static_cast<float>(std::sin(angle));
+        return;
+    }
+
+    // Find the pair of adjacent speakers enclosing the source, wrapping
+    // from the rightmost back round to the leftmost
+    const size_t count = m_panOrder.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t a = m_panOrder[i];
+        const size_t b = m_panOrder[(i + 1) % count];
+        const float from = m_speakers[a].azimuthDeg;
+        float to = m_speakers[b].azimuthDeg;
+        if (i + 1 == count)
+        {
+            to += 360.0f;
+        }
+
+        float position = azimuth;
+        if (position < from)
+        {
+            position += 360.0f;
+        }
+        if (position >= from && position <= to)
+        {
+            const double t = (to > from) ? (position - from) / (to - from) : 0.0;
+            gains[a] = static_cast<float>(std::cos(t * kPi / 2.0));
+            gains[b] = static_cast<float>(std::sin(t * kPi / 2.0));
+            return;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+namespace Benchmark
+{
+enum class SpeakerLayout
+{
+    Stereo,      // 2.0
+    Surround51,  // 5.1, surrounds at +-110 degrees
+    Surround71,  // 7.1, sides at +-90 and backs at +-150 degrees
+    Surround714, // 7.1 plus four height channels
+};
+
+inline constexpr SpeakerLayout kAllLayouts[] = {
+    SpeakerLayout::Stereo,
+    SpeakerLayout::Surround51,
+    SpeakerLayout::Surround71,
+    SpeakerLayout::Surround714,
+};
+
+struct LayoutInfo
+{
+    const char* name;
+    UINT32 channelCount;
+    DWORD channelMask; // SPEAKER_* bits, as WASAPI reports them
+    // Only left and right can be told apart (no front/back speakers), so
+    // the engine reports lateral directions only
+    bool lateralOnly;
+};
+
+const LayoutInfo& DescribeLayout(SpeakerLayout layout) noexcept;
+
+// Broadband noise from one direction. Azimuths are in degrees, 0 in front
+// and positive to the right, matching AudioDirection::azimuth.
+struct SceneSource
+{
+    float startAzimuthDeg{0.0f};
+    float endAzimuthDeg{0.0f}; // swept linearly over the source's lifetime
+    float level{0.3f};         // RMS, linear full scale
+    double onsetSeconds{0.0};
+    double durationSeconds{0.0};
+};
+
+struct SceneDescription
+{
+    std::string name;
+    double durationSeconds{0.0};
+    // Chord played identically on every full-range channel, like a mixed
+    // down music bed; 0 disables it
+    float musicLevel{0.0f};
+    std::vector<SceneSource> sources;
+};
+
+// What the engine should report for one packet
+struct GroundTruth
+{
+    int source{-1};         // loudest source playing at the packet midpoint, -1 if none
+    float azimuthDeg{0.0f}; // its azimuth at the midpoint
+    bool quiet{true};       // no source overlaps the packet at all
+};
+
+// Renders a scene packet by packet as interleaved float32, the format
+// WASAPI loopback delivers. Sources are amplitude-panned between the two
+// nearest ear-level speakers (constant power); on stereo they are panned
+// by their lateral position. Output is deterministic for a given scene.
+class SceneGenerator
+{
+public:
+    SceneGenerator(SceneDescription scene, SpeakerLayout layout, UINT32 sampleRate, UINT32 packetFrames);
+
+    // Renders the next packet; false once the scene has ended.
+    bool Next();
+
+    [[nodiscard]] const float* Samples() const noexcept { return m_buffer.data(); }
+    [[nodiscard]] UINT32 Frames() const noexcept { return m_packetFrames; }
+    [[nodiscard]] UINT32 SampleRate() const noexcept { return m_sampleRate; }
+    [[nodiscard]] const LayoutInfo& Layout() const noexcept { return m_layout; }
+    [[nodiscard]] const SceneDescription& Scene() const noexcept { return m_scene; }
+
+    // Stream time of the current packet, in seconds
+    [[nodiscard]] double PacketStart() const noexcept;
+    [[nodiscard]] double PacketEnd() const noexcept;
+
+    [[nodiscard]] GroundTruth Truth() const;
+
+    // Azimuth of a source at the given time, or nothing while it is silent
+    [[nodiscard]] std::optional<float> SourceAzimuth(size_t index, double seconds) const;
+
+private:
+    struct Speaker
+    {
+        float azimuthDeg;
+        bool earLevel; // takes part in source panning
+        bool fullRange; // carries music (everything but the LFE)
+    };
+
+    void PanSource(float azimuthDeg, float* gains) const;
+
+    SceneDescription m_scene;
+    const LayoutInfo& m_layout;
+    UINT32 m_sampleRate;
+    UINT32 m_packetFrames;
+    uint64_t m_totalFrames;
+
+    std::vector<Speaker> m_speakers; // in interleaving order
+    std::vector<size_t> m_panOrder;  // ear-level speakers by ascending azimuth
+    std::vector<uint32_t> m_noiseState; // per source
+    std::vector<float> m_gains; // per source and channel
+    std::vector<float> m_buffer;
+    uint64_t m_packetStartFrame{0};
+    bool m_started{false};
+};
+}
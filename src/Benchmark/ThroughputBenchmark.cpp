@@ -0,0 +1,171 @@
+#include "Benchmark/ThroughputBenchmark.h"
+
+#include "Audio/DirectionAnalyzer.h"
+#include "Config/ConfigManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <system_error>
+
+using namespace Benchmark;
+
+namespace
+{
+// Audio rendered up front and cycled through while timing: large enough
+// that packets are not all cache-hot, small enough to synthesize quickly
+constexpr double kSourceSeconds = 0.25;
+
+// A panned source over a music bed keeps every channel and every branch of
+// the analysis busy
+SceneDescription ThroughputScene()
+{
+    return {"throughput", kSourceSeconds, 0.2f, {{45.0f, 45.0f, 0.3f, 0.0, kSourceSeconds}}};
+}
+
+// Median ns per frame of analysing the audio with the chosen kernel and tier
+double MeasureKernel(const LayoutInfo& layoutInfo, const std::vector<float>& audio, UINT32 sampleRate,
+                     UINT32 packetFrames, Audio::DirectionAnalyzer::KernelChoice kernel, Audio::AnalysisTier tier,
+                     const ThroughputOptions& options, std::string* kernelName)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const size_t packetSamples = static_cast<size_t>(packetFrames) * layoutInfo.channelCount;
+    const size_t packetCount = audio.size() / packetSamples;
+
+    Audio::DirectionAnalyzer analyzer{std::make_shared<Config::ConfigManager>()};
+    analyzer.Configure(layoutInfo.channelCount, layoutInfo.channelMask, kernel);
+    analyzer.SetTier(tier);
+    if (kernelName)
+    {
+        *kernelName = analyzer.KernelName();
+    }
+
+    const size_t packetsPerRound = std::max<size_t>(1, sampleRate / packetFrames);
+    auto captureTime = Clock::time_point{};
+    const auto packetDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(packetFrames) / sampleRate));
+
+    // Sink for the results so the calls cannot be optimised away
+    volatile float magnitudes = 0.0f;
+    auto runRound = [&]()
+    {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < packetsPerRound; ++i)
+        {
+            const float* packet = audio.data() + (i % packetCount) * packetSamples;
+            captureTime += packetDuration;
+            magnitudes = magnitudes + analyzer.Analyze(packet, packetFrames, captureTime).magnitude;
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    runRound(); // warm-up
+    std::vector<double> rounds;
+    for (int i = 0; i < std::max(1, options.rounds); ++i)
+    {
+        rounds.push_back(runRound());
+    }
+    std::sort(rounds.begin(), rounds.end());
+    return rounds[rounds.size() / 2] / static_cast<double>(packetsPerRound * packetFrames);
+}
+
+ThroughputResult MeasureConfiguration(SpeakerLayout layout, UINT32 sampleRate, UINT32 packetFrames,
+                                      const ThroughputOptions& options)
+{
+    using Kernel = Audio::DirectionAnalyzer::KernelChoice;
+    using Tier = Audio::AnalysisTier;
+
+    SceneGenerator generator{ThroughputScene(), layout, sampleRate, packetFrames};
+    const auto& layoutInfo = generator.Layout();
+    const size_t packetSamples = static_cast<size_t>(packetFrames) * layoutInfo.channelCount;
+
+    std::vector<float> audio;
+    while (generator.Next())
+    {
+        audio.insert(audio.end(), generator.Samples(), generator.Samples() + packetSamples);
+    }
+    // Packets longer than the rendered audio still need one to analyse
+    if (audio.empty())
+    {
+        audio.resize(packetSamples, 0.1f);
+    }
+
+    ThroughputResult result;
+    result.layout = layoutInfo.name;
+    result.channels = layoutInfo.channelCount;
+    result.sampleRate = sampleRate;
+    result.packetFrames = packetFrames;
+    result.nsPerFrame = MeasureKernel(layoutInfo, audio, sampleRate, packetFrames, Kernel::Specialized, Tier::Full,
+                                      options, &result.kernel);
+    result.genericNsPerFrame = MeasureKernel(layoutInfo, audio, sampleRate, packetFrames, Kernel::Generic, Tier::Full,
+                                             options, nullptr);
+    result.reducedNsPerFrame = MeasureKernel(layoutInfo, audio, sampleRate, packetFrames, Kernel::Specialized,
+                                             Tier::Reduced, options, nullptr);
+    result.cpuPercent = result.nsPerFrame * sampleRate / 1e9 * 100.0;
+    result.withinBudget = result.cpuPercent <= options.budgetCpuPercent;
+    return result;
+}
+}
+
+std::vector<ThroughputResult> Benchmark::RunThroughputMatrix(const ThroughputOptions& options)
+{
+    std::vector<ThroughputResult> results;
+    for (auto layout : kAllLayouts)
+    {
+        for (UINT32 sampleRate : options.sampleRates)
+        {
+            for (UINT32 packetFrames : options.packetFrames)
+            {
+                results.push_back(MeasureConfiguration(layout, sampleRate, packetFrames, options));
+            }
+        }
+    }
+    return results;
+}
+
+bool Benchmark::WriteThroughputJson(const std::filesystem::path& path, const ThroughputOptions& options,
+                                    const std::vector<ThroughputResult>& results)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    const bool passed = std::all_of(results.begin(), results.end(),
+                                    [](const ThroughputResult& result) { return result.withinBudget; });
+
+    char line[320];
+    std::snprintf(line, sizeof(line),
+                  "{\"benchmark\":\"throughput\",\"budgetCpuPercent\":%.3f,\"passed\":%s,\"configurations\":[",
+                  options.budgetCpuPercent, passed ? "true" : "false");
+    file << line;
+
+    bool first = true;
+    for (const auto& result : results)
+    {
+        std::snprintf(line, sizeof(line),
+                      "{\"layout\":\"%s\",\"channels\":%u,\"sampleRate\":%u,\"packetFrames\":%u,"
+                      "\"kernel\":\"%s\",\"nsPerFrame\":%.2f,\"cpuPercent\":%.4f,"
+                      "\"genericNsPerFrame\":%.2f,\"speedup\":%.2f,\"reducedNsPerFrame\":%.2f,\"withinBudget\":%s}",
+                      result.layout.c_str(), result.channels, result.sampleRate, result.packetFrames,
+                      result.kernel.c_str(), result.nsPerFrame, result.cpuPercent, result.genericNsPerFrame,
+                      result.nsPerFrame > 0.0 ? result.genericNsPerFrame / result.nsPerFrame : 0.0,
+                      result.reducedNsPerFrame,
+                      result.withinBudget ? "true" : "false");
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark/SceneGenerator.h"
+
+namespace Benchmark
+{
+struct ThroughputOptions
+{
+    std::vector<UINT32> sampleRates{48000, 96000, 192000};
+    std::vector<UINT32> packetFrames{128, 480, 1024, 4096};
+    // Highest acceptable analysis cost of one stream, as a share of one
+    // core while keeping up with real time
+    double budgetCpuPercent{1.0};
+    // Each configuration is timed over this many rounds of one second of
+    // audio; the median round is reported
+    int rounds{5};
+};
+
+// Analysis cost of one layout, sample rate and packet size, with the
+// kernel the engine would select, with the generic kernel, and on the
+// reduced tier capture falls back to when it is behind
+struct ThroughputResult
+{
+    std::string layout;
+    UINT32 channels{0};
+    UINT32 sampleRate{0};
+    UINT32 packetFrames{0};
+    std::string kernel;
+    double nsPerFrame{0.0};
+    double cpuPercent{0.0}; // of one core at real time
+    double genericNsPerFrame{0.0};
+    double reducedNsPerFrame{0.0}; // selected kernel on the reduced analysis tier
+    bool withinBudget{true}; // judged on the selected kernel
+};
+
+// Every layout × sample rate × packet size, through DirectionAnalyzer
+std::vector<ThroughputResult> RunThroughputMatrix(const ThroughputOptions& options);
+
+bool WriteThroughputJson(const std::filesystem::path& path, const ThroughputOptions& options,
+                         const std::vector<ThroughputResult>& results);
+}
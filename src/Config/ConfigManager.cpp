@@ -2,6 +2,7 @@
 
 #include <ShlObj.h>
 
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <stdexcept>
@@ -109,6 +110,28 @@ void ConfigManager::Load()
     m_limits.maxCpuPercent = ReadDouble(path, L"limits", L"cpu", m_limits.maxCpuPercent);
     m_limits.maxMemoryMb = static_cast<size_t>(ReadDouble(path, L"limits", L"memory", static_cast<double>(m_limits.maxMemoryMb)));
 
+    m_display.showDiagnostics = ReadInt(path, L"display", L"diagnostics", m_display.showDiagnostics ? 1 : 0) != 0;
+    int visualization = ReadInt(path, L"display", L"mode", static_cast<int>(m_display.visualization));
+    if (visualization < 0 || visualization > 2)
+    {
+        visualization = static_cast<int>(VisualizationMode::Radar);
+    }
+    m_display.visualization = static_cast<VisualizationMode>(visualization);
+    m_display.perPixelAlpha = ReadInt(path, L"display", L"perPixelAlpha", m_display.perPixelAlpha ? 1 : 0) != 0;
+    m_display.predictMotion = ReadInt(path, L"display", L"predict", m_display.predictMotion ? 1 : 0) != 0;
+    m_display.metricsLog = ReadInt(path, L"display", L"metricsLog", m_display.metricsLog ? 1 : 0) != 0;
+
+    auto& capture = m_scheduling.capture;
+    capture.enabled = ReadInt(path, L"scheduling", L"realtime", capture.enabled ? 1 : 0) != 0;
+    // GetPrivateProfileInt reads negative numbers as 0, which is a real core
+    capture.core = std::max(-1, static_cast<int>(ReadDouble(path, L"scheduling", L"core", capture.core)));
+    int cores = ReadInt(path, L"scheduling", L"cores", static_cast<int>(capture.cores));
+    if (cores < 0 || cores > 2)
+    {
+        cores = static_cast<int>(Util::CorePreference::Any);
+    }
+    capture.cores = static_cast<Util::CorePreference>(cores);
+
     int mode = ReadInt(path, L"audio", L"mode", static_cast<int>(m_audioMode));
     if (mode < 0 || mode > 2)
     {
@@ -148,6 +171,16 @@ void ConfigManager::Save() const
     WriteDouble(path, L"limits", L"cpu", m_limits.maxCpuPercent);
     WriteDouble(path, L"limits", L"memory", static_cast<double>(m_limits.maxMemoryMb));
 
+    WriteDouble(path, L"display", L"diagnostics", m_display.showDiagnostics ? 1 : 0);
+    WriteDouble(path, L"display", L"mode", static_cast<int>(m_display.visualization));
+    WriteDouble(path, L"display", L"perPixelAlpha", m_display.perPixelAlpha ? 1 : 0);
+    WriteDouble(path, L"display", L"predict", m_display.predictMotion ? 1 : 0);
+    WriteDouble(path, L"display", L"metricsLog", m_display.metricsLog ? 1 : 0);
+
+    WriteDouble(path, L"scheduling", L"realtime", m_scheduling.capture.enabled ? 1 : 0);
+    WriteDouble(path, L"scheduling", L"core", m_scheduling.capture.core);
+    WriteDouble(path, L"scheduling", L"cores", static_cast<int>(m_scheduling.capture.cores));
+
     WriteDouble(path, L"audio", L"mode", static_cast<int>(m_audioMode));
 }
 
@@ -172,6 +205,11 @@ void ConfigManager::SetDirectionEnabled(const std::wstring& direction, bool enab
     else if (direction == L"down") m_filter.down = enabled;
 }
 
+std::filesystem::path ConfigManager::DataDirectory() const
+{
+    return GetConfigPath().parent_path();
+}
+
 std::filesystem::path ConfigManager::GetConfigPath() const
 {
     PWSTR appDataPath{};
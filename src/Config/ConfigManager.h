@@ -7,6 +7,8 @@
 
 #include <windows.h>
 
+#include "Util/RealtimeScheduling.h"
+
 namespace Config
 {
 enum class AudioModeOverride
@@ -16,6 +18,13 @@ enum class AudioModeOverride
     Multichannel = 2,
 };
 
+enum class VisualizationMode
+{
+    Radar = 0,   // Fading per-hit markers
+    Heatmap = 1, // Decaying angular histogram
+    Waterfall = 2, // Scrolling azimuth-versus-time history
+};
+
 struct HotkeyConfig
 {
     UINT modifier{MOD_CONTROL | MOD_ALT};
@@ -59,6 +68,29 @@ struct PerformanceLimits
     size_t maxMemoryMb{50};
 };
 
+struct SchedulingConfig
+{
+    // Real-time priority and core placement for the capture thread, which
+    // also runs direction analysis. Off by default: a game starving the
+    // thread is the exception, and MMCSS threads compete with the game's own.
+    Util::RealtimePolicy capture;
+};
+
+struct DisplayConfig
+{
+    // Frame/text timing line at the bottom of the overlay
+    bool showDiagnostics{false};
+    VisualizationMode visualization{VisualizationMode::Radar};
+    // Present through UpdateLayeredWindow with per-pixel alpha instead of
+    // an HWND render target with one window-wide alpha
+    bool perPixelAlpha{false};
+    // Extrapolate new markers along the source's angular velocity to the
+    // expected present time, compensating capture-to-display latency
+    bool predictMotion{true};
+    // Append a metrics snapshot per second to metrics.log beside config.ini
+    bool metricsLog{false};
+};
+
 class ConfigManager
 {
 public:
@@ -82,12 +114,21 @@ public:
     const PerformanceLimits& Limits() const noexcept { return m_limits; }
     PerformanceLimits& Limits() noexcept { return m_limits; }
 
+    const DisplayConfig& Display() const noexcept { return m_display; }
+    DisplayConfig& Display() noexcept { return m_display; }
+
+    const SchedulingConfig& Scheduling() const noexcept { return m_scheduling; }
+    SchedulingConfig& Scheduling() noexcept { return m_scheduling; }
+
     AudioModeOverride AudioMode() const noexcept { return m_audioMode; }
     void SetAudioMode(AudioModeOverride mode) noexcept { m_audioMode = mode; }
 
     bool IsDirectionEnabled(const std::wstring& direction) const;
     void SetDirectionEnabled(const std::wstring& direction, bool enabled);
 
+    // Per-user folder holding config.ini and diagnostics output
+    std::filesystem::path DataDirectory() const;
+
 private:
     std::filesystem::path GetConfigPath() const;
 
@@ -96,6 +137,8 @@ private:
     DirectionFilter m_filter;
     HotkeyConfig m_hotkeys;
     PerformanceLimits m_limits;
+    DisplayConfig m_display;
+    SchedulingConfig m_scheduling;
     AudioModeOverride m_audioMode{AudioModeOverride::Auto};
 };
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Diagnostics/MetricsRegistry.h"
+
+// Heap allocation counting is compiled in only when
+// SPATIAL_AUDIO_COUNT_ALLOCATIONS is defined (Debug builds, or
+// -DSPATIAL_AUDIO_COUNT_ALLOCATIONS=ON with CMake): global operator new is
+// then replaced with a version that counts per thread.
+#if defined(SPATIAL_AUDIO_COUNT_ALLOCATIONS)
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+// Adds the allocations the calling thread makes in the enclosing block to
+// the named registry counter. In steady state these should stay at zero.
+#define ALLOCATION_PROBE(name)                                                                          \
+    static ::Diagnostics::Counter& ALLOCATION_CONCAT(allocationCounter_, __LINE__) =                   \
+        ::Diagnostics::MetricsRegistry::Instance().GetCounter(name);                                    \
+    ::Diagnostics::AllocationProbe ALLOCATION_CONCAT(allocationProbe_, __LINE__)                        \
+    {                                                                                                   \
+        ALLOCATION_CONCAT(allocationCounter_, __LINE__)                                                 \
+    }
+#else
+#define ALLOCATION_PROBE(name) ((void)0)
+#endif
+
+namespace Diagnostics
+{
+#if defined(SPATIAL_AUDIO_COUNT_ALLOCATIONS)
+inline constexpr bool kAllocationCountingEnabled = true;
+#else
+inline constexpr bool kAllocationCountingEnabled = false;
+#endif
+
+// Allocations made by the calling thread through operator new since it
+// started; always zero unless counting is compiled in.
+[[nodiscard]] uint64_t ThreadAllocationCount() noexcept;
+
+class AllocationProbe
+{
+public:
+    explicit AllocationProbe(Counter& counter) noexcept
+        : m_counter(counter)
+        , m_start(ThreadAllocationCount())
+    {
+    }
+
+    ~AllocationProbe()
+    {
+        const uint64_t made = ThreadAllocationCount() - m_start;
+        if (made != 0)
+        {
+            m_counter.Add(made);
+        }
+    }
+
+    AllocationProbe(const AllocationProbe&) = delete;
+    AllocationProbe& operator=(const AllocationProbe&) = delete;
+
+private:
+    Counter& m_counter;
+    const uint64_t m_start;
+};
+}
@@ -0,0 +1,92 @@
+#include "Diagnostics/MetricsRegistry.h"
+
+#include <algorithm>
+
+using namespace Diagnostics;
+
+namespace
+{
+template <typename Metric>
+Metric& FindOrAdd(std::map<std::string, std::unique_ptr<Metric>, std::less<>>& table, std::string_view name)
+{
+    auto it = table.find(name);
+    if (it == table.end())
+    {
+        it = table.emplace(std::string(name), std::make_unique<Metric>()).first;
+    }
+    return *it->second;
+}
+}
+
+MetricsRegistry& MetricsRegistry::Instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+Counter& MetricsRegistry::GetCounter(std::string_view name)
+{
+    std::scoped_lock lock{m_mutex};
+    return FindOrAdd(m_counters, name);
+}
+
+Gauge& MetricsRegistry::GetGauge(std::string_view name)
+{
+    std::scoped_lock lock{m_mutex};
+    return FindOrAdd(m_gauges, name);
+}
+
+Util::LatencyHistogram& MetricsRegistry::GetHistogram(std::string_view name)
+{
+    std::scoped_lock lock{m_mutex};
+    return FindOrAdd(m_histograms, name);
+}
+
+std::vector<MetricSample> MetricsRegistry::Snapshot() const
+{
+    std::vector<MetricSample> samples;
+
+    std::scoped_lock lock{m_mutex};
+    samples.reserve(m_counters.size() + m_gauges.size() + m_histograms.size());
+
+    for (const auto& [name, counter] : m_counters)
+    {
+        MetricSample sample;
+        sample.name = name;
+        sample.kind = MetricKind::Counter;
+        sample.value = static_cast<int64_t>(counter->Total());
+        samples.push_back(std::move(sample));
+    }
+
+    for (const auto& [name, gauge] : m_gauges)
+    {
+        MetricSample sample;
+        sample.name = name;
+        sample.kind = MetricKind::Gauge;
+        sample.value = gauge->Value();
+        samples.push_back(std::move(sample));
+    }
+
+    for (const auto& [name, histogram] : m_histograms)
+    {
+        MetricSample sample;
+        sample.name = name;
+        sample.kind = MetricKind::Histogram;
+        sample.value = static_cast<int64_t>(histogram->Count());
+        sample.p50 = histogram->Percentile(0.50);
+        sample.p99 = histogram->Percentile(0.99);
+        sample.max = histogram->Max();
+        samples.push_back(std::move(sample));
+    }
+
+    std::sort(samples.begin(), samples.end(),
+              [](const MetricSample& a, const MetricSample& b) { return a.name < b.name; });
+    return samples;
+}
+
+const MetricSample* Diagnostics::FindMetric(const std::vector<MetricSample>& metrics, std::string_view name) noexcept
+{
+    const auto it = std::lower_bound(metrics.begin(), metrics.end(), name,
+                                     [](const MetricSample& sample, std::string_view key) { return sample.name < key; });
+    return (it != metrics.end() && it->name == name) ? &*it : nullptr;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Util/LatencyHistogram.h"
+
+namespace Diagnostics
+{
+// Monotonic event count. Each thread adds to its own cache line, so the
+// capture, router and render threads never contend on a shared counter;
+// readers sum the shards.
+class Counter
+{
+public:
+    static constexpr size_t kShards = 8;
+
+    void Add(uint64_t delta = 1) noexcept
+    {
+        m_shards[ThreadShard()].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t Total() const noexcept
+    {
+        uint64_t total = 0;
+        for (const auto& shard : m_shards)
+        {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    static size_t ThreadShard() noexcept
+    {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t shard = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return shard;
+    }
+
+    std::array<Shard, kShards> m_shards{};
+};
+
+// Last written level, e.g. a queue depth.
+class Gauge
+{
+public:
+    void Set(int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+    void Add(int64_t delta) noexcept { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    [[nodiscard]] int64_t Value() const noexcept { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+enum class MetricKind
+{
+    Counter,
+    Gauge,
+    Histogram,
+};
+
+struct MetricSample
+{
+    std::string name;
+    MetricKind kind{MetricKind::Counter};
+    // Counter total, gauge level or histogram sample count
+    int64_t value{0};
+    // Counters only: increase per second over the last sampling period
+    double ratePerSecond{0.0};
+    // Histograms only
+    std::chrono::microseconds p50{0};
+    std::chrono::microseconds p99{0};
+    std::chrono::microseconds max{0};
+};
+
+// Process-wide table of named metrics. Lookup takes a lock and is meant for
+// construction time: callers keep the returned reference, which stays valid
+// for the life of the process, and update it lock-free from hot paths.
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& Instance();
+
+    Counter& GetCounter(std::string_view name);
+    Gauge& GetGauge(std::string_view name);
+    Util::LatencyHistogram& GetHistogram(std::string_view name);
+
+    // Sorted by name; counter rates are left at zero.
+    [[nodiscard]] std::vector<MetricSample> Snapshot() const;
+
+private:
+    MetricsRegistry() = default;
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<Counter>, std::less<>> m_counters;
+    std::map<std::string, std::unique_ptr<Gauge>, std::less<>> m_gauges;
+    std::map<std::string, std::unique_ptr<Util::LatencyHistogram>, std::less<>> m_histograms;
+};
+
+[[nodiscard]] const MetricSample* FindMetric(const std::vector<MetricSample>& metrics, std::string_view name) noexcept;
+}
@@ -1,16 +1,37 @@
 #include "Diagnostics/PerformanceMonitor.h"
 
 #include "Config/ConfigManager.h"
+#include "Diagnostics/TraceRecorder.h"
 
 #include <Psapi.h>
 #include <windows.h>
 
 #include <chrono>
+#include <cstdio>
+#include <system_error>
+#include <thread>
 
 using namespace Diagnostics;
 
+namespace
+{
+constexpr wchar_t kMetricsLogName[] = L"metrics.log";
+// The log is rolled over to metrics.log.1 past this size
+constexpr std::uintmax_t kMaxLogBytes = 8ull * 1024 * 1024;
+
+ULONGLONG ToUlonglong(const FILETIME& time)
+{
+    ULARGE_INTEGER value{};
+    value.LowPart = time.dwLowDateTime;
+    value.HighPart = time.dwHighDateTime;
+    return value.QuadPart;
+}
+}
+
 PerformanceMonitor::PerformanceMonitor(std::shared_ptr<Config::ConfigManager> config)
     : m_config(std::move(config))
+    , m_logEnabled(m_config->Display().metricsLog)
+    , m_logPath(m_config->DataDirectory() / kMetricsLogName)
 {
     Start();
 }
@@ -27,7 +48,7 @@ void PerformanceMonitor::Start()
         return;
     }
 
-    m_thread = std::thread(&PerformanceMonitor::Worker, this);
+    m_thread = Util::NamedThread("monitor", &PerformanceMonitor::Worker, this);
 }
 
 void PerformanceMonitor::Stop()
@@ -51,43 +72,59 @@ PerformanceSnapshot PerformanceMonitor::GetLatest() const
 
 void PerformanceMonitor::Worker()
 {
+    TRACE_THREAD_NAME("monitor");
     using namespace std::chrono_literals;
     while (m_running)
     {
         {
             auto snapshot = Sample();
+            WriteToSink(snapshot);
             std::scoped_lock lock{m_mutex};
-            m_snapshot = snapshot;
+            m_snapshot = std::move(snapshot);
         }
         std::this_thread::sleep_for(1s);
     }
+
+    m_log.close();
 }
 
-PerformanceSnapshot PerformanceMonitor::Sample() const
+PerformanceSnapshot PerformanceMonitor::Sample()
 {
     PerformanceSnapshot snapshot;
 
     FILETIME idleTime{}, kernelTime{}, userTime{};
     if (GetSystemTimes(&idleTime, &kernelTime, &userTime))
     {
-        static ULARGE_INTEGER lastIdle{}, lastKernel{}, lastUser{};
         ULARGE_INTEGER idle{ idleTime.dwLowDateTime, idleTime.dwHighDateTime };
         ULARGE_INTEGER kernel{ kernelTime.dwLowDateTime, kernelTime.dwHighDateTime };
         ULARGE_INTEGER user{ userTime.dwLowDateTime, userTime.dwHighDateTime };
 
-        const ULONGLONG idleDiff = idle.QuadPart - lastIdle.QuadPart;
-        const ULONGLONG kernelDiff = kernel.QuadPart - lastKernel.QuadPart;
-        const ULONGLONG userDiff = user.QuadPart - lastUser.QuadPart;
+        const ULONGLONG idleDiff = idle.QuadPart - m_lastIdle.QuadPart;
+        const ULONGLONG kernelDiff = kernel.QuadPart - m_lastKernel.QuadPart;
+        const ULONGLONG userDiff = user.QuadPart - m_lastUser.QuadPart;
         const ULONGLONG total = kernelDiff + userDiff;
 
+        // System kernel time includes idle time, so total is every core's
+        // share of the period; process time is measured against the same.
+        FILETIME creation{}, exit{}, processKernel{}, processUser{};
+        if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &processKernel, &processUser))
+        {
+            const ULONGLONG processTime = ToUlonglong(processKernel) + ToUlonglong(processUser);
+            if (total > 0 && m_lastProcessTime != 0)
+            {
+                snapshot.processCpuPercent = static_cast<double>(processTime - m_lastProcessTime) / total * 100.0;
+            }
+            m_lastProcessTime = processTime;
+        }
+
         if (total > 0)
         {
             snapshot.cpuPercent = (1.0 - (static_cast<double>(idleDiff) / total)) * 100.0;
         }
 
-        lastIdle = idle;
-        lastKernel = kernel;
-        lastUser = user;
+        m_lastIdle = idle;
+        m_lastKernel = kernel;
+        m_lastUser = user;
     }
 
     PROCESS_MEMORY_COUNTERS counters{};
@@ -97,5 +134,104 @@ PerformanceSnapshot PerformanceMonitor::Sample() const
         snapshot.memoryMb = counters.WorkingSetSize / (1024 * 1024);
     }
 
+    snapshot.threads = m_threadLoad.Update();
+
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - m_lastSample).count();
+    const bool haveRates = m_lastSample != std::chrono::steady_clock::time_point{} && elapsed > 0.0;
+    m_lastSample = now;
+
+    snapshot.metrics = MetricsRegistry::Instance().Snapshot();
+    for (auto& metric : snapshot.metrics)
+    {
+        if (metric.kind != MetricKind::Counter)
+        {
+            continue;
+        }
+
+        auto& previous = m_lastCounters[metric.name];
+        if (haveRates)
+        {
+            metric.ratePerSecond = static_cast<double>(metric.value - previous) / elapsed;
+        }
+        previous = metric.value;
+    }
+
     return snapshot;
 }
+
+void PerformanceMonitor::WriteToSink(const PerformanceSnapshot& snapshot)
+{
+    if (!m_logEnabled.load(std::memory_order_relaxed))
+    {
+        if (m_log.is_open())
+        {
+            m_log.close();
+        }
+        return;
+    }
+
+    if (m_log.is_open() && m_log.tellp() > static_cast<std::streamoff>(kMaxLogBytes))
+    {
+        m_log.close();
+        auto rolled = m_logPath;
+        rolled += L".1";
+        std::error_code error;
+        std::filesystem::remove(rolled, error);
+        std::filesystem::rename(m_logPath, rolled, error);
+    }
+
+    if (!m_log.is_open())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(m_logPath.parent_path(), error);
+        m_log.open(m_logPath, std::ios::out | std::ios::app);
+        if (!m_log)
+        {
+            // Unwritable folder: stop retrying every second
+            m_logEnabled.store(false, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    // One line per sample: wall time, process-level figures, then every
+    // metric as name=value (counters also carry their rate per second).
+    SYSTEMTIME time{};
+    GetLocalTime(&time);
+
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "%04u-%02u-%02u %02u:%02u:%02u cpu=%.1f process=%.2f memMb=%zu",
+                  time.wYear, time.wMonth, time.wDay, time.wHour, time.wMinute, time.wSecond,
+                  snapshot.cpuPercent, snapshot.processCpuPercent, snapshot.memoryMb);
+    m_log << buffer;
+
+    for (const auto& thread : snapshot.threads)
+    {
+        std::snprintf(buffer, sizeof(buffer), " thread.%s=%.2f%%", thread.name.c_str(), thread.percentOfCore);
+        m_log << buffer;
+    }
+
+    for (const auto& metric : snapshot.metrics)
+    {
+        switch (metric.kind)
+        {
+        case MetricKind::Counter:
+            std::snprintf(buffer, sizeof(buffer), " %s=%lld@%.1f/s",
+                          metric.name.c_str(), static_cast<long long>(metric.value), metric.ratePerSecond);
+            break;
+        case MetricKind::Gauge:
+            std::snprintf(buffer, sizeof(buffer), " %s=%lld", metric.name.c_str(), static_cast<long long>(metric.value));
+            break;
+        case MetricKind::Histogram:
+            std::snprintf(buffer, sizeof(buffer), " %s=n%lld/p50:%lld/p99:%lld/max:%lldus",
+                          metric.name.c_str(), static_cast<long long>(metric.value),
+                          static_cast<long long>(metric.p50.count()), static_cast<long long>(metric.p99.count()),
+                          static_cast<long long>(metric.max.count()));
+            break;
+        }
+        m_log << buffer;
+    }
+
+    m_log << '\n';
+    m_log.flush();
+}
@@ -1,9 +1,20 @@
 #pragma once
 
+#include <windows.h>
+
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <string>
+#include <vector>
+
+#include "Diagnostics/MetricsRegistry.h"
+#include "Util/NamedThread.h"
 
 namespace Config { class ConfigManager; }
 
@@ -11,8 +22,13 @@ namespace Diagnostics
 {
 struct PerformanceSnapshot
 {
-    double cpuPercent{0.0};
+    double cpuPercent{0.0};        // whole system
+    double processCpuPercent{0.0}; // this process, as a share of all cores
     size_t memoryMb{0};
+    // Per named thread, as a share of one core
+    std::vector<Util::ThreadLoad> threads;
+    // Registry contents at sampling time, sorted by name
+    std::vector<MetricSample> metrics;
 };
 
 class PerformanceMonitor
@@ -26,14 +42,30 @@ public:
 
     PerformanceSnapshot GetLatest() const;
 
+    // Appends every sample to metrics.log in the config folder while enabled.
+    void SetFileSink(bool enabled) noexcept { m_logEnabled.store(enabled, std::memory_order_relaxed); }
+
 private:
     void Worker();
-    PerformanceSnapshot Sample() const;
+    PerformanceSnapshot Sample();
+    void WriteToSink(const PerformanceSnapshot& snapshot);
 
     std::shared_ptr<Config::ConfigManager> m_config;
     std::atomic<bool> m_running{false};
-    std::thread m_thread;
+    std::atomic<bool> m_logEnabled{false};
+    Util::NamedThread m_thread;
     mutable std::mutex m_mutex;
     PerformanceSnapshot m_snapshot;
+
+    // Worker-thread state
+    ULARGE_INTEGER m_lastIdle{};
+    ULARGE_INTEGER m_lastKernel{};
+    ULARGE_INTEGER m_lastUser{};
+    ULONGLONG m_lastProcessTime{0};
+    Util::ThreadLoadMeter m_threadLoad;
+    std::chrono::steady_clock::time_point m_lastSample;
+    std::map<std::string, int64_t, std::less<>> m_lastCounters;
+    std::filesystem::path m_logPath;
+    std::ofstream m_log;
 };
 }
@@ -0,0 +1,157 @@
+#include "Diagnostics/TraceRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <string>
+
+using namespace Diagnostics;
+
+namespace
+{
+// Per thread: ~0.75 MB, several seconds of spans at the capture rate
+constexpr size_t kSpanCapacity = 1 << 15;
+// Spans this close to being overwritten are skipped when writing, so a
+// thread still recording during the write cannot tear the ones we read.
+constexpr size_t kWriteMargin = 1024;
+}
+
+struct TraceRecorder::ThreadBuffer
+{
+    struct Span
+    {
+        const char* name;
+        int64_t startNs; // since the recorder's epoch
+        int64_t durationNs;
+    };
+
+    explicit ThreadBuffer(uint32_t id)
+        : spans(std::make_unique<Span[]>(kSpanCapacity))
+        , threadId(id)
+    {
+    }
+
+    std::unique_ptr<Span[]> spans;
+    std::atomic<uint64_t> head{0}; // total spans recorded; written by the owning thread only
+    const uint32_t threadId;
+    std::string name; // guarded by the recorder's mutex
+};
+
+TraceRecorder& TraceRecorder::Instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : m_epoch(Clock::now())
+{
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder::ThreadBuffer* TraceRecorder::CurrentBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+        std::scoped_lock lock{m_mutex};
+        m_buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(m_buffers.size() + 1)));
+        buffer = m_buffers.back().get();
+    }
+    return buffer;
+}
+
+void TraceRecorder::Record(const char* name, Clock::time_point start, Clock::time_point end) noexcept
+{
+    ThreadBuffer* buffer = nullptr;
+    try
+    {
+        buffer = CurrentBuffer();
+    }
+    catch (...)
+    {
+        return;
+    }
+
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    auto& span = buffer->spans[head % kSpanCapacity];
+    span.name = name;
+    span.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_epoch).count();
+    span.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void TraceRecorder::SetThreadName(const char* name)
+{
+    auto* buffer = CurrentBuffer();
+    std::scoped_lock lock{m_mutex};
+    buffer->name = name;
+}
+
+bool TraceRecorder::WriteChromeJson(const std::filesystem::path& path) const
+{
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+
+    char line[256];
+    bool first = true;
+    auto emit = [&]()
+    {
+        file << (first ? "\n" : ",\n") << line;
+        first = false;
+    };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    std::scoped_lock lock{m_mutex};
+    for (const auto& buffer : m_buffers)
+    {
+        if (!buffer->name.empty())
+        {
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                          buffer->threadId, buffer->name.c_str());
+            emit();
+        }
+
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t count = std::min<uint64_t>(head, kSpanCapacity - kWriteMargin);
+        for (uint64_t i = head - count; i < head; ++i)
+        {
+            const auto& span = buffer->spans[i % kSpanCapacity];
+            std::snprintf(line, sizeof(line),
+                          "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                          span.name, buffer->threadId,
+                          static_cast<double>(span.startNs) / 1000.0, static_cast<double>(span.durationNs) / 1000.0);
+            emit();
+        }
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
+
+std::filesystem::path TraceRecorder::TimestampedPath(const std::filesystem::path& directory)
+{
+    const std::time_t now = std::time(nullptr);
+    std::tm local{};
+#if defined(_WIN32)
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+
+    char name[40];
+    std::strftime(name, sizeof(name), "trace-%Y%m%d-%H%M%S.json", &local);
+    return directory / name;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Span tracing is compiled in only when SPATIAL_AUDIO_TRACE is defined
+// (Debug builds, or -DSPATIAL_AUDIO_TRACE=ON with CMake). Otherwise the
+// macros expand to nothing and no call reaches the recorder.
+#if defined(SPATIAL_AUDIO_TRACE)
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// Records the enclosing block as a span; name must be a string literal.
+#define TRACE_SCOPE(name) ::Diagnostics::TraceScope TRACE_CONCAT(traceScope_, __LINE__){name}
+// Labels the calling thread's track in the trace viewer.
+#define TRACE_THREAD_NAME(name) ::Diagnostics::TraceRecorder::Instance().SetThreadName(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+namespace Diagnostics
+{
+#if defined(SPATIAL_AUDIO_TRACE)
+inline constexpr bool kTraceEnabled = true;
+#else
+inline constexpr bool kTraceEnabled = false;
+#endif
+
+// Collects completed spans into one ring buffer per thread. Recording is
+// lock-free; only a thread's first span registers its buffer. Buffers
+// outlive their threads so spans survive until the trace is written at exit.
+class TraceRecorder
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static TraceRecorder& Instance();
+
+    void Record(const char* name, Clock::time_point start, Clock::time_point end) noexcept;
+    void SetThreadName(const char* name);
+
+    // Writes the buffered spans of every thread as Chrome trace-event JSON,
+    // loadable in chrome://tracing or ui.perfetto.dev.
+    bool WriteChromeJson(const std::filesystem::path& path) const;
+
+    // <directory>/trace-YYYYMMDD-HHMMSS.json for the current local time
+    static std::filesystem::path TimestampedPath(const std::filesystem::path& directory);
+
+private:
+    struct ThreadBuffer;
+
+    TraceRecorder();
+    ~TraceRecorder();
+    ThreadBuffer* CurrentBuffer();
+
+    const Clock::time_point m_epoch;
+    mutable std::mutex m_mutex; // guards m_buffers and thread names
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) noexcept
+        : m_name(name)
+        , m_start(TraceRecorder::Clock::now())
+    {
+    }
+
+    ~TraceScope() { TraceRecorder::Instance().Record(m_name, m_start, TraceRecorder::Clock::now()); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;
+    TraceRecorder::Clock::time_point m_start;
+};
+}
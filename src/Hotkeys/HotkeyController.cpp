@@ -1,6 +1,7 @@
 #include "Hotkeys/HotkeyController.h"
 
 #include "Config/ConfigManager.h"
+#include "Diagnostics/TraceRecorder.h"
 #include "UI/OverlayWindow.h"
 
 using namespace Hotkeys;
@@ -9,6 +10,9 @@ namespace
 {
 constexpr wchar_t kHotkeyWindowClass[] = L"SpatialAudioHotkeyWindow";
 constexpr UINT WM_HOTKEY_EVENT = WM_APP + 1;
+// Ctrl+Alt+T writes the span trace collected so far
+constexpr UINT kTraceHotkeyModifiers = MOD_CONTROL | MOD_ALT | MOD_NOREPEAT;
+constexpr UINT kTraceHotkeyKey = 'T';
 }
 
 HotkeyController::HotkeyController(HINSTANCE instance, UI::OverlayWindow* overlay, std::shared_ptr<Config::ConfigManager> config)
@@ -54,6 +58,10 @@ void HotkeyController::RegisterHotkey()
 {
     const auto hotkey = m_config->Hotkeys();
     RegisterHotKey(m_hwnd, m_hotkeyId, hotkey.modifier, hotkey.key);
+    if constexpr (Diagnostics::kTraceEnabled)
+    {
+        RegisterHotKey(m_hwnd, m_traceHotkeyId, kTraceHotkeyModifiers, kTraceHotkeyKey);
+    }
 }
 
 void HotkeyController::UnregisterHotkey()
@@ -61,6 +69,19 @@ void HotkeyController::UnregisterHotkey()
     if (m_hwnd)
     {
         UnregisterHotKey(m_hwnd, m_hotkeyId);
+        if constexpr (Diagnostics::kTraceEnabled)
+        {
+            UnregisterHotKey(m_hwnd, m_traceHotkeyId);
+        }
+    }
+}
+
+void HotkeyController::WriteTrace() const
+{
+    const auto path = Diagnostics::TraceRecorder::TimestampedPath(m_config->DataDirectory());
+    if (Diagnostics::TraceRecorder::Instance().WriteChromeJson(path))
+    {
+        OutputDebugStringW((L"Trace written to " + path.wstring() + L"\n").c_str());
     }
 }
 
@@ -81,7 +102,14 @@ LRESULT CALLBACK HotkeyController::WindowProc(HWND hwnd, UINT message, WPARAM wP
 
     if (message == WM_HOTKEY)
     {
-        controller->m_overlay->Toggle();
+        if (wParam == controller->m_traceHotkeyId)
+        {
+            controller->WriteTrace();
+        }
+        else
+        {
+            controller->m_overlay->Toggle();
+        }
         return 0;
     }
 
@@ -21,6 +21,7 @@ public:
 private:
     void RegisterHotkey();
     void UnregisterHotkey();
+    void WriteTrace() const;
     static LRESULT CALLBACK WindowProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
 
     HINSTANCE m_instance;
@@ -29,5 +30,6 @@ private:
 
     HWND m_hwnd{nullptr};
     UINT m_hotkeyId{1};
+    UINT m_traceHotkeyId{2}; // registered only when tracing is compiled in
 };
 }
@@ -0,0 +1,67 @@
+#include "Rendering/Direct2DRenderBackend.h"
+
+#include <d2d1helper.h>
+
+#include "Util/ComException.h"
+
+using namespace Rendering;
+
+namespace
+{
+D2D1_COLOR_F ToColor(const RenderColor& color)
+{
+    return D2D1::ColorF(color.r, color.g, color.b, color.a);
+}
+
+D2D1_POINT_2F ToPoint(RenderPoint point)
+{
+    return D2D1::Point2F(point.x, point.y);
+}
+}
+
+Direct2DRenderBackend::Direct2DRenderBackend(ID2D1RenderTarget* target)
+    : m_target(target)
+{
+    THROW_IF_FAILED(m_target->CreateSolidColorBrush(D2D1::ColorF(0, 0), &m_brush));
+}
+
+void Direct2DRenderBackend::Clear(const RenderColor& color)
+{
+    m_target->Clear(ToColor(color));
+}
+
+void Direct2DRenderBackend::DrawLine(RenderPoint from, RenderPoint to, const RenderColor& color, float width)
+{
+    m_target->DrawLine(ToPoint(from), ToPoint(to), Brush(color), width);
+}
+
+void Direct2DRenderBackend::DrawCircle(RenderPoint center, float radius, const RenderColor& color, float width)
+{
+    m_target->DrawEllipse(D2D1::Ellipse(ToPoint(center), radius, radius), Brush(color), width);
+}
+
+void Direct2DRenderBackend::FillCircle(RenderPoint center, float radius, const RenderColor& color)
+{
+    m_target->FillEllipse(D2D1::Ellipse(ToPoint(center), radius, radius), Brush(color));
+}
+
+void Direct2DRenderBackend::FillRect(const RenderRect& rect, const RenderColor& color)
+{
+    m_target->FillRectangle(D2D1::RectF(rect.left, rect.top, rect.right, rect.bottom), Brush(color));
+}
+
+void Direct2DRenderBackend::PushClip(const RenderRect& rect)
+{
+    m_target->PushAxisAlignedClip(D2D1::RectF(rect.left, rect.top, rect.right, rect.bottom), D2D1_ANTIALIAS_MODE_ALIASED);
+}
+
+void Direct2DRenderBackend::PopClip()
+{
+    m_target->PopAxisAlignedClip();
+}
+
+ID2D1SolidColorBrush* Direct2DRenderBackend::Brush(const RenderColor& color)
+{
+    m_brush->SetColor(ToColor(color));
+    return m_brush.Get();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <d2d1.h>
+#include <wrl/client.h>
+
+#include "Rendering/RenderBackend.h"
+
+namespace Rendering
+{
+// RenderBackend over any Direct2D render target (HWND, compatible bitmap).
+// Owns a single solid brush that is recolored per call; the target must be
+// between BeginDraw and EndDraw while drawing.
+class Direct2DRenderBackend final : public RenderBackend
+{
+public:
+    explicit Direct2DRenderBackend(ID2D1RenderTarget* target);
+
+    void Clear(const RenderColor& color) override;
+    void DrawLine(RenderPoint from, RenderPoint to, const RenderColor& color, float width) override;
+    void DrawCircle(RenderPoint center, float radius, const RenderColor& color, float width) override;
+    void FillCircle(RenderPoint center, float radius, const RenderColor& color) override;
+    void FillRect(const RenderRect& rect, const RenderColor& color) override;
+    void PushClip(const RenderRect& rect) override;
+    void PopClip() override;
+
+private:
+    ID2D1SolidColorBrush* Brush(const RenderColor& color);
+
+    ID2D1RenderTarget* m_target;
+    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_brush;
+};
+}
@@ -3,51 +3,128 @@
 #include <d2d1helper.h>
 #include <dwrite.h>
 
+#include "Diagnostics/AllocationCounter.h"
+#include "Diagnostics/TraceRecorder.h"
+#include "Rendering/Direct2DRenderBackend.h"
+#include "Rendering/LayeredWindowPresenter.h"
+#include "Rendering/RadarFrame.h"
+#include "Rendering/RadarPainter.h"
+#include "Rendering/SoftwareRenderBackend.h"
 #include "Util/ComException.h"
 
 #include <algorithm>
+#include <array>
 #include <cwchar>
 #include <cmath>
+#include <iterator>
+#include <utility>
 
 using namespace Rendering;
 
 namespace
 {
 constexpr float kPi = 3.14159265358979323846f;
+constexpr float kLabelInset = 12.0f;
+constexpr float kLabelTop = 6.0f;
+constexpr float kLabelBottom = 30.0f;
+constexpr auto kDiagnosticsInterval = std::chrono::milliseconds(500);
+constexpr auto kTimingWindow = std::chrono::seconds(5);
+
+// Marker atlas layout: one row per shape, one column per pre-rasterized size
+constexpr float kMarkerRadii[] = { 4.0f, 5.0f, 6.0f, 8.0f };
+constexpr size_t kMarkerCellSize = 24;
+constexpr size_t kMarkerShapeCount = 3;
+static_assert(kMarkerRadii[std::size(kMarkerRadii) - 1] == kMaxHitMarkerRadius,
+              "the largest atlas cell must fit the largest marker");
+
+size_t MarkerShapeIndex(RadarPattern pattern)
+{
+    switch (pattern)
+    {
+    case RadarPattern::Strong:
+        return 0;
+    case RadarPattern::Medium:
+        return 1;
+    case RadarPattern::Weak:
+    case RadarPattern::Unknown:
+    default:
+        return 2;
+    }
+}
 
-// Very lightweight pattern style presets. These are not
-// semantic labels like "footstep"/"gunshot", but give
-// different distance emphasis per rough pattern bucket.
-struct PatternStyle
+D2D1_RECT_F TextRect(D2D1_POINT_2F center, float radius)
 {
-    RadarPattern id;
-    float distanceScale; // Multiplier on top of global distanceScale
-};
+    return D2D1::RectF(center.x - radius, center.y + radius * 0.25f, center.x + radius, center.y + radius);
+}
 
-constexpr PatternStyle kPatternStyles[] = {
-    { RadarPattern::Strong, 0.7f }, // Strong impulse: emphasize closer distance
-    { RadarPattern::Medium, 1.0f }, // Rhythmic / burst: neutral
-    { RadarPattern::Weak,   1.2f }, // Soft / residual: slightly farther
-    { RadarPattern::Unknown, 1.0f },
-};
+bool Contains(const D2D1_RECT_F& outer, const D2D1_RECT_F& inner)
+{
+    return outer.left <= inner.left && outer.top <= inner.top &&
+           outer.right >= inner.right && outer.bottom >= inner.bottom;
+}
 
-float DistanceScaleForPattern(RadarPattern pattern)
+// The few rectangles that changed this frame. A rectangle already covered by
+// a recorded one is dropped; overflow is folded into the last slot.
+class DirtyRegions
 {
-    for (const auto& p : kPatternStyles)
+public:
+    void Add(const D2D1_RECT_F& rect) noexcept
     {
-        if (p.id == pattern)
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            if (Contains(m_rects[i], rect))
+            {
+                return;
+            }
+            if (Contains(rect, m_rects[i]))
+            {
+                m_rects[i] = rect;
+                return;
+            }
+        }
+
+        if (m_count < m_rects.size())
         {
-            return p.distanceScale;
+            m_rects[m_count++] = rect;
+            return;
         }
+
+        auto& last = m_rects[m_count - 1];
+        last = D2D1::RectF(std::min(last.left, rect.left),
+                           std::min(last.top, rect.top),
+                           std::max(last.right, rect.right),
+                           std::max(last.bottom, rect.bottom));
     }
-    return 1.0f;
-}
+
+    [[nodiscard]] bool Empty() const noexcept { return m_count == 0; }
+    [[nodiscard]] size_t Count() const noexcept { return m_count; }
+    [[nodiscard]] const D2D1_RECT_F* Data() const noexcept { return m_rects.data(); }
+    const D2D1_RECT_F& operator[](size_t index) const noexcept { return m_rects[index]; }
+
+private:
+    std::array<D2D1_RECT_F, 4> m_rects{};
+    size_t m_count{0};
+};
 } // anonymous namespace
 
 DirectionVisualizer::DirectionVisualizer(std::shared_ptr<Config::ConfigManager> config)
     : m_config(std::move(config))
     , m_sensitivity(m_config->Sensitivity())
+    , m_pendingTheme(m_config->Theme())
+    , m_droppedHits(Diagnostics::MetricsRegistry::Instance().GetCounter("render.dropped_hits"))
+    , m_framesRendered(Diagnostics::MetricsRegistry::Instance().GetCounter("render.frames"))
+    , m_framesSkipped(Diagnostics::MetricsRegistry::Instance().GetCounter("render.frames_skipped"))
+    , m_framesPartial(Diagnostics::MetricsRegistry::Instance().GetCounter("render.frames_partial"))
+    , m_hitQueueDepth(Diagnostics::MetricsRegistry::Instance().GetGauge("render.hit_queue"))
+    , m_cpuTime(Diagnostics::MetricsRegistry::Instance().GetHistogram("render.cpu"))
+    , m_presentInterval(Diagnostics::MetricsRegistry::Instance().GetHistogram("render.present_interval"))
+    , m_displayLatency(Diagnostics::MetricsRegistry::Instance().GetHistogram("render.display_latency"))
+    , m_theme(m_config->Theme())
 {
+    m_mutex.ReportWaitsTo(&Diagnostics::MetricsRegistry::Instance().GetHistogram("lock.visualizer_state"));
+    m_distanceScale.store(std::clamp(m_sensitivity.distanceScale, 0.5f, 2.0f), std::memory_order_relaxed);
+    SetDisplay(m_config->Display());
+
     D2D1_FACTORY_OPTIONS options{};
     THROW_IF_FAILED(D2D1CreateFactory(
         D2D1_FACTORY_TYPE_MULTI_THREADED,
@@ -65,311 +142,991 @@ DirectionVisualizer::~DirectionVisualizer() = default;
 
 void DirectionVisualizer::Initialize(HWND hwnd)
 {
-    CreateDeviceResources(hwnd);
+    m_hwnd.store(hwnd, std::memory_order_relaxed);
+    m_deviceRequested.store(true, std::memory_order_release);
 }
 
 void DirectionVisualizer::Resize(UINT width, UINT height)
+{
+    const uint64_t packed = kResizePending |
+                            (static_cast<uint64_t>(width & 0x7FFFFFFF) << 32) |
+                            static_cast<uint64_t>(height);
+    m_pendingSize.store(packed, std::memory_order_release);
+}
+
+void DirectionVisualizer::ApplyPendingRequests()
+{
+    // Only the latest size matters, so resizes coalesce into one slot
+    const uint64_t size = m_pendingSize.exchange(0, std::memory_order_acq_rel);
+    if (size & kResizePending)
+    {
+        ApplyResize(static_cast<UINT>((size >> 32) & 0x7FFFFFFF), static_cast<UINT>(size & 0xFFFFFFFF));
+    }
+
+    bool themeChanged = false;
+    if (m_themeDirty.exchange(false, std::memory_order_acq_rel))
+    {
+        std::scoped_lock lock{m_mutex};
+        m_theme = m_pendingTheme;
+        themeChanged = true;
+    }
+
+    if (m_deviceRequested.exchange(false, std::memory_order_acq_rel))
+    {
+        // Device creation builds every theme-dependent resource as well
+        ReleaseDeviceResources();
+        CreateDeviceResources(m_hwnd.load(std::memory_order_relaxed));
+    }
+    else if (themeChanged && m_renderTarget)
+    {
+        ApplyWindowLayering(m_hwnd.load(std::memory_order_relaxed));
+        CreateBrushes();
+        RebuildStaticLayer();
+        RebuildMarkerAtlas();
+        RebuildHeatmap();
+        RebuildWaterfall();
+        m_fullRedraw = true;
+    }
+
+    if (m_invalidateRequested.exchange(false, std::memory_order_acq_rel))
+    {
+        m_fullRedraw = true;
+    }
+}
+
+void DirectionVisualizer::ApplyResize(UINT width, UINT height)
 {
     m_width = width;
     m_height = height;
+    m_fullRedraw = true;
+    UpdateGeometry();
+
+    if (m_presenter)
+    {
+        m_presenter->Resize(width, height);
+        m_software->Resize(width, height);
+    }
 
     if (m_renderTarget)
     {
-        m_renderTarget->Resize(D2D1::SizeU(width, height));
+        if (m_hwndTarget)
+        {
+            m_hwndTarget->Resize(D2D1::SizeU(width, height));
+        }
+        RebuildStaticLayer();
+        RebuildLabelLayout();
+        RebuildSessionLayout();
     }
 }
 
 void DirectionVisualizer::Render()
 {
+    TRACE_SCOPE("render.frame");
+    ALLOCATION_PROBE("alloc.render_frame");
+    const auto frameStart = std::chrono::steady_clock::now();
+
+    ApplyPendingRequests();
     if (!m_renderTarget)
     {
         return;
     }
+    RotateTimingWindow(frameStart);
+
+    // Pick up whatever the producer published since the last frame. Both
+    // hand-offs are lock-free, so the router thread never waits on the
+    // Direct2D work below and vice versa.
+    const bool newSnapshot = m_snapshots.Acquire();
+    DrainPendingHits();
+    const FrameSnapshot& frame = m_snapshots.Front();
+
+    const bool visible = m_visible.load(std::memory_order_acquire);
+    if (visible != m_drawnVisible)
+    {
+        m_drawnVisible = visible;
+        m_fullRedraw = true;
+    }
 
-    auto state = CurrentState();
-    if (!state.visible)
+    if (!visible)
     {
-        m_renderTarget->BeginDraw();
-        m_renderTarget->Clear(D2D1::ColorF(0, 0));
-        m_renderTarget->EndDraw();
+        // Clear once on the transition, then stay idle while hidden. A
+        // hidden layered window keeps its last surface, so there is
+        // nothing to clear with per-pixel alpha.
+        if (m_fullRedraw && !m_presenter)
+        {
+            m_renderTarget->BeginDraw();
+            m_renderTarget->Clear(D2D1::ColorF(0, 0));
+            m_renderTarget->EndDraw();
+            m_fullRedraw = false;
+            m_framesRendered.Add();
+        }
+        else
+        {
+            m_framesSkipped.Add();
+        }
+        m_presentedLastFrame = false;
         return;
     }
 
-    m_renderTarget->BeginDraw();
-    m_renderTarget->Clear(D2D1::ColorF(0.05f, 0.05f, 0.07f, m_config->Theme().opacity * 0.85f));
+    const auto now = std::chrono::steady_clock::now();
+
+    // --- Dirty tracking ---
+    const auto center = m_center;
+    const float radius = m_radius;
+
+    DirtyRegions dirty;
 
-    if (!state.modeLabel.empty())
+    if (newSnapshot && frame.modeLabel != m_drawnLabel)
     {
-        D2D1_RECT_F modeRect{ 12.0f, 6.0f, static_cast<FLOAT>(m_width) - 12.0f, 30.0f };
-        m_renderTarget->DrawTextW(state.modeLabel.c_str(),
-                                  static_cast<UINT32>(state.modeLabel.size()),
-                                  m_textFormat.Get(),
-                                  modeRect,
-                                  m_accentBrush ? m_accentBrush.Get() : m_primaryBrush.Get());
+        m_drawnLabel = frame.modeLabel;
+        RebuildLabelLayout();
+        dirty.Add(D2D1::RectF(0.0f, 0.0f, static_cast<float>(m_width), kLabelBottom));
     }
 
-    const auto center = D2D1::Point2F(static_cast<float>(m_width) / 2.0f, static_cast<float>(m_height) / 2.0f);
-    const float radius = std::min(m_width, m_height) * 0.45f;
+    if (m_scene.SetMode(m_visualization.load(std::memory_order_relaxed)))
+    {
+        m_fullRedraw = true;
+    }
+    const bool heatmapMode = m_scene.Mode() == Config::VisualizationMode::Heatmap;
+    const bool waterfallMode = m_scene.Mode() == Config::VisualizationMode::Waterfall;
 
-    // Crosshair
-    m_renderTarget->DrawLine(D2D1::Point2F(center.x, center.y - radius),
-                             D2D1::Point2F(center.x, center.y + radius),
-                             m_backgroundBrush.Get(), 1.0f);
-    m_renderTarget->DrawLine(D2D1::Point2F(center.x - radius, center.y),
-                             D2D1::Point2F(center.x + radius, center.y),
-                             m_backgroundBrush.Get(), 1.0f);
+    const RadarSceneUpdate radar = m_scene.Advance(now);
+    const bool hasHits = !m_scene.Hits().Empty();
+    if (radar.dirty)
+    {
+        dirty.Add(D2D1::RectF(center.x - radius - kRadarMarkerPadding,
+                              center.y - radius - kRadarMarkerPadding,
+                              center.x + radius + kRadarMarkerPadding,
+                              center.y + radius + kRadarMarkerPadding));
+    }
 
-    // Outer ring
-    m_renderTarget->DrawEllipse(D2D1::Ellipse(center, radius, radius),
-                                m_accentBrush ? m_accentBrush.Get() : m_backgroundBrush.Get(),
-                                2.5f);
+    // Text uses latest hit direction if available, otherwise current state
+    float textAzimuth = frame.direction.azimuth;
+    float textElevation = frame.direction.elevation;
+    if (hasHits && frame.hasLastHit)
+    {
+        textAzimuth = frame.lastHitAzimuth;
+        textElevation = frame.lastHitElevation;
+    }
 
-    // Draw all radar hits with individual fade-out
-    const auto now = std::chrono::steady_clock::now();
-    constexpr float trailSeconds = 1.5f;
+    const int azimuthDeg = static_cast<int>(std::lround(textAzimuth * 180.0f / kPi));
+    const int elevationDeg = static_cast<int>(std::lround(textElevation * 180.0f / kPi));
+    if (azimuthDeg != m_drawnAzimuthDeg || elevationDeg != m_drawnElevationDeg)
+    {
+        // Numbers are composed from the digit atlas; nothing to re-shape
+        m_drawnAzimuthDeg = azimuthDeg;
+        m_drawnElevationDeg = elevationDeg;
+        dirty.Add(TextRect(center, radius));
+    }
+    if (frame.direction.dominantSessionName != m_drawnSessionName)
+    {
+        m_drawnSessionName = frame.direction.dominantSessionName;
+        RebuildSessionLayout();
+        dirty.Add(TextRect(center, radius));
+    }
 
-    float baseOpacity = m_primaryBrush->GetOpacity();
+    const bool showDiagnostics = m_showDiagnostics.load(std::memory_order_relaxed);
+    if (showDiagnostics != m_drawnDiagnostics)
+    {
+        m_drawnDiagnostics = showDiagnostics;
+        m_fullRedraw = true;
+    }
+    if (showDiagnostics && now - m_lastDiagnosticsUpdate >= kDiagnosticsInterval)
+    {
+        m_lastDiagnosticsUpdate = now;
+        const auto stats = Stats();
+        const auto timing = Timing();
+        swprintf_s(m_diagnosticsText,
+                   L"frames %llu drawn / %llu skipped  text %.1f us\n"
+                   L"cpu p50 %lld / p99 %lld us  interval p50 %.1f / p99 %.1f ms\n"
+                   L"latency p50 %.1f / p99 %.1f ms  prediction %s",
+                   static_cast<unsigned long long>(stats.rendered),
+                   static_cast<unsigned long long>(stats.skipped),
+                   stats.textMicros,
+                   static_cast<long long>(timing.cpuP50.count()),
+                   static_cast<long long>(timing.cpuP99.count()),
+                   timing.intervalP50.count() / 1000.0,
+                   timing.intervalP99.count() / 1000.0,
+                   timing.latencyP50.count() / 1000.0,
+                   timing.latencyP99.count() / 1000.0,
+                   m_predictMotion.load(std::memory_order_relaxed) ? L"on" : L"off");
+        dirty.Add(DiagnosticsRect());
+    }
 
+    if (!m_fullRedraw && dirty.Empty())
     {
-        std::scoped_lock lock{m_mutex};
+        m_framesSkipped.Add();
+        m_presentedLastFrame = false;
+        return;
+    }
 
-        // Remove expired hits
-        m_hits.erase(std::remove_if(m_hits.begin(), m_hits.end(),
-                       [&](const RadarHit& hit)
-                       {
-                           float age = std::chrono::duration<float>(now - hit.time).count();
-                           return age >= trailSeconds;
-                       }),
-                     m_hits.end());
+    m_frameTextCost = {};
 
-        for (const auto& hit : m_hits)
+    if (m_presenter)
+    {
+        const D2D1_RECT_F full = D2D1::RectF(0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height));
+        if (m_fullRedraw)
         {
-            float age = std::chrono::duration<float>(now - hit.time).count();
-            if (age < 0.0f || age >= trailSeconds)
+            PresentLayered(&full, 1);
+        }
+        else
+        {
+            PresentLayered(dirty.Data(), dirty.Count());
+            m_framesPartial.Add();
+        }
+    }
+    else
+    {
+        if (heatmapMode)
+        {
+            if (radar.dirty || m_fullRedraw)
             {
-                continue;
+                UploadHeatmap();
             }
-
-            float fade = 1.0f - (age / trailSeconds);
-
-            // Apply detection range scale (distanceScale): 0.5~2.0
-            float scale = m_sensitivity.distanceScale;
-            if (scale < 0.5f) scale = 0.5f;
-            if (scale > 2.0f) scale = 2.0f;
-
-            // Pattern-specific distance emphasis
-            const float patternScale = DistanceScaleForPattern(hit.pattern);
-            const float r = radius * std::clamp(hit.radiusFactor * scale * patternScale, 0.05f, 1.0f);
-            const float azimuth = hit.direction.azimuth;
-            const float elevation = hit.direction.elevation;
-
-            const float x = std::sin(azimuth) * std::cos(elevation);
-            const float z = std::cos(azimuth) * std::cos(elevation);
-
-            const D2D1_POINT_2F p{
-                center.x + r * x,
-                center.y - r * z,
-            };
-
-            const float dotRadius = 4.0f + 2.0f * hit.direction.magnitude;
-
-            // Choose brush per pattern (fixed colors)
-            ID2D1SolidColorBrush* brush = nullptr;
-            switch (hit.pattern)
+        }
+        else if (waterfallMode)
+        {
+            // A full redraw may follow Clear(); otherwise only new columns
+            if (m_fullRedraw)
             {
-            case RadarPattern::Strong:
-                brush = m_strongBrush ? m_strongBrush.Get() : (m_accentBrush ? m_accentBrush.Get() : m_primaryBrush.Get());
-                break;
-            case RadarPattern::Medium:
-                brush = m_mediumBrush ? m_mediumBrush.Get() : m_primaryBrush.Get();
-                break;
-            case RadarPattern::Weak:
-            case RadarPattern::Unknown:
-                brush = m_weakBrush ? m_weakBrush.Get() : (m_backgroundBrush ? m_backgroundBrush.Get() : m_primaryBrush.Get());
-                break;
+                UploadWaterfall(WaterfallStrip::kColumns);
             }
-            if (!brush)
+            else if (radar.dirty)
             {
-                brush = m_primaryBrush.Get();
+                UploadWaterfall(radar.waterfallColumns);
             }
+        }
+        else
+        {
+            PrepareMarkers();
+        }
 
-            brush->SetOpacity(baseOpacity * fade);
+        m_renderTarget->BeginDraw();
 
-            switch (hit.pattern)
+        if (m_fullRedraw)
+        {
+            DrawScene();
+        }
+        else
+        {
+            // The target retains its contents between frames, so only the
+            // dirty rectangles need to be cleared and redrawn.
+            for (size_t i = 0; i < dirty.Count(); ++i)
             {
-            case RadarPattern::Strong:
-                // Red filled circle
-                m_renderTarget->FillEllipse(D2D1::Ellipse(p, dotRadius, dotRadius), brush);
-                break;
-            case RadarPattern::Medium:
-                // Blue square
-                m_renderTarget->FillRectangle(
-                    D2D1::RectF(p.x - dotRadius,
-                                p.y - dotRadius,
-                                p.x + dotRadius,
-                                p.y + dotRadius),
-                    brush);
-                break;
-            case RadarPattern::Weak:
-            default:
-                // Green triangle
-                m_renderTarget->DrawLine(
-                    D2D1::Point2F(p.x, p.y - dotRadius),
-                    D2D1::Point2F(p.x - dotRadius, p.y + dotRadius),
-                    brush, 2.0f);
-                m_renderTarget->DrawLine(
-                    D2D1::Point2F(p.x - dotRadius, p.y + dotRadius),
-                    D2D1::Point2F(p.x + dotRadius, p.y + dotRadius),
-                    brush, 2.0f);
-                m_renderTarget->DrawLine(
-                    D2D1::Point2F(p.x + dotRadius, p.y + dotRadius),
-                    D2D1::Point2F(p.x, p.y - dotRadius),
-                    brush, 2.0f);
-                break;
+                m_renderTarget->PushAxisAlignedClip(dirty[i], D2D1_ANTIALIAS_MODE_ALIASED);
+                DrawScene();
+                m_renderTarget->PopAxisAlignedClip();
             }
+            m_framesPartial.Add();
         }
+
+        m_renderTarget->EndDraw();
     }
 
-    if (m_primaryBrush)
+    // Exponential moving average of the per-frame text cost
+    const float textMicros = std::chrono::duration<float, std::micro>(m_frameTextCost).count();
+    const float previous = m_textMicros.load(std::memory_order_relaxed);
+    m_textMicros.store(previous * 0.9f + textMicros * 0.1f, std::memory_order_relaxed);
+
+    m_fullRedraw = false;
+    m_framesRendered.Add();
+
+    // Intervals only mean something between back-to-back presents; an idle
+    // gap after a skipped frame is not a pacing glitch.
+    const auto frameEnd = std::chrono::steady_clock::now();
+    m_windowCpuTime.Record(frameEnd - frameStart);
+    if (m_presentedLastFrame)
     {
-        m_primaryBrush->SetOpacity(baseOpacity);
+        m_windowPresentInterval.Record(frameEnd - m_lastPresent);
     }
+    m_lastPresent = frameEnd;
+    m_presentedLastFrame = true;
 
-    // Text uses latest hit direction if available, otherwise current state
-    Audio::AudioDirection textDir{};
+    m_renderCost += (frameEnd - frameStart - m_renderCost) / 8;
+    if (m_newestCapture != std::chrono::steady_clock::time_point{})
     {
-        std::scoped_lock lock{m_mutex};
-        if (!m_hits.empty())
-        {
-            textDir = m_hits.back().direction;
-        }
-        else
+        m_windowDisplayLatency.Record(frameEnd - m_newestCapture);
+    }
+}
+
+void DirectionVisualizer::RotateTimingWindow(std::chrono::steady_clock::time_point now)
+{
+    if (now - m_timingWindowStart < kTimingWindow)
+    {
+        return;
+    }
+    m_timingWindowStart = now;
+
+    // A window without samples (idle, or every frame skipped) keeps the
+    // previous one on display
+    const std::pair<Util::LatencyHistogram*, Util::LatencyHistogram*> windows[] = {
+        {&m_windowCpuTime, &m_cpuTime},
+        {&m_windowPresentInterval, &m_presentInterval},
+        {&m_windowDisplayLatency, &m_displayLatency},
+    };
+    for (const auto& [window, published] : windows)
+    {
+        if (window->Count() > 0)
         {
-            textDir = m_state.direction;
+            published->CopyFrom(*window);
+            window->Reset();
         }
     }
+}
 
-    wchar_t buffer[128];
-    const wchar_t* name = textDir.dominantSessionName.empty() ? L"" : textDir.dominantSessionName.c_str();
-    swprintf_s(buffer, L"Az(horiz) %.0f deg\nEl(vert) %.0f deg\n%ls",
-               textDir.azimuth * 180.0f / kPi,
-               textDir.elevation * 180.0f / kPi,
-               name);
+void DirectionVisualizer::DrawScene()
+{
+    // Background, crosshair and ring come from the cached static layer
+    if (m_staticLayer)
+    {
+        m_renderTarget->Clear(D2D1::ColorF(0, 0));
+        m_renderTarget->DrawBitmap(m_staticLayer.Get(), nullptr, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+    }
+    else
+    {
+        DrawStaticLayer(m_renderTarget.Get());
+    }
 
-    D2D1_RECT_F textRect{ center.x - radius, center.y + radius * 0.25f, center.x + radius, center.y + radius };
-    m_renderTarget->DrawTextW(buffer,
-                              static_cast<UINT32>(wcslen(buffer)),
-                              m_textFormat.Get(),
-                              textRect,
-                              m_primaryBrush.Get());
+    // All live hits in a single batched draw, or the heatmap/waterfall as bitmaps
+    if (m_scene.Mode() == Config::VisualizationMode::Heatmap)
+    {
+        DrawHeatmap();
+    }
+    else if (m_scene.Mode() == Config::VisualizationMode::Waterfall)
+    {
+        DrawWaterfall();
+    }
+    else
+    {
+        DrawMarkers();
+    }
 
-    m_renderTarget->EndDraw();
+    DrawOverlayText();
 }
 
-void DirectionVisualizer::UpdateDirection(const Audio::AudioDirection& direction)
+void DirectionVisualizer::DrawOverlayText()
 {
-    std::scoped_lock lock{m_mutex};
-    m_state.direction = direction;
+    const auto textStart = std::chrono::steady_clock::now();
+    if (m_labelLayout)
+    {
+        m_renderTarget->DrawTextLayout(D2D1::Point2F(kLabelInset, kLabelTop),
+                                       m_labelLayout.Get(),
+                                       m_accentBrush ? m_accentBrush.Get() : m_primaryBrush.Get());
+    }
+    m_frameTextCost += std::chrono::steady_clock::now() - textStart;
+
+    DrawReadout();
+
+    if (m_drawnDiagnostics)
+    {
+        m_renderTarget->DrawTextW(m_diagnosticsText,
+                                  static_cast<UINT32>(wcslen(m_diagnosticsText)),
+                                  m_diagnosticsFormat.Get(),
+                                  DiagnosticsRect(),
+                                  m_accentBrush ? m_accentBrush.Get() : m_primaryBrush.Get());
+    }
+}
 
-    // Record non-background, strong enough hits for radar trail
-    if (!direction.isBackground && direction.magnitude > 0.15f)
+void DirectionVisualizer::PresentLayered(const D2D1_RECT_F* regions, size_t count)
+{
+    RadarFrame radar;
+    radar.style = StyleFromConfig();
+    radar.center = { m_center.x, m_center.y };
+    radar.radius = m_radius;
+    radar.distanceScale = m_distanceScale.load(std::memory_order_relaxed);
+    radar.background = m_softwareStaticLayer.get();
+    m_scene.Fill(radar);
+
+    // Geometry goes through the SIMD software rasterizer, clipped to each
+    // dirty rectangle; only their union is copied and recomposed.
+    RECT bounds{ static_cast<LONG>(m_width), static_cast<LONG>(m_height), 0, 0 };
+    for (size_t i = 0; i < count; ++i)
     {
-        const auto now = std::chrono::steady_clock::now();
+        const D2D1_RECT_F& region = regions[i];
+        PaintRadarFrame(*m_software, radar, { region.left, region.top, region.right, region.bottom });
+
+        bounds.left = std::min(bounds.left, static_cast<LONG>(std::floor(region.left)));
+        bounds.top = std::min(bounds.top, static_cast<LONG>(std::floor(region.top)));
+        bounds.right = std::max(bounds.right, static_cast<LONG>(std::ceil(region.right)));
+        bounds.bottom = std::max(bounds.bottom, static_cast<LONG>(std::ceil(region.bottom)));
+    }
+    m_presenter->Upload(m_software->Pixels(), bounds);
 
-        // Update reference magnitude for relative near/far feeling
-        if (m_referenceMagnitude <= 0.0f)
+    // Text is drawn by Direct2D straight onto the presenter's surface
+    const RECT surface{ 0, 0, static_cast<LONG>(m_width), static_cast<LONG>(m_height) };
+    if (SUCCEEDED(m_dcTarget->BindDC(m_presenter->DC(), &surface)))
+    {
+        m_dcTarget->BeginDraw();
+        for (size_t i = 0; i < count; ++i)
         {
-            m_referenceMagnitude = direction.magnitude;
+            m_dcTarget->PushAxisAlignedClip(regions[i], D2D1_ANTIALIAS_MODE_ALIASED);
+            DrawOverlayText();
+            m_dcTarget->PopAxisAlignedClip();
         }
-        else
+        m_dcTarget->EndDraw();
+    }
+
+    m_presenter->Present(bounds);
+}
+
+void DirectionVisualizer::PrepareMarkers()
+{
+    m_markerCount = 0;
+    const RadarHitBuffer& hits = m_scene.Hits();
+
+    // Detection range scale (distanceScale): clamped to 0.5~2.0 on store
+    const float scale = m_distanceScale.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < hits.Size(); ++i)
+    {
+        // Negative for expired and merged-away hits
+        const float fade = hits.Fade(i);
+        if (fade < 0.0f)
         {
-            // Exponential moving average
-            m_referenceMagnitude = 0.7f * m_referenceMagnitude + 0.3f * direction.magnitude;
+            continue;
         }
 
-        float ref = (m_referenceMagnitude > 0.001f) ? m_referenceMagnitude : direction.magnitude;
-        float relative = (ref > 0.001f) ? (direction.magnitude / ref) : 1.0f;
-        relative = std::clamp(relative, 0.0f, 2.0f);
+        const RadarPattern pattern = hits.Pattern(i);
+        const float r = m_radius * HitRadiusFraction(hits.Radial(i), scale);
 
-        // Non-linear mapping: emphasize contrast between near and far
-        // relative ~= 0   -> very far  (outer ring)
-        // relative ~= 1   -> baseline
-        // relative >~ 1.5 -> very close (tight to center)
-        float loudNorm = std::clamp(relative / 1.5f, 0.0f, 1.0f); // 0..1
-        float quietNorm = 1.0f - loudNorm;                        // 0 near, 1 far
+        // Screen-space unit vector was computed once at insert time
+        const D2D1_POINT_2F p{
+            m_center.x + r * hits.X(i),
+            m_center.y - r * hits.Z(i),
+        };
 
-        const float minRadius = 0.12f;
-        const float maxRadius = 1.0f;
-        float radiusFactor = minRadius + (maxRadius - minRadius) * (quietNorm * quietNorm);
-        radiusFactor = std::clamp(radiusFactor, minRadius, maxRadius);
+        const float dotRadius = HitMarkerRadius(hits.Magnitude(i));
 
-        // --- Pattern classification (heuristic only, configurable via SensitivityConfig) ---
-        RadarPattern pattern = RadarPattern::Weak;
+        // Nearest pre-rasterized size; the destination is scaled to the exact radius
+        size_t sizeIndex = 0;
+        for (size_t s = 1; s < std::size(kMarkerRadii); ++s)
+        {
+            if (std::fabs(kMarkerRadii[s] - dotRadius) < std::fabs(kMarkerRadii[sizeIndex] - dotRadius))
+            {
+                sizeIndex = s;
+            }
+        }
 
-        const auto sensitivity = m_sensitivity;
+        const size_t shape = MarkerShapeIndex(pattern);
+        const float cellRadius = kMarkerRadii[sizeIndex];
+        const float extent = (cellRadius + kHitMarkerStrokePad) * (dotRadius / cellRadius);
+        const UINT32 cellX = static_cast<UINT32>(sizeIndex * kMarkerCellSize + kMarkerCellSize / 2);
+        const UINT32 cellY = static_cast<UINT32>(shape * kMarkerCellSize + kMarkerCellSize / 2);
+        const UINT32 sourceExtent = static_cast<UINT32>(std::ceil(cellRadius + kHitMarkerStrokePad));
+
+        const size_t index = m_markerCount++;
+        m_markerDest[index] = D2D1::RectF(p.x - extent, p.y - extent, p.x + extent, p.y + extent);
+        m_markerSource[index] = D2D1::RectU(cellX - sourceExtent, cellY - sourceExtent, cellX + sourceExtent, cellY + sourceExtent);
+        // The atlas holds the pattern colors; per-instance color only fades alpha
+        m_markerColor[index] = D2D1::ColorF(1.0f, 1.0f, 1.0f, fade);
+    }
 
-        // 1) Strong, sharp impulse: sudden rise vs previous magnitude
-        const float magnitudeJump = direction.magnitude - m_lastMagnitude;
-        if (direction.magnitude > sensitivity.strongMagnitude && magnitudeJump > sensitivity.strongJump)
+    if (m_spriteBatch)
+    {
+        m_spriteBatch->Clear();
+        if (m_markerCount > 0)
         {
-            pattern = RadarPattern::Strong;
+            m_spriteBatch->AddSprites(static_cast<UINT32>(m_markerCount),
+                                      m_markerDest.data(),
+                                      m_markerSource.data(),
+                                      m_markerColor.data(),
+                                      nullptr,
+                                      sizeof(D2D1_RECT_F),
+                                      sizeof(D2D1_RECT_U),
+                                      sizeof(D2D1_COLOR_F),
+                                      0);
         }
-        else
+    }
+}
+
+void DirectionVisualizer::DrawMarkers()
+{
+    if (m_markerCount == 0 || !m_markerAtlas)
+    {
+        return;
+    }
+
+    if (m_spriteBatch)
+    {
+        // One draw call for every live hit; sprite batches require aliased mode
+        const auto previousMode = m_deviceContext->GetAntialiasMode();
+        m_deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+        m_deviceContext->DrawSpriteBatch(m_spriteBatch.Get(),
+                                         m_markerAtlas.Get(),
+                                         D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
+                                         D2D1_SPRITE_OPTIONS_NONE);
+        m_deviceContext->SetAntialiasMode(previousMode);
+        return;
+    }
+
+    // Pre-Creators-Update fallback: still one bitmap blit per hit and no
+    // shared brush state, with the fade applied as bitmap opacity.
+    for (size_t i = 0; i < m_markerCount; ++i)
+    {
+        const auto& source = m_markerSource[i];
+        const D2D1_RECT_F sourceRect = D2D1::RectF(static_cast<float>(source.left),
+                                                   static_cast<float>(source.top),
+                                                   static_cast<float>(source.right),
+                                                   static_cast<float>(source.bottom));
+        m_renderTarget->DrawBitmap(m_markerAtlas.Get(),
+                                   m_markerDest[i],
+                                   m_markerColor[i].a,
+                                   D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
+                                   sourceRect);
+    }
+}
+
+void DirectionVisualizer::RebuildMarkerAtlas()
+{
+    m_markerAtlas.Reset();
+    if (!m_renderTarget || m_presenter)
+    {
+        // The layered presenter rasterizes markers in software
+        return;
+    }
+
+    // Rows: Strong (circle), Medium (square), Weak (triangle outline).
+    // Columns: one cell per entry in kMarkerRadii.
+    const float width = static_cast<float>(std::size(kMarkerRadii) * kMarkerCellSize);
+    const float height = static_cast<float>(kMarkerShapeCount * kMarkerCellSize);
+
+    Microsoft::WRL::ComPtr<ID2D1BitmapRenderTarget> atlasTarget;
+    THROW_IF_FAILED(m_renderTarget->CreateCompatibleRenderTarget(D2D1::SizeF(width, height), &atlasTarget));
+
+    atlasTarget->BeginDraw();
+    atlasTarget->Clear(D2D1::ColorF(0, 0));
+
+    const RadarStyle style = StyleFromConfig();
+    Direct2DRenderBackend backend(atlasTarget.Get());
+    for (size_t s = 0; s < std::size(kMarkerRadii); ++s)
+    {
+        const float cx = static_cast<float>(s * kMarkerCellSize) + kMarkerCellSize / 2.0f;
+        for (const auto pattern : { RadarPattern::Strong, RadarPattern::Medium, RadarPattern::Weak })
         {
-            // 2) Rhythmic / burst-like: recent hit in similar direction within ~0.3–0.7s
-            const float minInterval = sensitivity.rhythmMinInterval;
-            const float maxInterval = sensitivity.rhythmMaxInterval;
-            const float maxDirectionDelta = sensitivity.rhythmDirectionDeg * kPi / 180.0f;
+            const float cy = static_cast<float>(MarkerShapeIndex(pattern) * kMarkerCellSize) + kMarkerCellSize / 2.0f;
+            PaintRadarMarker(backend, pattern, { cx, cy }, kMarkerRadii[s], PatternColor(style, pattern));
+        }
+    }
 
-            if (!m_hits.empty())
-            {
-                const RadarHit& last = m_hits.back();
-                const float dt = std::chrono::duration<float>(now - last.time).count();
-                if (dt >= minInterval && dt <= maxInterval)
-                {
-                    const float dazimuth = std::fabs(direction.azimuth - last.direction.azimuth);
-                    const float delev = std::fabs(direction.elevation - last.direction.elevation);
-                    if (dazimuth < maxDirectionDelta && delev < maxDirectionDelta)
-                    {
-                        pattern = RadarPattern::Medium;
-                    }
-                }
-            }
+    THROW_IF_FAILED(atlasTarget->EndDraw());
+    THROW_IF_FAILED(atlasTarget->GetBitmap(&m_markerAtlas));
+}
+
+void DirectionVisualizer::RebuildHeatmap()
+{
+    const auto color = m_theme.primaryColor;
+    m_scene.Heatmap().SetPalette(GetRValue(color), GetGValue(color), GetBValue(color), m_theme.opacity);
+
+    if (m_heatmapBitmap || !m_renderTarget || m_presenter)
+    {
+        return;
+    }
+
+    // Fixed-size texture refreshed with CopyFromMemory; on failure the
+    // heatmap mode simply draws nothing over the static layer.
+    const auto props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+    if (FAILED(m_renderTarget->CreateBitmap(D2D1::SizeU(static_cast<UINT32>(PolarHeatmap::kTextureSize),
+                                                        static_cast<UINT32>(PolarHeatmap::kTextureSize)),
+                                            nullptr,
+                                            0,
+                                            props,
+                                            &m_heatmapBitmap)))
+    {
+        m_heatmapBitmap.Reset();
+    }
+}
+
+void DirectionVisualizer::RebuildWaterfall()
+{
+    const auto color = m_theme.primaryColor;
+    m_scene.Waterfall().SetPalette(GetRValue(color), GetGValue(color), GetBValue(color), m_theme.opacity);
+
+    if (m_waterfallBitmap || !m_renderTarget || m_presenter)
+    {
+        return;
+    }
+
+    // Created with the current history; afterwards only new columns are copied
+    const auto props = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+    if (FAILED(m_renderTarget->CreateBitmap(D2D1::SizeU(static_cast<UINT32>(WaterfallStrip::kColumns),
+                                                        static_cast<UINT32>(WaterfallStrip::kAzimuthBins)),
+                                            m_scene.Waterfall().Pixels(),
+                                            static_cast<UINT32>(WaterfallStrip::kColumns * sizeof(uint32_t)),
+                                            props,
+                                            &m_waterfallBitmap)))
+    {
+        m_waterfallBitmap.Reset();
+    }
+}
+
+void DirectionVisualizer::UploadWaterfall(size_t columns)
+{
+    if (!m_waterfallBitmap || columns == 0)
+    {
+        return;
+    }
+
+    // The newest columns sit just behind the head; when they wrap past the
+    // right edge of the texture that is two copies instead of one.
+    const auto pitch = static_cast<UINT32>(WaterfallStrip::kColumns * sizeof(uint32_t));
+    const size_t count = std::min(columns, WaterfallStrip::kColumns);
+    const size_t first = (m_scene.Waterfall().Head() + WaterfallStrip::kColumns - count) % WaterfallStrip::kColumns;
+    const size_t firstSpan = std::min(count, WaterfallStrip::kColumns - first);
+    auto copy = [&](size_t column, size_t width)
+    {
+        const D2D1_RECT_U rect = D2D1::RectU(static_cast<UINT32>(column), 0,
+                                             static_cast<UINT32>(column + width),
+                                             static_cast<UINT32>(WaterfallStrip::kAzimuthBins));
+        m_waterfallBitmap->CopyFromMemory(&rect, m_scene.Waterfall().Pixels() + column, pitch);
+    };
+
+    copy(first, firstSpan);
+    if (count > firstSpan)
+    {
+        copy(0, count - firstSpan);
+    }
+}
+
+void DirectionVisualizer::DrawWaterfall()
+{
+    if (!m_waterfallBitmap || !m_scene.Waterfall().HasContent())
+    {
+        return;
+    }
+
+    // Oldest column (the head) on the left, newest on the right: two blits
+    // split at the wrap point instead of scrolling the texture contents.
+    const D2D1_RECT_F dest = D2D1::RectF(m_center.x - m_radius, m_center.y - m_radius,
+                                         m_center.x + m_radius, m_center.y + m_radius);
+    const size_t head = m_scene.Waterfall().Head();
+    const float columns = static_cast<float>(WaterfallStrip::kColumns);
+    const float rows = static_cast<float>(WaterfallStrip::kAzimuthBins);
+    const float split = dest.left + (dest.right - dest.left) * (columns - static_cast<float>(head)) / columns;
+
+    // Nearest-neighbour so neither half samples across the seam
+    m_renderTarget->DrawBitmap(m_waterfallBitmap.Get(),
+                               D2D1::RectF(dest.left, dest.top, split, dest.bottom),
+                               1.0f,
+                               D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR,
+                               D2D1::RectF(static_cast<float>(head), 0.0f, columns, rows));
+    if (head > 0)
+    {
+        m_renderTarget->DrawBitmap(m_waterfallBitmap.Get(),
+                                   D2D1::RectF(split, dest.top, dest.right, dest.bottom),
+                                   1.0f,
+                                   D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR,
+                                   D2D1::RectF(0.0f, 0.0f, static_cast<float>(head), rows));
+    }
+}
+
+void DirectionVisualizer::UploadHeatmap()
+{
+    if (m_heatmapBitmap)
+    {
+        m_heatmapBitmap->CopyFromMemory(nullptr,
+                                        m_scene.Heatmap().Rasterize(),
+                                        static_cast<UINT32>(PolarHeatmap::kTextureSize * sizeof(uint32_t)));
+    }
+}
+
+void DirectionVisualizer::DrawHeatmap()
+{
+    if (!m_heatmapBitmap || m_scene.Heatmap().Peak() <= 0.0f)
+    {
+        return;
+    }
+
+    // Cost is one scaled bitmap draw regardless of how many hits fed it
+    m_renderTarget->DrawBitmap(m_heatmapBitmap.Get(),
+                               D2D1::RectF(m_center.x - m_radius, m_center.y - m_radius,
+                                           m_center.x + m_radius, m_center.y + m_radius),
+                               1.0f,
+                               D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+}
+
+void DirectionVisualizer::DrawReadout()
+{
+    const auto textStart = std::chrono::steady_clock::now();
+
+    // Three centered lines: azimuth, elevation, session name
+    const D2D1_RECT_F rect = TextRect(m_center, m_radius);
+    const float top = rect.top + ((rect.bottom - rect.top) - 3.0f * m_lineHeight) / 2.0f;
+
+    DrawReadoutLine(m_azimuthPrefix, m_drawnAzimuthDeg, top);
+    DrawReadoutLine(m_elevationPrefix, m_drawnElevationDeg, top + m_lineHeight);
+
+    if (m_sessionLayout)
+    {
+        m_renderTarget->DrawTextLayout(D2D1::Point2F(rect.left, top + 2.0f * m_lineHeight),
+                                       m_sessionLayout.Get(),
+                                       m_primaryBrush.Get());
+    }
+
+    m_frameTextCost += std::chrono::steady_clock::now() - textStart;
+}
+
+void DirectionVisualizer::DrawReadoutLine(const TextPiece& prefix, int value, float y)
+{
+    // Decimal digits of |value|, least significant first
+    std::array<int, 4> digits{};
+    size_t count = 0;
+    unsigned int remaining = static_cast<unsigned int>(value < 0 ? -value : value);
+    do
+    {
+        digits[count++] = static_cast<int>(remaining % 10);
+        remaining /= 10;
+    } while (remaining > 0 && count < digits.size());
+
+    const TextPiece& minus = m_digitAtlas[kMinusGlyph];
+
+    float width = prefix.width + m_degreeSuffix.width + (value < 0 ? minus.width : 0.0f);
+    for (size_t i = 0; i < count; ++i)
+    {
+        width += m_digitAtlas[digits[i]].width;
+    }
+
+    float x = m_center.x - width / 2.0f;
+    auto draw = [&](const TextPiece& piece)
+    {
+        if (piece.layout)
+        {
+            m_renderTarget->DrawTextLayout(D2D1::Point2F(x, y), piece.layout.Get(), m_primaryBrush.Get());
         }
+        x += piece.width;
+    };
+
+    draw(prefix);
+    if (value < 0)
+    {
+        draw(minus);
+    }
+    for (size_t i = count; i-- > 0;)
+    {
+        draw(m_digitAtlas[digits[i]]);
+    }
+    draw(m_degreeSuffix);
+}
+
+void DirectionVisualizer::UpdateDirection(const Audio::AudioDirection& direction)
+{
+    // Producer side: only the router thread calls UpdateDirection/SetModeLabel,
+    // so the classification state below needs no lock. The sensitivity copy is
+    // the only shared read.
+    Config::SensitivityConfig sensitivity;
+    {
+        std::scoped_lock lock{m_mutex};
+        sensitivity = m_sensitivity;
+    }
 
-        RadarHit hit;
-        hit.direction = direction;
-        hit.radiusFactor = radiusFactor;
-        hit.pattern = pattern;
-        hit.time = now;
-        m_hits.push_back(hit);
+    m_producerState.direction = direction;
 
-        m_lastMagnitude = direction.magnitude;
+    // Classified even while hidden, so the loudness reference keeps up, but
+    // not queued: the render thread is asleep and would find them stale
+    RadarHitRecord hit;
+    if (m_classifier.Classify(direction, sensitivity, std::chrono::steady_clock::now(), hit))
+    {
+        if (IsVisible() && !m_pendingHits.Push(hit))
+        {
+            // Renderer has fallen behind by a full queue; drop rather than block
+            m_droppedHits.Add();
+        }
+
+        m_producerState.hasLastHit = true;
+        m_producerState.lastHitAzimuth = direction.azimuth;
+        m_producerState.lastHitElevation = direction.elevation;
     }
+
+    PublishSnapshot();
 }
 
 void DirectionVisualizer::SetVisible(bool visible)
 {
-    std::scoped_lock lock{m_mutex};
-    m_state.visible = visible;
+    m_visible.store(visible, std::memory_order_release);
 }
 
 void DirectionVisualizer::SetSensitivity(const Config::SensitivityConfig& sensitivity)
 {
-    std::scoped_lock lock{m_mutex};
-    m_sensitivity = sensitivity;
+    {
+        std::scoped_lock lock{m_mutex};
+        m_sensitivity = sensitivity;
+    }
+    m_distanceScale.store(std::clamp(sensitivity.distanceScale, 0.5f, 2.0f), std::memory_order_relaxed);
 }
 
-void DirectionVisualizer::SetModeLabel(const std::wstring& label)
+void DirectionVisualizer::SetModeLabel(std::wstring_view label)
 {
-    std::scoped_lock lock{m_mutex};
-    m_state.modeLabel = label;
+    if (m_producerState.modeLabel.View() == label)
+    {
+        return;
+    }
+
+    m_producerState.modeLabel.Assign(label);
+    PublishSnapshot();
 }
 
 VisualState DirectionVisualizer::CurrentState() const
 {
-    std::scoped_lock lock{m_mutex};
-    return m_state;
+    const FrameSnapshot& frame = m_snapshots.Front();
+
+    VisualState state;
+    state.direction = frame.direction;
+    state.visible = m_visible.load(std::memory_order_acquire);
+    state.modeLabel = std::wstring(frame.modeLabel.View());
+    return state;
+}
+
+void DirectionVisualizer::UpdateGeometry()
+{
+    m_center = D2D1::Point2F(static_cast<float>(m_width) / 2.0f, static_cast<float>(m_height) / 2.0f);
+    m_radius = std::min(m_width, m_height) * 0.45f;
+}
+
+void DirectionVisualizer::DrawStaticLayer(ID2D1RenderTarget* target) const
+{
+    Direct2DRenderBackend backend(target);
+    PaintRadarBackground(backend, StyleFromConfig(), { m_center.x, m_center.y }, m_radius);
+}
+
+void DirectionVisualizer::RebuildStaticLayer()
+{
+    m_staticLayer.Reset();
+
+    if (!m_renderTarget || m_width == 0 || m_height == 0)
+    {
+        return;
+    }
+
+    if (m_presenter)
+    {
+        if (m_softwareStaticLayer)
+        {
+            m_softwareStaticLayer->Resize(m_width, m_height);
+        }
+        else
+        {
+            m_softwareStaticLayer = std::make_unique<SoftwareRenderBackend>(m_width, m_height);
+        }
+        PaintRadarBackground(*m_softwareStaticLayer, StyleFromConfig(), { m_center.x, m_center.y }, m_radius);
+        return;
+    }
+
+    // Compatible targets share the parent's resource domain, so the
+    // existing brushes can be used to rasterize the layer. On failure
+    // DrawScene falls back to drawing the static elements directly.
+    Microsoft::WRL::ComPtr<ID2D1BitmapRenderTarget> layerTarget;
+    if (FAILED(m_renderTarget->CreateCompatibleRenderTarget(
+            D2D1::SizeF(static_cast<float>(m_width), static_cast<float>(m_height)), &layerTarget)))
+    {
+        return;
+    }
+
+    layerTarget->BeginDraw();
+    DrawStaticLayer(layerTarget.Get());
+    if (FAILED(layerTarget->EndDraw()))
+    {
+        return;
+    }
+
+    layerTarget->GetBitmap(&m_staticLayer);
+}
+
+void DirectionVisualizer::Invalidate() noexcept
+{
+    m_invalidateRequested.store(true, std::memory_order_release);
+}
+
+void DirectionVisualizer::InvalidateTheme()
+{
+    {
+        std::scoped_lock lock{m_mutex};
+        m_pendingTheme = m_config->Theme();
+    }
+    m_themeDirty.store(true, std::memory_order_release);
+}
+
+void DirectionVisualizer::SetDisplay(const Config::DisplayConfig& display) noexcept
+{
+    m_showDiagnostics.store(display.showDiagnostics, std::memory_order_relaxed);
+    m_visualization.store(display.visualization, std::memory_order_relaxed);
+    m_perPixelAlpha.store(display.perPixelAlpha, std::memory_order_relaxed);
+    m_predictMotion.store(display.predictMotion, std::memory_order_relaxed);
+    m_invalidateRequested.store(true, std::memory_order_release);
+}
+
+void DirectionVisualizer::RequestDeviceReset() noexcept
+{
+    m_deviceRequested.store(true, std::memory_order_release);
+}
+
+DirectionVisualizer::FrameStats DirectionVisualizer::Stats() const noexcept
+{
+    FrameStats stats;
+    stats.rendered = m_framesRendered.Total();
+    stats.skipped = m_framesSkipped.Total();
+    stats.partial = m_framesPartial.Total();
+    stats.textMicros = m_textMicros.load(std::memory_order_relaxed);
+    return stats;
+}
+
+DirectionVisualizer::FrameTiming DirectionVisualizer::Timing() const noexcept
+{
+    FrameTiming timing;
+    timing.cpuP50 = m_cpuTime.Percentile(0.50);
+    timing.cpuP99 = m_cpuTime.Percentile(0.99);
+    timing.intervalP50 = m_presentInterval.Percentile(0.50);
+    timing.intervalP99 = m_presentInterval.Percentile(0.99);
+    timing.intervalMax = m_presentInterval.Max();
+    timing.latencyP50 = m_displayLatency.Percentile(0.50);
+    timing.latencyP99 = m_displayLatency.Percentile(0.99);
+    return timing;
+}
+
+DirectionVisualizer::RenderSyncStats DirectionVisualizer::SyncStats() const noexcept
+{
+    RenderSyncStats stats;
+    stats.sensitivityLock = m_mutex.Stats();
+    stats.droppedHits = m_droppedHits.Total();
+    return stats;
+}
+
+void DirectionVisualizer::PublishSnapshot()
+{
+    // Assigning into the recycled back slot reuses its string capacity,
+    // so steady-state publishing does not allocate.
+    m_snapshots.Back() = m_producerState;
+    m_snapshots.Publish();
+}
+
+void DirectionVisualizer::DrainPendingHits()
+{
+    size_t drained = 0;
+    RadarHitRecord hit;
+    const float scale = m_distanceScale.load(std::memory_order_relaxed);
+
+    // Expected present: this frame's measured render cost plus, on average,
+    // half a compositor interval until the next vblank picks it up.
+    const bool predict = m_predictMotion.load(std::memory_order_relaxed);
+    const auto presentTime = std::chrono::steady_clock::now() + m_renderCost + m_presentInterval.Percentile(0.50) / 2;
+
+    // Hits queued while the device was down waited for the device, not
+    // for a frame; they are drawn but not counted as display latency
+    const bool stale = m_staleHits;
+    m_staleHits = false;
+
+    m_newestCapture = {};
+    while (m_pendingHits.TryPop(hit))
+    {
+        if (predict)
+        {
+            PredictHit(hit, presentTime);
+        }
+        if (!stale)
+        {
+            m_newestCapture = std::max(m_newestCapture, hit.captureTime);
+        }
+        m_scene.Add(hit, scale);
+        ++drained;
+    }
+    m_hitQueueDepth.Set(static_cast<int64_t>(drained));
 }
 
 void DirectionVisualizer::CreateDeviceResources(HWND hwnd)
@@ -379,41 +1136,145 @@ void DirectionVisualizer::CreateDeviceResources(HWND hwnd)
         return;
     }
 
-    D2D1_RENDER_TARGET_PROPERTIES rtProps = D2D1::RenderTargetProperties();
-    D2D1_HWND_RENDER_TARGET_PROPERTIES hwndProps =
-        D2D1::HwndRenderTargetProperties(hwnd, D2D1::SizeU(m_width, m_height));
+    if (m_perPixelAlpha.load(std::memory_order_relaxed))
+    {
+        // Premultiplied BGRA DC target for text over the software surface
+        const D2D1_RENDER_TARGET_PROPERTIES dcProps = D2D1::RenderTargetProperties(
+            D2D1_RENDER_TARGET_TYPE_DEFAULT,
+            D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        THROW_IF_FAILED(m_factory->CreateDCRenderTarget(&dcProps, &m_dcTarget));
+        m_renderTarget = m_dcTarget;
+
+        m_presenter = std::make_unique<LayeredWindowPresenter>(hwnd);
+        m_presenter->Resize(m_width, m_height);
+        m_software = std::make_unique<SoftwareRenderBackend>(m_width, m_height);
+    }
+    else
+    {
+        D2D1_RENDER_TARGET_PROPERTIES rtProps = D2D1::RenderTargetProperties();
+        // Retain contents so partial frames only need to repaint dirty rectangles
+        D2D1_HWND_RENDER_TARGET_PROPERTIES hwndProps =
+            D2D1::HwndRenderTargetProperties(hwnd, D2D1::SizeU(m_width, m_height), D2D1_PRESENT_OPTIONS_RETAIN_CONTENTS);
+
+        THROW_IF_FAILED(m_factory->CreateHwndRenderTarget(rtProps, hwndProps, &m_hwndTarget));
+        m_renderTarget = m_hwndTarget;
+    }
+
+    ApplyWindowLayering(hwnd);
+
+    // Sprite batches need ID2D1DeviceContext3 (Windows 10 1703+). HWND
+    // targets expose it via QueryInterface; older systems use the fallback.
+    // The layered presenter draws markers in software, so it needs neither.
+    if (!m_presenter && SUCCEEDED(m_renderTarget.As(&m_deviceContext)))
+    {
+        if (FAILED(m_deviceContext->CreateSpriteBatch(&m_spriteBatch)))
+        {
+            m_spriteBatch.Reset();
+        }
+    }
+
+    CreateBrushes();
+
+    THROW_IF_FAILED(m_dwriteFactory->CreateTextFormat(L"Segoe UI",
+                                                      nullptr,
+                                                      DWRITE_FONT_WEIGHT_REGULAR,
+                                                      DWRITE_FONT_STYLE_NORMAL,
+                                                      DWRITE_FONT_STRETCH_NORMAL,
+                                                      16.0f,
+                                                      L"",
+                                                      &m_textFormat));
+    m_textFormat->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_CENTER);
+    m_textFormat->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
+
+    CreateTextResources();
+    UpdateGeometry();
+    RebuildStaticLayer();
+    RebuildMarkerAtlas();
+    RebuildHeatmap();
+    RebuildWaterfall();
+    m_fullRedraw = true;
+}
 
-    THROW_IF_FAILED(m_factory->CreateHwndRenderTarget(rtProps, hwndProps, &m_renderTarget));
+void DirectionVisualizer::ApplyWindowLayering(HWND hwnd)
+{
+    // Done here rather than on the UI thread, so the layering API never
+    // changes under a present in flight. SetLayeredWindowAttributes and
+    // UpdateLayeredWindow cannot be mixed; clearing WS_EX_LAYERED drops
+    // whichever was used before.
+    const bool perPixelAlpha = m_presenter != nullptr;
+    if (perPixelAlpha != m_windowPerPixelAlpha)
+    {
+        const LONG_PTR exStyle = GetWindowLongPtrW(hwnd, GWL_EXSTYLE);
+        SetWindowLongPtrW(hwnd, GWL_EXSTYLE, exStyle & ~static_cast<LONG_PTR>(WS_EX_LAYERED));
+        SetWindowLongPtrW(hwnd, GWL_EXSTYLE, exStyle | WS_EX_LAYERED);
+        m_windowPerPixelAlpha = perPixelAlpha;
+    }
 
+    // With per-pixel alpha the opacity is carried by the pixels alone
+    if (!perPixelAlpha)
+    {
+        SetLayeredWindowAttributes(hwnd, 0, static_cast<BYTE>(255 * m_theme.opacity), LWA_ALPHA);
+    }
+}
+
+void DirectionVisualizer::ReleaseDeviceResources()
+{
+    // Everything created against the render target goes with it; text
+    // formats and layouts belong to the DirectWrite factory and survive.
+    m_spriteBatch.Reset();
+    m_deviceContext.Reset();
+    m_markerAtlas.Reset();
+    m_heatmapBitmap.Reset();
+    m_waterfallBitmap.Reset();
+    m_staticLayer.Reset();
+    m_primaryBrush.Reset();
+    m_accentBrush.Reset();
+    m_renderTarget.Reset();
+    m_hwndTarget.Reset();
+    m_dcTarget.Reset();
+    m_presenter.reset();
+    m_software.reset();
+    m_softwareStaticLayer.reset();
+
+    // The next present follows a gap (hidden, or rebuilding after a
+    // failure), not a frame interval
+    m_presentedLastFrame = false;
+    m_staleHits = true;
+}
+
+void DirectionVisualizer::CreateBrushes()
+{
     const auto primaryColor = ColorFromConfig();
-    THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(primaryColor, &m_primaryBrush));
+    THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(primaryColor, m_primaryBrush.ReleaseAndGetAddressOf()));
 
-    const auto accent = m_config->Theme().accentColor;
+    const auto accent = m_theme.accentColor;
     THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(
                         D2D1::ColorF(GetRValue(accent) / 255.0f,
                                      GetGValue(accent) / 255.0f,
                                      GetBValue(accent) / 255.0f,
-                                     m_config->Theme().opacity * 0.6f),
-                        &m_accentBrush));
+                                     m_theme.opacity * 0.6f),
+                        m_accentBrush.ReleaseAndGetAddressOf()));
 
-    THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(
-                        D2D1::ColorF(0.3f, 0.3f, 0.35f, m_config->Theme().opacity * 0.7f),
-                        &m_backgroundBrush));
+}
 
-    const float alpha = m_config->Theme().opacity;
-    // Strong: red
-    THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(
-                        D2D1::ColorF(0.95f, 0.25f, 0.25f, alpha),
-                        &m_strongBrush));
-    // Medium: blue
-    THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(
-                        D2D1::ColorF(0.25f, 0.55f, 0.95f, alpha),
-                        &m_mediumBrush));
-    // Weak/other: green
-    THROW_IF_FAILED(m_renderTarget->CreateSolidColorBrush(
-                        D2D1::ColorF(0.30f, 0.85f, 0.40f, alpha),
-                        &m_weakBrush));
+RadarStyle DirectionVisualizer::StyleFromConfig() const
+{
+    const auto& theme = m_theme;
+    const auto accent = theme.accentColor;
+
+    RadarStyle style;
+    style.background.a *= theme.opacity;
+    style.grid.a *= theme.opacity;
+    style.ring = { GetRValue(accent) / 255.0f, GetGValue(accent) / 255.0f, GetBValue(accent) / 255.0f, theme.opacity * 0.6f };
+    style.strong.a = theme.opacity;
+    style.medium.a = theme.opacity;
+    style.weak.a = theme.opacity;
+    return style;
+}
 
+void DirectionVisualizer::CreateTextResources()
+{
+    // Leading-aligned, non-wrapping format for the pre-shaped readout pieces
     THROW_IF_FAILED(m_dwriteFactory->CreateTextFormat(L"Segoe UI",
                                                       nullptr,
                                                       DWRITE_FONT_WEIGHT_REGULAR,
@@ -421,16 +1282,105 @@ void DirectionVisualizer::CreateDeviceResources(HWND hwnd)
                                                       DWRITE_FONT_STRETCH_NORMAL,
                                                       16.0f,
                                                       L"",
-                                                      &m_textFormat));
-    m_textFormat->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_CENTER);
-    m_textFormat->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
+                                                      &m_readoutFormat));
+    m_readoutFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP);
+
+    THROW_IF_FAILED(m_dwriteFactory->CreateTextFormat(L"Segoe UI",
+                                                      nullptr,
+                                                      DWRITE_FONT_WEIGHT_REGULAR,
+                                                      DWRITE_FONT_STYLE_NORMAL,
+                                                      DWRITE_FONT_STRETCH_NORMAL,
+                                                      11.0f,
+                                                      L"",
+                                                      &m_diagnosticsFormat));
+    m_diagnosticsFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP);
+
+    static constexpr const wchar_t* kGlyphs[] = {
+        L"0", L"1", L"2", L"3", L"4", L"5", L"6", L"7", L"8", L"9", L"-",
+    };
+    static_assert(std::size(kGlyphs) == kDigitAtlasSize, "digit atlas size mismatch");
+
+    for (size_t i = 0; i < kDigitAtlasSize; ++i)
+    {
+        m_digitAtlas[i] = ShapeTextPiece(kGlyphs[i]);
+    }
+    m_azimuthPrefix = ShapeTextPiece(L"Az(horiz) ");
+    m_elevationPrefix = ShapeTextPiece(L"El(vert) ");
+    m_degreeSuffix = ShapeTextPiece(L" deg");
+
+    DWRITE_TEXT_METRICS metrics{};
+    if (m_digitAtlas[0].layout && SUCCEEDED(m_digitAtlas[0].layout->GetMetrics(&metrics)))
+    {
+        m_lineHeight = metrics.height;
+    }
+}
+
+DirectionVisualizer::TextPiece DirectionVisualizer::ShapeTextPiece(const wchar_t* text) const
+{
+    TextPiece piece;
+    if (FAILED(m_dwriteFactory->CreateTextLayout(text,
+                                                 static_cast<UINT32>(wcslen(text)),
+                                                 m_readoutFormat.Get(),
+                                                 1000.0f,
+                                                 100.0f,
+                                                 &piece.layout)))
+    {
+        return piece;
+    }
+
+    DWRITE_TEXT_METRICS metrics{};
+    if (SUCCEEDED(piece.layout->GetMetrics(&metrics)))
+    {
+        piece.width = metrics.widthIncludingTrailingWhitespace;
+    }
+    return piece;
+}
+
+void DirectionVisualizer::RebuildLabelLayout()
+{
+    m_labelLayout.Reset();
+    if (m_drawnLabel.Empty() || !m_textFormat)
+    {
+        return;
+    }
+
+    const float width = std::max(0.0f, static_cast<float>(m_width) - 2.0f * kLabelInset);
+    m_dwriteFactory->CreateTextLayout(m_drawnLabel.Data(),
+                                      static_cast<UINT32>(m_drawnLabel.Size()),
+                                      m_textFormat.Get(),
+                                      width,
+                                      kLabelBottom - kLabelTop,
+                                      &m_labelLayout);
+}
+
+void DirectionVisualizer::RebuildSessionLayout()
+{
+    m_sessionLayout.Reset();
+    if (m_drawnSessionName.Empty() || !m_textFormat)
+    {
+        return;
+    }
+
+    m_dwriteFactory->CreateTextLayout(m_drawnSessionName.Data(),
+                                      static_cast<UINT32>(m_drawnSessionName.Size()),
+                                      m_textFormat.Get(),
+                                      2.0f * m_radius,
+                                      m_lineHeight,
+                                      &m_sessionLayout);
+}
+
+D2D1_RECT_F DirectionVisualizer::DiagnosticsRect() const
+{
+    // Three lines: frame counters, render timing, capture-to-display latency
+    const float bottom = static_cast<float>(m_height) - 2.0f;
+    return D2D1::RectF(kLabelInset, bottom - 42.0f, static_cast<float>(m_width) - kLabelInset, bottom);
 }
 
 D2D1::ColorF DirectionVisualizer::ColorFromConfig() const
 {
-    const auto color = m_config->Theme().primaryColor;
+    const auto color = m_theme.primaryColor;
     return D2D1::ColorF(GetRValue(color) / 255.0f,
                         GetGValue(color) / 255.0f,
                         GetBValue(color) / 255.0f,
-                        m_config->Theme().opacity);
+                        m_theme.opacity);
 }
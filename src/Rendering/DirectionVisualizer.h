@@ -1,21 +1,37 @@
 #pragma once
 
 #include <d2d1.h>
+#include <d2d1_3.h>
 #include <dwrite.h>
 #include <wrl/client.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <vector>
-#include <chrono>
+#include <string_view>
 #include <chrono>
 
 #include "Audio/SpatialAudioEngine.h"
 #include "Config/ConfigManager.h"
+#include "Diagnostics/MetricsRegistry.h"
+#include "Rendering/HitClassifier.h"
+#include "Rendering/RadarPainter.h"
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/RadarScene.h"
+#include "Util/FixedWString.h"
+#include "Util/InstrumentedMutex.h"
+#include "Util/LatencyHistogram.h"
+#include "Util/SpscQueue.h"
+#include "Util/TripleBuffer.h"
 
 namespace Rendering
 {
+class LayeredWindowPresenter;
+class SoftwareRenderBackend;
+
 struct VisualState
 {
     Audio::AudioDirection direction;
@@ -23,66 +39,233 @@ struct VisualState
     std::wstring modeLabel;
 };
 
-enum class RadarPattern
-{
-    Unknown = 0, // Fallback / other
-    Strong = 1,  // Sharp impulse / strong transient
-    Medium = 2,  // Rhythmic / burst-like
-    Weak = 3,    // Soft / residual
-};
+using ModeLabel = Util::FixedWString<64>;
 
-struct RadarHit
+// Producer-side state handed to the renderer through a triple buffer.
+// Trivially copyable, so publishing never allocates.
+struct FrameSnapshot
 {
     Audio::AudioDirection direction;
-    float radiusFactor{1.0f};
-    RadarPattern pattern{RadarPattern::Unknown};
-    std::chrono::steady_clock::time_point time;
+    ModeLabel modeLabel;
+    bool hasLastHit{false};
+    float lastHitAzimuth{0.0f};
+    float lastHitElevation{0.0f};
 };
 
 class DirectionVisualizer
 {
 public:
+    struct FrameStats
+    {
+        uint64_t rendered{0};
+        uint64_t skipped{0}; // nothing changed, BeginDraw/EndDraw not called
+        uint64_t partial{0}; // rendered frames that only touched dirty rectangles
+        float textMicros{0.0f}; // smoothed per-frame text drawing cost
+    };
+
+    struct RenderSyncStats
+    {
+        Util::LockWaitStats sensitivityLock;
+        uint64_t droppedHits{0};
+    };
+
+    // Rendered frames only: time spent in Render, and the gap between
+    // consecutive presents while the scene keeps changing. Covers the last
+    // complete timing window, not the whole run.
+    struct FrameTiming
+    {
+        std::chrono::microseconds cpuP50{0};
+        std::chrono::microseconds cpuP99{0};
+        std::chrono::microseconds intervalP50{0};
+        std::chrono::microseconds intervalP99{0};
+        std::chrono::microseconds intervalMax{0};
+        // Capture of the newest hit to the present that first showed it
+        std::chrono::microseconds latencyP50{0};
+        std::chrono::microseconds latencyP99{0};
+    };
+
     explicit DirectionVisualizer(std::shared_ptr<Config::ConfigManager> config);
     ~DirectionVisualizer();
 
+    // Control API: callable from any thread. Requests are applied at the
+    // start of the next Render on the render thread.
+
+    // (Re-)creates device resources for the presenter selected by SetDisplay,
+    // and sets the window's layering and opacity up to match.
     void Initialize(HWND hwnd);
     void Resize(UINT width, UINT height);
-    void Render();
-    void UpdateDirection(const Audio::AudioDirection& direction);
+    // Forces the next Render to repaint everything.
+    void Invalidate() noexcept;
+    // Theme colors or opacity changed: brushes are rebuilt on the next Render.
+    void InvalidateTheme();
+    void SetDisplay(const Config::DisplayConfig& display) noexcept;
     void SetVisible(bool visible);
     void SetSensitivity(const Config::SensitivityConfig& sensitivity);
-    void SetModeLabel(const std::wstring& label);
+    // Drops and rebuilds the device on the next Render, e.g. after a failure.
+    void RequestDeviceReset() noexcept;
 
-    [[nodiscard]] bool IsVisible() const noexcept { return m_state.visible; }
+    // Render-thread API
+    // Draws only when something changed since the last frame.
+    void Render();
+    void ReleaseDeviceResources();
+
+    // Producer API: called from a single producer thread (the router).
+    void UpdateDirection(const Audio::AudioDirection& direction);
+    void SetModeLabel(std::wstring_view label);
+
+    [[nodiscard]] bool IsVisible() const noexcept { return m_visible.load(std::memory_order_acquire); }
+    // Render-thread only: reflects the snapshot used by the last frame.
     [[nodiscard]] VisualState CurrentState() const;
+    [[nodiscard]] FrameStats Stats() const noexcept;
+    [[nodiscard]] RenderSyncStats SyncStats() const noexcept;
+    [[nodiscard]] FrameTiming Timing() const noexcept;
 
 private:
+    // A pre-shaped run of text and its advance width
+    struct TextPiece
+    {
+        Microsoft::WRL::ComPtr<IDWriteTextLayout> layout;
+        float width{0.0f};
+    };
+
+    static constexpr size_t kDigitAtlasSize = 11; // '0'..'9' and '-'
+    static constexpr size_t kMinusGlyph = 10;
+
+    void ApplyPendingRequests();
+    void ApplyResize(UINT width, UINT height);
     void CreateDeviceResources(HWND hwnd);
+    void ApplyWindowLayering(HWND hwnd);
+    void CreateTextResources();
+    TextPiece ShapeTextPiece(const wchar_t* text) const;
+    void RebuildLabelLayout();
+    void RebuildSessionLayout();
+    void DrawReadout();
+    void DrawReadoutLine(const TextPiece& prefix, int value, float y);
+    D2D1_RECT_F DiagnosticsRect() const;
+    void CreateBrushes();
     void UpdateGeometry();
+    void DrawStaticLayer(ID2D1RenderTarget* target) const;
+    void RebuildStaticLayer();
+    void PublishSnapshot();
+    void RotateTimingWindow(std::chrono::steady_clock::time_point now);
+    void DrainPendingHits();
+    void DrawScene();
+    void DrawOverlayText();
+    void PresentLayered(const D2D1_RECT_F* regions, size_t count);
+    void PrepareMarkers();
+    void DrawMarkers();
+    void RebuildMarkerAtlas();
+    void RebuildHeatmap();
+    void UploadHeatmap();
+    void DrawHeatmap();
+    void RebuildWaterfall();
+    void UploadWaterfall(size_t columns);
+    void DrawWaterfall();
     D2D1::ColorF ColorFromConfig() const;
+    RadarStyle StyleFromConfig() const;
 
     std::shared_ptr<Config::ConfigManager> m_config;
 
     Microsoft::WRL::ComPtr<ID2D1Factory> m_factory;
-    Microsoft::WRL::ComPtr<ID2D1HwndRenderTarget> m_renderTarget;
+    // HWND target by default; a DC target bound to the layered presenter's
+    // surface when per-pixel alpha is enabled (text only, geometry is software)
+    Microsoft::WRL::ComPtr<ID2D1RenderTarget> m_renderTarget;
+    Microsoft::WRL::ComPtr<ID2D1HwndRenderTarget> m_hwndTarget;
+    Microsoft::WRL::ComPtr<ID2D1DCRenderTarget> m_dcTarget;
+    std::unique_ptr<LayeredWindowPresenter> m_presenter;
+    std::unique_ptr<SoftwareRenderBackend> m_software;
+    Microsoft::WRL::ComPtr<ID2D1DeviceContext3> m_deviceContext; // null before Windows 10 1703
+    Microsoft::WRL::ComPtr<ID2D1SpriteBatch> m_spriteBatch;
+    Microsoft::WRL::ComPtr<ID2D1Bitmap> m_markerAtlas;
+    Microsoft::WRL::ComPtr<ID2D1Bitmap> m_heatmapBitmap;
+    Microsoft::WRL::ComPtr<ID2D1Bitmap> m_waterfallBitmap; // circular, one column per period
     Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_primaryBrush;
-    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_backgroundBrush;
     Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_accentBrush;
-    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_strongBrush;
-    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_mediumBrush;
-    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> m_weakBrush;
     Microsoft::WRL::ComPtr<IDWriteFactory> m_dwriteFactory;
     Microsoft::WRL::ComPtr<IDWriteTextFormat> m_textFormat;
+    Microsoft::WRL::ComPtr<IDWriteTextFormat> m_readoutFormat;
+    Microsoft::WRL::ComPtr<IDWriteTextFormat> m_diagnosticsFormat;
+    // Cached layouts, rebuilt only when their text or the size changes
+    Microsoft::WRL::ComPtr<IDWriteTextLayout> m_labelLayout;
+    Microsoft::WRL::ComPtr<IDWriteTextLayout> m_sessionLayout;
+    std::array<TextPiece, kDigitAtlasSize> m_digitAtlas;
+    TextPiece m_azimuthPrefix;
+    TextPiece m_elevationPrefix;
+    TextPiece m_degreeSuffix;
+    float m_lineHeight{21.0f};
+    // Background clear, crosshair and ring; rebuilt on resize/theme change
+    Microsoft::WRL::ComPtr<ID2D1Bitmap> m_staticLayer;
+    // The same for the software path, copied into each repainted region
+    std::unique_ptr<SoftwareRenderBackend> m_softwareStaticLayer;
 
-    VisualState m_state;
+    // Shared between threads
+    static constexpr uint64_t kResizePending = 1ull << 63;
+    std::atomic<HWND> m_hwnd{nullptr};
+    std::atomic<bool> m_deviceRequested{false};
+    std::atomic<uint64_t> m_pendingSize{0}; // kResizePending | width << 32 | height
+    std::atomic<bool> m_invalidateRequested{false};
+    std::atomic<bool> m_showDiagnostics{false};
+    std::atomic<Config::VisualizationMode> m_visualization{Config::VisualizationMode::Radar};
+    std::atomic<bool> m_perPixelAlpha{false};
+    std::atomic<bool> m_predictMotion{true};
+    std::atomic<bool> m_visible{true};
+    std::atomic<float> m_distanceScale{1.0f};
+    std::atomic<bool> m_themeDirty{false};
+    std::atomic<float> m_textMicros{0.0f};
     Config::SensitivityConfig m_sensitivity;
-    std::vector<RadarHit> m_hits;
-    float m_referenceMagnitude{0.0f};
-    float m_lastMagnitude{0.0f};
+    Config::ThemeConfig m_pendingTheme;
+    mutable Util::InstrumentedMutex m_mutex; // guards m_sensitivity and m_pendingTheme
+    // Owned by the metrics registry
+    Diagnostics::Counter& m_droppedHits;
+    Diagnostics::Counter& m_framesRendered;
+    Diagnostics::Counter& m_framesSkipped;
+    Diagnostics::Counter& m_framesPartial;
+    Diagnostics::Gauge& m_hitQueueDepth; // hits waiting at the start of the last frame
+    // The last complete kTimingWindow of rendering, so the tooltip and the
+    // diagnostics line show recent timing rather than the run's history
+    Util::LatencyHistogram& m_cpuTime;
+    Util::LatencyHistogram& m_presentInterval;
+    Util::LatencyHistogram& m_displayLatency;
+    Util::TripleBuffer<FrameSnapshot> m_snapshots;
+    Util::SpscQueue<RadarHitRecord, 256> m_pendingHits;
+
+    // Producer-thread state
+    FrameSnapshot m_producerState;
+    HitClassifier m_classifier;
+
+    // Render-thread state
+    Config::ThemeConfig m_theme;
+    std::chrono::steady_clock::time_point m_lastPresent;
+    bool m_presentedLastFrame{false};
+    bool m_staleHits{false}; // queued before the device was last rebuilt
+    bool m_windowPerPixelAlpha{false}; // layering the window is set up for
+    std::chrono::steady_clock::duration m_renderCost{}; // smoothed frameStart..present
+    std::chrono::steady_clock::time_point m_newestCapture; // drained this frame, or epoch
+    // The window being collected, published to the registry when it ends
+    Util::LatencyHistogram m_windowCpuTime;
+    Util::LatencyHistogram m_windowPresentInterval;
+    Util::LatencyHistogram m_windowDisplayLatency;
+    std::chrono::steady_clock::time_point m_timingWindowStart;
+    RadarScene m_scene;
+    // Per-frame marker instances, prepared once and drawn per dirty rectangle
+    std::array<D2D1_RECT_F, RadarHitBuffer::kCapacity> m_markerDest{};
+    std::array<D2D1_RECT_U, RadarHitBuffer::kCapacity> m_markerSource{};
+    std::array<D2D1_COLOR_F, RadarHitBuffer::kCapacity> m_markerColor{};
+    size_t m_markerCount{0};
+    bool m_fullRedraw{true};
+    bool m_drawnVisible{true};
+    int m_drawnAzimuthDeg{0};
+    int m_drawnElevationDeg{0};
+    bool m_drawnDiagnostics{false};
+    ModeLabel m_drawnLabel;
+    Audio::SessionName m_drawnSessionName;
+    std::chrono::steady_clock::duration m_frameTextCost{};
+    std::chrono::steady_clock::time_point m_lastDiagnosticsUpdate;
+    wchar_t m_diagnosticsText[224]{};
 
     UINT m_width{320};
     UINT m_height{320};
-
-    mutable std::mutex m_mutex;
+    D2D1_POINT_2F m_center{160.0f, 160.0f};
+    float m_radius{144.0f};
 };
 }
@@ -0,0 +1,40 @@
+#include "Rendering/DwmFrameClock.h"
+
+#include <windows.h>
+#include <dwmapi.h>
+
+using namespace Rendering;
+
+namespace
+{
+// When DWM cannot report its refresh period
+constexpr auto kDefaultInterval = std::chrono::microseconds(16667);
+
+// The compositor's refresh period, so the fallback keeps the rate DwmFlush
+// paced at on high refresh rate displays
+std::chrono::steady_clock::duration CompositionInterval()
+{
+    DWM_TIMING_INFO timing{};
+    timing.cbSize = sizeof(timing);
+    LARGE_INTEGER frequency{};
+    if (FAILED(DwmGetCompositionTimingInfo(nullptr, &timing)) || timing.qpcRefreshPeriod == 0 ||
+        !QueryPerformanceFrequency(&frequency) || frequency.QuadPart <= 0)
+    {
+        return kDefaultInterval;
+    }
+
+    const auto period = std::chrono::microseconds(
+        static_cast<long long>(timing.qpcRefreshPeriod * 1000000ull / static_cast<ULONGLONG>(frequency.QuadPart)));
+    // Anything outside 25-500 Hz is a bogus report
+    if (period < std::chrono::microseconds(2000) || period > std::chrono::microseconds(40000))
+    {
+        return kDefaultInterval;
+    }
+    return period;
+}
+}
+
+DwmFrameClock::DwmFrameClock()
+    : CompositorFrameClock([] { return SUCCEEDED(DwmFlush()); }, CompositionInterval())
+{
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Rendering/FrameClock.h"
+
+namespace Rendering
+{
+// Wakes once per compositor frame via DwmFlush, so frames are produced right
+// after DWM composes and are picked up on the next vblank. Falls back for
+// good to a fixed interval at the display's refresh period when composition
+// is unavailable or DwmFlush keeps returning without waiting (e.g. nothing
+// on screen is changing).
+class DwmFrameClock final : public CompositorFrameClock
+{
+public:
+    DwmFrameClock();
+};
+}
@@ -0,0 +1,53 @@
+#include "Rendering/FrameClock.h"
+
+#include <thread>
+#include <utility>
+
+using namespace Rendering;
+
+IntervalFrameClock::IntervalFrameClock(std::chrono::steady_clock::duration interval)
+    : m_interval(interval)
+    , m_deadline(std::chrono::steady_clock::now())
+{
+}
+
+void IntervalFrameClock::WaitForNextFrame()
+{
+    const auto now = std::chrono::steady_clock::now();
+    m_deadline += m_interval;
+    if (m_deadline < now)
+    {
+        // Missed one or more ticks: realign to the next one after now
+        const auto missed = (now - m_deadline) / m_interval + 1;
+        m_deadline += missed * m_interval;
+    }
+    std::this_thread::sleep_until(m_deadline);
+}
+
+CompositorFrameClock::CompositorFrameClock(CompositorWait wait, std::chrono::steady_clock::duration fallbackInterval)
+    : m_wait(std::move(wait))
+    , m_fallbackInterval(fallbackInterval)
+{
+}
+
+void CompositorFrameClock::WaitForNextFrame()
+{
+    if (m_fallback)
+    {
+        m_fallback->WaitForNextFrame();
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!m_wait())
+    {
+        m_fallback.emplace(m_fallbackInterval);
+        return;
+    }
+
+    m_shortWaits = std::chrono::steady_clock::now() - start < kMinimumWait ? m_shortWaits + 1 : 0;
+    if (m_shortWaits >= kShortWaitsBeforeFallback)
+    {
+        m_fallback.emplace(m_fallbackInterval);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace Rendering
+{
+// Paces the render loop. Implementations block until the next frame should
+// start; the render thread never assumes anything about the source.
+class FrameClock
+{
+public:
+    virtual ~FrameClock() = default;
+
+    virtual void WaitForNextFrame() = 0;
+};
+
+// Portable fixed-interval clock. Deadlines advance in whole intervals, so a
+// slow frame skips the missed ticks instead of bursting to catch up.
+class IntervalFrameClock final : public FrameClock
+{
+public:
+    explicit IntervalFrameClock(std::chrono::steady_clock::duration interval);
+
+    void WaitForNextFrame() override;
+
+private:
+    std::chrono::steady_clock::duration m_interval;
+    std::chrono::steady_clock::time_point m_deadline;
+};
+
+// Paces to a compositor wait such as DwmFlush. The clock latches to a fixed
+// interval for every later frame when the wait fails, or when it returns
+// too quickly to have waited for a composition pass several frames in a
+// row; a single short wait is normal after a frame that ran late. The
+// frame that noticed is not delayed a second time.
+class CompositorFrameClock : public FrameClock
+{
+public:
+    // Blocks until the compositor's next pass; false when it cannot
+    using CompositorWait = std::function<bool()>;
+
+    static constexpr auto kMinimumWait = std::chrono::milliseconds(2);
+    static constexpr int kShortWaitsBeforeFallback = 8;
+
+    CompositorFrameClock(CompositorWait wait, std::chrono::steady_clock::duration fallbackInterval);
+
+    void WaitForNextFrame() override;
+
+    [[nodiscard]] bool FellBack() const noexcept { return m_fallback.has_value(); }
+
+private:
+    CompositorWait m_wait;
+    std::chrono::steady_clock::duration m_fallbackInterval;
+    int m_shortWaits{0}; // consecutive
+    // Created on latching, so its first deadline is one interval after then
+    std::optional<IntervalFrameClock> m_fallback;
+};
+}
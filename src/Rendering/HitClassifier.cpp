@@ -0,0 +1,119 @@
+#include "Rendering/HitClassifier.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Rendering;
+
+namespace
+{
+constexpr float kPi = 3.14159265358979323846f;
+}
+
+void Rendering::PredictHit(RadarHitRecord& hit, std::chrono::steady_clock::time_point presentTime) noexcept
+{
+    if (hit.velocityConfidence < kMinPredictionConfidence)
+    {
+        return;
+    }
+
+    const float lead = std::clamp(std::chrono::duration<float>(presentTime - hit.captureTime).count(), 0.0f, kMaxPredictionLead);
+    const float angle = std::clamp(hit.azimuthVelocity * lead * hit.velocityConfidence, -kMaxPredictionAngle, kMaxPredictionAngle);
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    const float x = hit.x * c + hit.z * s;
+    const float z = hit.z * c - hit.x * s;
+    hit.x = x;
+    hit.z = z;
+}
+
+bool HitClassifier::Classify(const Audio::AudioDirection& direction,
+                             const Config::SensitivityConfig& sensitivity,
+                             std::chrono::steady_clock::time_point now,
+                             RadarHitRecord& hit) noexcept
+{
+    // Record non-background, strong enough hits for radar trail
+    if (direction.isBackground || direction.magnitude <= kMinMagnitude)
+    {
+        return false;
+    }
+
+    // Update reference magnitude for relative near/far feeling
+    if (m_referenceMagnitude <= 0.0f)
+    {
+        m_referenceMagnitude = direction.magnitude;
+    }
+    else
+    {
+        // Exponential moving average
+        m_referenceMagnitude = 0.7f * m_referenceMagnitude + 0.3f * direction.magnitude;
+    }
+
+    float ref = (m_referenceMagnitude > 0.001f) ? m_referenceMagnitude : direction.magnitude;
+    float relative = (ref > 0.001f) ? (direction.magnitude / ref) : 1.0f;
+    relative = std::clamp(relative, 0.0f, 2.0f);
+
+    // Non-linear mapping: emphasize contrast between near and far
+    // relative ~= 0   -> very far  (outer ring)
+    // relative ~= 1   -> baseline
+    // relative >~ 1.5 -> very close (tight to center)
+    float loudNorm = std::clamp(relative / 1.5f, 0.0f, 1.0f); // 0..1
+    float quietNorm = 1.0f - loudNorm;                        // 0 near, 1 far
+
+    const float minRadius = 0.12f;
+    const float maxRadius = 1.0f;
+    float radiusFactor = minRadius + (maxRadius - minRadius) * (quietNorm * quietNorm);
+    radiusFactor = std::clamp(radiusFactor, minRadius, maxRadius);
+
+    // --- Pattern classification (heuristic only, configurable via SensitivityConfig) ---
+    RadarPattern pattern = RadarPattern::Weak;
+
+    // 1) Strong, sharp impulse: sudden rise vs previous magnitude
+    const float magnitudeJump = direction.magnitude - m_lastMagnitude;
+    if (direction.magnitude > sensitivity.strongMagnitude && magnitudeJump > sensitivity.strongJump)
+    {
+        pattern = RadarPattern::Strong;
+    }
+    else
+    {
+        // 2) Rhythmic / burst-like: recent hit in similar direction within ~0.3–0.7s
+        const float minInterval = sensitivity.rhythmMinInterval;
+        const float maxInterval = sensitivity.rhythmMaxInterval;
+        const float maxDirectionDelta = sensitivity.rhythmDirectionDeg * kPi / 180.0f;
+
+        if (m_hasLastHit)
+        {
+            const float dt = std::chrono::duration<float>(now - m_lastHitTime).count();
+            if (dt >= minInterval && dt <= maxInterval)
+            {
+                const float dazimuth = std::fabs(direction.azimuth - m_lastHitAzimuth);
+                const float delev = std::fabs(direction.elevation - m_lastHitElevation);
+                if (dazimuth < maxDirectionDelta && delev < maxDirectionDelta)
+                {
+                    pattern = RadarPattern::Medium;
+                }
+            }
+        }
+    }
+
+    const float cosElevation = std::cos(direction.elevation);
+
+    hit = {};
+    hit.x = std::sin(direction.azimuth) * cosElevation;
+    hit.z = std::cos(direction.azimuth) * cosElevation;
+    hit.radiusFactor = radiusFactor;
+    hit.magnitude = direction.magnitude;
+    hit.pattern = pattern;
+    hit.time = now;
+    hit.captureTime = (direction.captureTime != std::chrono::steady_clock::time_point{}) ? direction.captureTime : now;
+    hit.azimuthVelocity = direction.azimuthVelocity;
+    hit.velocityConfidence = direction.velocityConfidence;
+
+    m_hasLastHit = true;
+    m_lastHitAzimuth = direction.azimuth;
+    m_lastHitElevation = direction.elevation;
+    m_lastHitTime = now;
+
+    m_lastMagnitude = direction.magnitude;
+    return true;
+}
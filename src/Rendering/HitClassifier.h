@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+
+#include "Audio/DirectionAnalyzer.h"
+#include "Config/ConfigManager.h"
+#include "Rendering/RadarHitBuffer.h"
+
+namespace Rendering
+{
+// Prediction is skipped below this tracker confidence and scaled by it
+// above; lead time (seconds) and correction angle (radians) are both capped
+// so a bad velocity estimate can only misplace a marker so far.
+inline constexpr float kMinPredictionConfidence = 0.3f;
+inline constexpr float kMaxPredictionLead = 0.12f;
+inline constexpr float kMaxPredictionAngle = 3.14159265358979323846f / 6.0f;
+
+// Rotates the hit towards where its source is expected to be at presentTime
+void PredictHit(RadarHitRecord& hit, std::chrono::steady_clock::time_point presentTime) noexcept;
+
+// Turns analysed directions into radar hits: drops background and weak
+// directions, maps loudness against a running reference onto distance
+// (louder is closer) and picks the marker pattern with the heuristics in
+// SensitivityConfig. Keeps state across calls, so one instance per stream.
+// Has no drawing dependencies, so the render benchmark feeds it the same
+// way DirectionVisualizer::UpdateDirection does.
+class HitClassifier
+{
+public:
+    // Directions at or below this magnitude are not drawn
+    static constexpr float kMinMagnitude = 0.15f;
+
+    // Fills hit and returns true when direction should be drawn.
+    bool Classify(const Audio::AudioDirection& direction,
+                  const Config::SensitivityConfig& sensitivity,
+                  std::chrono::steady_clock::time_point now,
+                  RadarHitRecord& hit) noexcept;
+
+private:
+    float m_referenceMagnitude{0.0f};
+    float m_lastMagnitude{0.0f};
+    bool m_hasLastHit{false};
+    float m_lastHitAzimuth{0.0f};
+    float m_lastHitElevation{0.0f};
+    std::chrono::steady_clock::time_point m_lastHitTime;
+};
+}
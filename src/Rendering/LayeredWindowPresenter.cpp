@@ -0,0 +1,126 @@
+#include "Rendering/LayeredWindowPresenter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace Rendering;
+
+LayeredWindowPresenter::LayeredWindowPresenter(HWND hwnd)
+    : m_hwnd(hwnd)
+{
+    m_dc = CreateCompatibleDC(nullptr);
+    if (!m_dc)
+    {
+        throw std::runtime_error("Failed to create layered window DC");
+    }
+}
+
+LayeredWindowPresenter::~LayeredWindowPresenter()
+{
+    ReleaseSurface();
+    DeleteDC(m_dc);
+}
+
+void LayeredWindowPresenter::Resize(UINT width, UINT height)
+{
+    if (width == m_width && height == m_height && m_bitmap)
+    {
+        return;
+    }
+
+    ReleaseSurface();
+    m_width = width;
+    m_height = height;
+    m_presented = false;
+
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
+
+    BITMAPINFO info{};
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = static_cast<LONG>(width);
+    info.bmiHeader.biHeight = -static_cast<LONG>(height); // top-down rows
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    m_bitmap = CreateDIBSection(m_dc, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!m_bitmap)
+    {
+        throw std::runtime_error("Failed to create layered window surface");
+    }
+
+    m_bits = static_cast<uint32_t*>(bits);
+    std::memset(m_bits, 0, static_cast<size_t>(width) * height * sizeof(uint32_t));
+    m_previousBitmap = SelectObject(m_dc, m_bitmap);
+}
+
+void LayeredWindowPresenter::Upload(const uint32_t* pixels, const RECT& region)
+{
+    if (!m_bits)
+    {
+        return;
+    }
+
+    // Pending GDI work on the DIB must land before it is written directly
+    GdiFlush();
+
+    const LONG left = std::max<LONG>(region.left, 0);
+    const LONG top = std::max<LONG>(region.top, 0);
+    const LONG right = std::min<LONG>(region.right, static_cast<LONG>(m_width));
+    const LONG bottom = std::min<LONG>(region.bottom, static_cast<LONG>(m_height));
+    if (left >= right || top >= bottom)
+    {
+        return;
+    }
+
+    const size_t bytes = static_cast<size_t>(right - left) * sizeof(uint32_t);
+    for (LONG y = top; y < bottom; ++y)
+    {
+        const size_t offset = static_cast<size_t>(y) * m_width + static_cast<size_t>(left);
+        std::memcpy(m_bits + offset, pixels + offset, bytes);
+    }
+}
+
+void LayeredWindowPresenter::Present(const RECT& dirty)
+{
+    if (!m_bitmap)
+    {
+        return;
+    }
+
+    POINT source{ 0, 0 };
+    SIZE size{ static_cast<LONG>(m_width), static_cast<LONG>(m_height) };
+    BLENDFUNCTION blend{ AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+
+    UPDATELAYEREDWINDOWINFO info{};
+    info.cbSize = sizeof(info);
+    info.hdcSrc = m_dc;
+    info.pptSrc = &source;
+    info.psize = &size;
+    info.pblend = &blend;
+    info.dwFlags = ULW_ALPHA;
+    // The first present at a new size must cover the whole window
+    info.prcDirty = m_presented ? &dirty : nullptr;
+
+    if (UpdateLayeredWindowIndirect(m_hwnd, &info))
+    {
+        m_presented = true;
+    }
+}
+
+void LayeredWindowPresenter::ReleaseSurface()
+{
+    if (m_bitmap)
+    {
+        SelectObject(m_dc, m_previousBitmap);
+        DeleteObject(m_bitmap);
+        m_bitmap = nullptr;
+        m_previousBitmap = nullptr;
+        m_bits = nullptr;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+
+namespace Rendering
+{
+// Presents a premultiplied BGRA surface through UpdateLayeredWindowIndirect,
+// giving the overlay true per-pixel alpha instead of one window-wide
+// SetLayeredWindowAttributes value. The surface is a top-down DIB section
+// that GDI-based renderers (e.g. a Direct2D DC target) can draw into too.
+class LayeredWindowPresenter
+{
+public:
+    explicit LayeredWindowPresenter(HWND hwnd);
+    ~LayeredWindowPresenter();
+
+    LayeredWindowPresenter(const LayeredWindowPresenter&) = delete;
+    LayeredWindowPresenter& operator=(const LayeredWindowPresenter&) = delete;
+
+    void Resize(UINT width, UINT height);
+
+    // Copies `region` of an image with the surface's size and a row pitch of
+    // its width into the surface.
+    void Upload(const uint32_t* pixels, const RECT& region);
+    // Hands the surface to the window manager; only `dirty` is recomposed
+    // after the first present at the current size.
+    void Present(const RECT& dirty);
+
+    [[nodiscard]] HDC DC() const noexcept { return m_dc; }
+    [[nodiscard]] UINT Width() const noexcept { return m_width; }
+    [[nodiscard]] UINT Height() const noexcept { return m_height; }
+
+private:
+    void ReleaseSurface();
+
+    HWND m_hwnd;
+    HDC m_dc{nullptr};
+    HBITMAP m_bitmap{nullptr};
+    HGDIOBJ m_previousBitmap{nullptr};
+    uint32_t* m_bits{nullptr};
+    UINT m_width{0};
+    UINT m_height{0};
+    bool m_presented{false};
+};
+}
@@ -0,0 +1,138 @@
+#include "Rendering/PolarHeatmap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define HEATMAP_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace Rendering;
+
+namespace
+{
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kTwoPi = 2.0f * kPi;
+
+// Soft saturation: a handful of overlapping hits reaches full intensity
+constexpr float kSaturation = 1.5f;
+
+size_t AzimuthBin(float azimuth)
+{
+    // azimuth in [-pi, pi]
+    const float normalized = (azimuth + kPi) / kTwoPi;
+    const auto bin = static_cast<size_t>(normalized * PolarHeatmap::kAzimuthBins);
+    return bin % PolarHeatmap::kAzimuthBins;
+}
+}
+
+PolarHeatmap::PolarHeatmap()
+{
+    // Precompute which bin every texture pixel samples so rasterizing is a
+    // pair of table lookups per pixel.
+    const float half = static_cast<float>(kTextureSize) / 2.0f;
+    for (size_t y = 0; y < kTextureSize; ++y)
+    {
+        for (size_t x = 0; x < kTextureSize; ++x)
+        {
+            const float dx = (static_cast<float>(x) + 0.5f - half) / half;
+            const float dy = (static_cast<float>(y) + 0.5f - half) / half;
+            const float distance = std::sqrt(dx * dx + dy * dy);
+
+            uint16_t bin = static_cast<uint16_t>(kBinCount);
+            if (distance <= 1.0f)
+            {
+                // Screen y grows downwards, radar z (front) points up
+                const size_t azimuthBin = AzimuthBin(std::atan2(dx, -dy));
+                const size_t radialBin = std::min(static_cast<size_t>(distance * kRadialBins), kRadialBins - 1);
+                bin = static_cast<uint16_t>(radialBin * kAzimuthBins + azimuthBin);
+            }
+            m_pixelBin[y * kTextureSize + x] = bin;
+        }
+    }
+
+    SetPalette(255, 255, 255, 1.0f);
+}
+
+void PolarHeatmap::Accumulate(float x, float z, float radiusFraction, float weight) noexcept
+{
+    const float fraction = std::clamp(radiusFraction, 0.0f, 1.0f);
+    const size_t radialBin = std::min(static_cast<size_t>(fraction * kRadialBins), kRadialBins - 1);
+
+    // Split the weight between the two nearest azimuth bins to avoid banding
+    const float position = (std::atan2(x, z) + kPi) / kTwoPi * kAzimuthBins - 0.5f;
+    const float floorPosition = std::floor(position);
+    const float t = position - floorPosition;
+    const auto first = static_cast<size_t>(static_cast<long>(floorPosition) + static_cast<long>(kAzimuthBins)) % kAzimuthBins;
+    const size_t second = (first + 1) % kAzimuthBins;
+
+    float* row = &m_bins[radialBin * kAzimuthBins];
+    row[first] += weight * (1.0f - t);
+    row[second] += weight * t;
+
+    m_peak = std::max({ m_peak, row[first], row[second] });
+}
+
+void PolarHeatmap::Decay(float factor) noexcept
+{
+#if defined(HEATMAP_USE_SSE2)
+    const __m128 scale = _mm_set1_ps(factor);
+    __m128 peak = _mm_setzero_ps();
+    for (size_t i = 0; i < kBinCount; i += 4)
+    {
+        const __m128 value = _mm_mul_ps(_mm_load_ps(&m_bins[i]), scale);
+        _mm_store_ps(&m_bins[i], value);
+        peak = _mm_max_ps(peak, value);
+    }
+
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, peak);
+    m_peak = std::max({ lanes[0], lanes[1], lanes[2], lanes[3] });
+#else
+    float peak = 0.0f;
+    for (auto& value : m_bins)
+    {
+        value *= factor;
+        peak = std::max(peak, value);
+    }
+    m_peak = peak;
+#endif
+}
+
+void PolarHeatmap::Clear() noexcept
+{
+    m_bins.fill(0.0f);
+    m_peak = 0.0f;
+}
+
+void PolarHeatmap::SetPalette(uint8_t r, uint8_t g, uint8_t b, float opacity) noexcept
+{
+    for (size_t i = 0; i < m_palette.size(); ++i)
+    {
+        const float alpha = std::clamp(opacity, 0.0f, 1.0f) * static_cast<float>(i) / 255.0f;
+        const auto a8 = static_cast<uint32_t>(alpha * 255.0f + 0.5f);
+        const auto r8 = static_cast<uint32_t>(r * alpha + 0.5f);
+        const auto g8 = static_cast<uint32_t>(g * alpha + 0.5f);
+        const auto b8 = static_cast<uint32_t>(b * alpha + 0.5f);
+        m_palette[i] = (a8 << 24) | (r8 << 16) | (g8 << 8) | b8;
+    }
+}
+
+const uint32_t* PolarHeatmap::Rasterize() noexcept
+{
+    for (size_t i = 0; i < kBinCount; ++i)
+    {
+        const float value = m_bins[i];
+        const float intensity = value / (value + kSaturation);
+        m_binColor[i] = static_cast<uint8_t>(std::min(intensity * 2.0f, 1.0f) * 255.0f);
+    }
+    m_binColor[kBinCount] = 0;
+
+    for (size_t i = 0; i < m_pixels.size(); ++i)
+    {
+        m_pixels[i] = m_palette[m_binColor[m_pixelBin[i]]];
+    }
+
+    return m_pixels.data();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rendering
+{
+// Angular heatmap of recent hits: a fixed azimuth x distance histogram that
+// decays exponentially every frame. Memory and per-frame cost depend only on
+// the bin and texture sizes, never on how many hits arrived.
+class PolarHeatmap
+{
+public:
+    static constexpr size_t kAzimuthBins = 64;
+    static constexpr size_t kRadialBins = 16;
+    static constexpr size_t kBinCount = kAzimuthBins * kRadialBins;
+    static constexpr size_t kTextureSize = 128; // square BGRA texture side
+    // Bins lose ~63% of their energy per time constant (seconds) and are
+    // cleared once the hottest one drops below the floor.
+    static constexpr float kDecayTimeConstant = 1.5f;
+    static constexpr float kFloor = 0.01f;
+
+    PolarHeatmap();
+
+    // x/z is the screen-space unit vector of the hit, radiusFraction its
+    // distance from the center as a fraction of the ring radius (0..1).
+    void Accumulate(float x, float z, float radiusFraction, float weight) noexcept;
+    void Decay(float factor) noexcept;
+    void Clear() noexcept;
+
+    // Color used for the hottest bins; alpha ramps with intensity up to opacity.
+    void SetPalette(uint8_t r, uint8_t g, uint8_t b, float opacity) noexcept;
+
+    // Largest bin value after the last Decay/Accumulate.
+    [[nodiscard]] float Peak() const noexcept { return m_peak; }
+
+    // Premultiplied BGRA pixels, kTextureSize * kTextureSize, row pitch kTextureSize * 4.
+    const uint32_t* Rasterize() noexcept;
+
+private:
+    alignas(16) std::array<float, kBinCount> m_bins{};
+    std::array<uint8_t, kBinCount + 1> m_binColor{}; // last entry: outside the ring
+    std::array<uint16_t, kTextureSize * kTextureSize> m_pixelBin{};
+    std::array<uint32_t, 256> m_palette{};
+    std::array<uint32_t, kTextureSize * kTextureSize> m_pixels{};
+    float m_peak{0.0f};
+};
+}
@@ -0,0 +1,44 @@
+#include "Rendering/RadarFrame.h"
+
+#include "Rendering/PolarHeatmap.h"
+
+using namespace Rendering;
+
+void Rendering::PaintRadarFrame(SoftwareRenderBackend& target, const RadarFrame& frame, const RenderRect& region)
+{
+    const RenderRect ring{ frame.center.x - frame.radius, frame.center.y - frame.radius,
+                           frame.center.x + frame.radius, frame.center.y + frame.radius };
+
+    target.PushClip(region);
+    if (frame.background)
+    {
+        target.Copy(*frame.background);
+    }
+    else
+    {
+        PaintRadarBackground(target, frame.style, frame.center, frame.radius);
+    }
+    if (frame.heatmap)
+    {
+        target.DrawImage(frame.heatmap, PolarHeatmap::kTextureSize, PolarHeatmap::kTextureSize, ring);
+    }
+    else if (frame.waterfall)
+    {
+        // Oldest column first: the head onwards, then the wrapped start
+        const size_t head = frame.waterfall->Head();
+        const float split = ring.left + (ring.right - ring.left) *
+                                            static_cast<float>(WaterfallStrip::kColumns - head) / WaterfallStrip::kColumns;
+        target.DrawImage(frame.waterfall->Pixels() + head, WaterfallStrip::kColumns - head, WaterfallStrip::kAzimuthBins,
+                         WaterfallStrip::kColumns, { ring.left, ring.top, split, ring.bottom });
+        if (head > 0)
+        {
+            target.DrawImage(frame.waterfall->Pixels(), head, WaterfallStrip::kAzimuthBins,
+                             WaterfallStrip::kColumns, { split, ring.top, ring.right, ring.bottom });
+        }
+    }
+    else if (frame.hits)
+    {
+        PaintRadarHits(target, frame.style, *frame.hits, frame.center, frame.radius, frame.distanceScale);
+    }
+    target.PopClip();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/RadarPainter.h"
+#include "Rendering/RenderBackend.h"
+#include "Rendering/SoftwareRenderBackend.h"
+#include "Rendering/WaterfallStrip.h"
+
+namespace Rendering
+{
+// Everything the software path draws for one frame, borrowed for the call.
+// At most one of hits, heatmap and waterfall is set, matching the
+// visualization mode; none leaves just the background.
+struct RadarFrame
+{
+    RadarStyle style;
+    RenderPoint center;
+    float radius{0.0f};
+    float distanceScale{1.0f};
+    // PaintRadarBackground already rendered into a surface of the target's
+    // size, copied instead of repainted; null paints it
+    const SoftwareRenderBackend* background{nullptr};
+    // Radar mode; UpdateFades must have run for this frame
+    const RadarHitBuffer* hits{nullptr};
+    // Heatmap mode: PolarHeatmap::Rasterize() while it has any heat
+    const uint32_t* heatmap{nullptr};
+    // Waterfall mode, while the strip has content
+    const WaterfallStrip* waterfall{nullptr};
+};
+
+// Repaints region of the layered window's surface: background, crosshair,
+// ring and the mode's content. Text is not included; DirectWrite draws it
+// on top after the surface is uploaded.
+void PaintRadarFrame(SoftwareRenderBackend& target, const RadarFrame& frame, const RenderRect& region);
+}
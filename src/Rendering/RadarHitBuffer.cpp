@@ -0,0 +1,197 @@
+#include "Rendering/RadarHitBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define HITBUFFER_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace Rendering;
+
+namespace
+{
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kTwoPi = 2.0f * kPi;
+
+// Birth times are re-based before float seconds lose millisecond precision
+constexpr float kRebaseSeconds = 3600.0f;
+
+// Strong > Medium > Weak > Unknown
+int PatternRank(RadarPattern pattern)
+{
+    switch (pattern)
+    {
+    case RadarPattern::Strong:
+        return 3;
+    case RadarPattern::Medium:
+        return 2;
+    case RadarPattern::Weak:
+        return 1;
+    case RadarPattern::Unknown:
+    default:
+        return 0;
+    }
+}
+}
+
+uint16_t RadarHitBuffer::BinOf(const RadarHitRecord& hit) noexcept
+{
+    const float normalized = (std::atan2(hit.x, hit.z) + kPi) / kTwoPi;
+    const size_t azimuthBin = static_cast<size_t>(normalized * kAzimuthBins) % kAzimuthBins;
+    const float radius = std::clamp(hit.radiusFactor, 0.0f, 1.0f);
+    const size_t radiusBin = std::min(static_cast<size_t>(radius * kRadiusBins), kRadiusBins - 1);
+    return static_cast<uint16_t>(radiusBin * kAzimuthBins + azimuthBin);
+}
+
+void RadarHitBuffer::Write(size_t slot, const RadarHitRecord& hit, uint16_t bin) noexcept
+{
+    m_x[slot] = hit.x;
+    m_z[slot] = hit.z;
+    m_radial[slot] = hit.radiusFactor * PatternDistanceScale(hit.pattern);
+    m_magnitude[slot] = hit.magnitude;
+    m_pattern[slot] = hit.pattern;
+    m_time[slot] = hit.time;
+    if (m_epoch == std::chrono::steady_clock::time_point{})
+    {
+        m_epoch = hit.time;
+    }
+    m_birth[slot] = std::chrono::duration<float>(hit.time - m_epoch).count();
+    m_bin[slot] = bin;
+    m_binSlot[bin] = static_cast<uint16_t>(slot);
+}
+
+void RadarHitBuffer::Push(const RadarHitRecord& hit) noexcept
+{
+    if (m_count == kCapacity)
+    {
+        // Full: drop the oldest hit to make room
+        m_tail = (m_tail + 1) & kMask;
+        --m_count;
+    }
+
+    const size_t slot = (m_tail + m_count) & kMask;
+    Write(slot, hit, BinOf(hit));
+    ++m_count;
+}
+
+void RadarHitBuffer::PushCoalesced(const RadarHitRecord& hit, std::chrono::steady_clock::duration window) noexcept
+{
+    const uint16_t bin = BinOf(hit);
+    const size_t previous = m_binSlot[bin];
+
+    // The table is never cleared, so the slot must still be in use, hold
+    // this bin and be recent enough.
+    if (!SlotInUse(previous) || m_bin[previous] != bin || hit.time - m_time[previous] > window)
+    {
+        Push(hit);
+        return;
+    }
+
+    RadarHitRecord merged = hit;
+    merged.magnitude = std::max(hit.magnitude, m_magnitude[previous]);
+    if (PatternRank(m_pattern[previous]) > PatternRank(hit.pattern))
+    {
+        merged.pattern = m_pattern[previous];
+    }
+
+    // A sustained source keeps refreshing the newest entry in place
+    const size_t newest = (m_tail + m_count - 1) & kMask;
+    if (previous == newest)
+    {
+        Write(previous, merged, bin);
+        return;
+    }
+
+    m_bin[previous] = kDeadBin;
+    m_birth[previous] = -std::numeric_limits<float>::infinity();
+    Push(merged);
+}
+
+void RadarHitBuffer::ExpireBefore(std::chrono::steady_clock::time_point cutoff) noexcept
+{
+    // Hits are stored in insertion (time) order, so expiry only ever
+    // needs to look at the tail.
+    while (m_count > 0 && m_time[m_tail] <= cutoff)
+    {
+        m_tail = (m_tail + 1) & kMask;
+        --m_count;
+    }
+}
+
+void RadarHitBuffer::Clear() noexcept
+{
+    m_tail = 0;
+    m_count = 0;
+    m_epoch = {};
+}
+
+void RadarHitBuffer::UpdateFades(std::chrono::steady_clock::time_point now, std::chrono::steady_clock::duration trail) noexcept
+{
+    if (m_count == 0)
+    {
+        return;
+    }
+
+    float nowSeconds = std::chrono::duration<float>(now - m_epoch).count();
+    if (nowSeconds > kRebaseSeconds)
+    {
+        // Rare: shift every birth so the epoch sits at now (dead stay -inf)
+        for (auto& birth : m_birth)
+        {
+            birth -= nowSeconds;
+        }
+        m_epoch = now;
+        nowSeconds = 0.0f;
+    }
+
+    const float trailSeconds = std::chrono::duration<float>(trail).count();
+    const float inverseTrail = 1.0f / trailSeconds;
+
+    // Live slots form at most two runs of the ring; each is widened to
+    // whole SIMD lanes, which only touches unused slots.
+    const size_t head = m_tail + m_count;
+    const size_t runs[2][2] = {
+        { m_tail, std::min(head, kCapacity) },
+        { 0, head > kCapacity ? head - kCapacity : 0 },
+    };
+
+    for (const auto& run : runs)
+    {
+        const size_t begin = run[0] & ~static_cast<size_t>(3);
+        const size_t end = std::min((run[1] + 3) & ~static_cast<size_t>(3), kCapacity);
+#if defined(HITBUFFER_USE_SSE2)
+        const __m128 nowV = _mm_set1_ps(nowSeconds);
+        const __m128 trailV = _mm_set1_ps(trailSeconds);
+        const __m128 inverseV = _mm_set1_ps(inverseTrail);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 expired = _mm_set1_ps(-1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        for (size_t i = begin; i < end; i += 4)
+        {
+            const __m128 age = _mm_sub_ps(nowV, _mm_load_ps(&m_birth[i]));
+            const __m128 fade = _mm_sub_ps(one, _mm_mul_ps(age, inverseV));
+            // Dead slots have an infinite age and fail the range test
+            const __m128 valid = _mm_and_ps(_mm_cmpge_ps(age, zero), _mm_cmplt_ps(age, trailV));
+            _mm_store_ps(&m_fade[i], _mm_or_ps(_mm_and_ps(valid, fade), _mm_andnot_ps(valid, expired)));
+        }
+#else
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float age = nowSeconds - m_birth[i];
+            m_fade[i] = (age >= 0.0f && age < trailSeconds) ? 1.0f - age * inverseTrail : -1.0f;
+        }
+#endif
+    }
+}
+
+bool RadarHitBuffer::Vectorized() noexcept
+{
+#if defined(HITBUFFER_USE_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
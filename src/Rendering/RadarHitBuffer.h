@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rendering
+{
+enum class RadarPattern
+{
+    Unknown = 0, // Fallback / other
+    Strong = 1,  // Sharp impulse / strong transient
+    Medium = 2,  // Rhythmic / burst-like
+    Weak = 3,    // Soft / residual
+};
+
+// Very lightweight per-pattern distance emphasis. These are not semantic
+// labels like "footstep"/"gunshot"; the multiplier applies on top of the
+// global detection range.
+constexpr float PatternDistanceScale(RadarPattern pattern) noexcept
+{
+    switch (pattern)
+    {
+    case RadarPattern::Strong:
+        return 0.7f; // Strong impulse: emphasize closer distance
+    case RadarPattern::Weak:
+        return 1.2f; // Soft / residual: slightly farther
+    case RadarPattern::Medium:
+    case RadarPattern::Unknown:
+    default:
+        return 1.0f;
+    }
+}
+
+// A single radar hit as produced by UpdateDirection. x/z is the unit
+// screen-space vector derived from azimuth/elevation at insert time.
+struct RadarHitRecord
+{
+    float x{0.0f};
+    float z{0.0f};
+    float radiusFactor{1.0f};
+    float magnitude{0.0f};
+    RadarPattern pattern{RadarPattern::Unknown};
+    std::chrono::steady_clock::time_point time;
+    // Motion at capture time; lets the renderer place the marker where the
+    // source should be when the frame is shown. Not kept in the buffer.
+    std::chrono::steady_clock::time_point captureTime;
+    float azimuthVelocity{0.0f};
+    float velocityConfidence{0.0f};
+};
+
+// Fixed-capacity ring of radar hits stored as structure-of-arrays.
+// Hits are appended at the head in time order and expire by advancing
+// the tail, so steady-state operation never allocates. When the buffer
+// is full the oldest hit is overwritten.
+//
+// PushCoalesced merges a hit into the live one in the same angle/distance
+// bin, found through a direct-mapped bin -> slot table. A merged hit that
+// is not the newest entry is moved to the head and its old slot left as a
+// dead entry, so time order (and tail-only expiry) is preserved. Live hits
+// are therefore bounded by the bin count, not by the event rate.
+//
+// Everything fixed at insert time (unit vector, pattern distance scale) is
+// stored precomputed; the only per-frame work is UpdateFades, one pass over
+// the ages of the stored hits.
+class RadarHitBuffer
+{
+public:
+    static constexpr size_t kCapacity = 1024;
+    static constexpr size_t kAzimuthBins = 64;
+    static constexpr size_t kRadiusBins = 8;
+
+    void Push(const RadarHitRecord& hit) noexcept;
+    // Merges into the bin's hit if it was refreshed within window: the
+    // result takes the new position and time, the larger magnitude and the
+    // stronger pattern. Otherwise appends like Push.
+    void PushCoalesced(const RadarHitRecord& hit, std::chrono::steady_clock::duration window) noexcept;
+    void ExpireBefore(std::chrono::steady_clock::time_point cutoff) noexcept;
+    void Clear() noexcept;
+    // Trail fade of every stored hit at now: 1 when fresh down to 0 at the
+    // end of trail, negative once expired or dead. SSE2 where available.
+    void UpdateFades(std::chrono::steady_clock::time_point now, std::chrono::steady_clock::duration trail) noexcept;
+    // Whether UpdateFades uses SSE2 rather than the scalar fallback
+    [[nodiscard]] static bool Vectorized() noexcept;
+
+    [[nodiscard]] size_t Size() const noexcept { return m_count; }
+    [[nodiscard]] bool Empty() const noexcept { return m_count == 0; }
+
+    // Accessors take a logical index: 0 is the oldest hit. Entries vacated
+    // by a merge stay in place until they expire and are not Live.
+    [[nodiscard]] bool Live(size_t index) const noexcept { return m_bin[Slot(index)] != kDeadBin; }
+    [[nodiscard]] float X(size_t index) const noexcept { return m_x[Slot(index)]; }
+    [[nodiscard]] float Z(size_t index) const noexcept { return m_z[Slot(index)]; }
+    // Distance as a fraction of the ring radius, pattern scale applied;
+    // only the global detection range remains to be multiplied in.
+    [[nodiscard]] float Radial(size_t index) const noexcept { return m_radial[Slot(index)]; }
+    [[nodiscard]] float Magnitude(size_t index) const noexcept { return m_magnitude[Slot(index)]; }
+    [[nodiscard]] RadarPattern Pattern(size_t index) const noexcept { return m_pattern[Slot(index)]; }
+    [[nodiscard]] std::chrono::steady_clock::time_point Time(size_t index) const noexcept { return m_time[Slot(index)]; }
+    // As of the last UpdateFades
+    [[nodiscard]] float Fade(size_t index) const noexcept { return m_fade[Slot(index)]; }
+
+private:
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+    static constexpr size_t kMask = kCapacity - 1;
+    static constexpr size_t kBinCount = kAzimuthBins * kRadiusBins;
+    static constexpr uint16_t kDeadBin = 0xFFFF;
+
+    [[nodiscard]] size_t Slot(size_t index) const noexcept { return (m_tail + index) & kMask; }
+    [[nodiscard]] bool SlotInUse(size_t slot) const noexcept { return ((slot - m_tail) & kMask) < m_count; }
+    static uint16_t BinOf(const RadarHitRecord& hit) noexcept;
+    void Write(size_t slot, const RadarHitRecord& hit, uint16_t bin) noexcept;
+
+    std::array<float, kCapacity> m_x{};
+    std::array<float, kCapacity> m_z{};
+    std::array<float, kCapacity> m_radial{};
+    std::array<float, kCapacity> m_magnitude{};
+    std::array<RadarPattern, kCapacity> m_pattern{};
+    std::array<std::chrono::steady_clock::time_point, kCapacity> m_time{};
+    // Insert time in seconds since m_epoch (-inf once dead) and its fade,
+    // kept as floats so the per-frame pass vectorizes
+    alignas(16) std::array<float, kCapacity> m_birth{};
+    alignas(16) std::array<float, kCapacity> m_fade{};
+    std::chrono::steady_clock::time_point m_epoch{};
+    std::array<uint16_t, kCapacity> m_bin{}; // kDeadBin once merged away
+    std::array<uint16_t, kBinCount> m_binSlot{}; // last slot written per bin; validated on use
+
+    size_t m_tail{0};
+    size_t m_count{0};
+};
+}
@@ -0,0 +1,101 @@
+#include "Rendering/RadarPainter.h"
+
+#include <algorithm>
+
+using namespace Rendering;
+
+float Rendering::HitRadiusFraction(float radiusFactor, RadarPattern pattern, float distanceScale) noexcept
+{
+    return HitRadiusFraction(radiusFactor * PatternDistanceScale(pattern), distanceScale);
+}
+
+float Rendering::HitRadiusFraction(float radial, float distanceScale) noexcept
+{
+    return std::clamp(radial * distanceScale, 0.05f, 1.0f);
+}
+
+float Rendering::HitMarkerRadius(float magnitude) noexcept
+{
+    return 4.0f + 2.0f * std::clamp(magnitude, 0.0f, kMaxHitMarkerMagnitude);
+}
+
+const RenderColor& Rendering::PatternColor(const RadarStyle& style, RadarPattern pattern) noexcept
+{
+    switch (pattern)
+    {
+    case RadarPattern::Strong:
+        return style.strong;
+    case RadarPattern::Medium:
+        return style.medium;
+    case RadarPattern::Weak:
+    case RadarPattern::Unknown:
+    default:
+        return style.weak;
+    }
+}
+
+void Rendering::PaintRadarBackground(RenderBackend& target, const RadarStyle& style, RenderPoint center, float radius)
+{
+    target.Clear(style.background);
+
+    // Crosshair
+    target.DrawLine({ center.x, center.y - radius }, { center.x, center.y + radius }, style.grid, 1.0f);
+    target.DrawLine({ center.x - radius, center.y }, { center.x + radius, center.y }, style.grid, 1.0f);
+
+    // Outer ring
+    target.DrawCircle(center, radius, style.ring, 2.5f);
+}
+
+void Rendering::PaintRadarMarker(RenderBackend& target, RadarPattern pattern, RenderPoint position, float radius, const RenderColor& color)
+{
+    switch (pattern)
+    {
+    case RadarPattern::Strong:
+        // Strong: filled circle
+        target.FillCircle(position, radius, color);
+        break;
+    case RadarPattern::Medium:
+        // Medium: square
+        target.FillRect({ position.x - radius, position.y - radius, position.x + radius, position.y + radius }, color);
+        break;
+    case RadarPattern::Weak:
+    case RadarPattern::Unknown:
+    default:
+    {
+        // Weak/other: triangle outline
+        const RenderPoint top{ position.x, position.y - radius };
+        const RenderPoint left{ position.x - radius, position.y + radius };
+        const RenderPoint right{ position.x + radius, position.y + radius };
+        target.DrawLine(top, left, color, 2.0f);
+        target.DrawLine(left, right, color, 2.0f);
+        target.DrawLine(right, top, color, 2.0f);
+        break;
+    }
+    }
+}
+
+void Rendering::PaintRadarHits(RenderBackend& target,
+                               const RadarStyle& style,
+                               const RadarHitBuffer& hits,
+                               RenderPoint center,
+                               float radius,
+                               float distanceScale)
+{
+    for (size_t i = 0; i < hits.Size(); ++i)
+    {
+        // Negative for expired and merged-away hits
+        const float fade = hits.Fade(i);
+        if (fade < 0.0f)
+        {
+            continue;
+        }
+
+        const RadarPattern pattern = hits.Pattern(i);
+        const float r = radius * HitRadiusFraction(hits.Radial(i), distanceScale);
+        const RenderPoint position{ center.x + r * hits.X(i), center.y - r * hits.Z(i) };
+
+        RenderColor color = PatternColor(style, pattern);
+        color.a *= fade;
+        PaintRadarMarker(target, pattern, position, HitMarkerRadius(hits.Magnitude(i)), color);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/RenderBackend.h"
+
+namespace Rendering
+{
+// How long a hit stays on the radar while fading out
+constexpr std::chrono::milliseconds kRadarTrailDuration{1500};
+// A sustained sound keeps refreshing one marker per angle/distance bin
+// instead of stacking a new one every router tick.
+constexpr std::chrono::milliseconds kRadarHitCoalesceWindow{250};
+// The analyzer does not bound magnitude; louder hits all get the largest
+// marker, HitMarkerRadius(kMaxHitMarkerMagnitude)
+constexpr float kMaxHitMarkerMagnitude = 2.0f;
+constexpr float kMaxHitMarkerRadius = 8.0f;
+// How far the triangle outline reaches past the marker radius
+constexpr float kHitMarkerStrokePad = 1.5f;
+// Markers may sit on the ring and extend past it by their full extent plus
+// an anti-aliased pixel, so the radar's dirty rectangle is the ring's
+// bounds grown by this much
+constexpr float kRadarMarkerPadding = kMaxHitMarkerRadius + kHitMarkerStrokePad + 1.0f;
+
+// Theme-derived colors for the radar, independent of the drawing backend.
+struct RadarStyle
+{
+    RenderColor background{0.05f, 0.05f, 0.07f, 0.85f};
+    RenderColor grid{0.3f, 0.3f, 0.35f, 0.7f};
+    RenderColor ring{1.0f, 1.0f, 1.0f, 0.6f};
+    RenderColor strong{0.95f, 0.25f, 0.25f, 1.0f};
+    RenderColor medium{0.25f, 0.55f, 0.95f, 1.0f};
+    RenderColor weak{0.30f, 0.85f, 0.40f, 1.0f};
+};
+
+// Shared hit layout, so every backend places and sizes markers identically.
+[[nodiscard]] float HitRadiusFraction(float radiusFactor, RadarPattern pattern, float distanceScale) noexcept;
+// Same, for a radial that already has the pattern scale applied (RadarHitBuffer::Radial).
+[[nodiscard]] float HitRadiusFraction(float radial, float distanceScale) noexcept;
+// 4 px plus 2 px per unit of magnitude, up to kMaxHitMarkerRadius
+[[nodiscard]] float HitMarkerRadius(float magnitude) noexcept;
+[[nodiscard]] const RenderColor& PatternColor(const RadarStyle& style, RadarPattern pattern) noexcept;
+
+// Background, crosshair and outer ring.
+void PaintRadarBackground(RenderBackend& target, const RadarStyle& style, RenderPoint center, float radius);
+// One marker: Strong is a filled circle, Medium a square, Weak/Unknown a triangle outline.
+void PaintRadarMarker(RenderBackend& target, RadarPattern pattern, RenderPoint position, float radius, const RenderColor& color);
+// Every live hit with its trail fade applied; hits.UpdateFades must have
+// run for this frame.
+void PaintRadarHits(RenderBackend& target,
+                    const RadarStyle& style,
+                    const RadarHitBuffer& hits,
+                    RenderPoint center,
+                    float radius,
+                    float distanceScale);
+}
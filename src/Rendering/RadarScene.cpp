@@ -0,0 +1,104 @@
+#include "Rendering/RadarScene.h"
+
+#include "Rendering/RadarPainter.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Rendering;
+
+bool RadarScene::SetMode(Config::VisualizationMode mode) noexcept
+{
+    if (mode == m_mode)
+    {
+        return false;
+    }
+    m_mode = mode;
+    m_heatmap.Clear();
+    m_waterfall.Clear();
+    return true;
+}
+
+void RadarScene::Add(const RadarHitRecord& hit, float distanceScale) noexcept
+{
+    m_added = true;
+    m_hits.PushCoalesced(hit, kRadarHitCoalesceWindow);
+    if (m_mode == Config::VisualizationMode::Heatmap)
+    {
+        m_heatmap.Accumulate(hit.x, hit.z, HitRadiusFraction(hit.radiusFactor, hit.pattern, distanceScale),
+                             0.5f + hit.magnitude);
+    }
+    else if (m_mode == Config::VisualizationMode::Waterfall)
+    {
+        m_waterfall.Accumulate(hit.x, hit.z, 0.5f + hit.magnitude);
+    }
+}
+
+RadarSceneUpdate RadarScene::Advance(std::chrono::steady_clock::time_point now) noexcept
+{
+    // Expire by advancing the tail; hits are kept in time order
+    m_hits.ExpireBefore(now - kRadarTrailDuration);
+    m_hits.UpdateFades(now, kRadarTrailDuration);
+
+    const bool added = m_added;
+    m_added = false;
+
+    // Tracked in every mode, so switching to the heatmap does not decay its
+    // first hits by the time spent in another mode
+    const auto previous = m_lastDecay;
+    m_lastDecay = now;
+
+    RadarSceneUpdate update;
+    bool content = false;
+    if (m_mode == Config::VisualizationMode::Waterfall)
+    {
+        // New hits wait in the column being collected
+        update.waterfallColumns = m_waterfall.Advance(now);
+        content = m_waterfall.HasContent();
+        update.dirty = update.waterfallColumns > 0 && (content || m_hadContent);
+    }
+    else
+    {
+        if (m_mode == Config::VisualizationMode::Heatmap)
+        {
+            const float dt = previous == std::chrono::steady_clock::time_point{}
+                                 ? 0.0f
+                                 : std::max(0.0f, std::chrono::duration<float>(now - previous).count());
+            if (m_heatmap.Peak() > 0.0f)
+            {
+                m_heatmap.Decay(std::exp(-dt / PolarHeatmap::kDecayTimeConstant));
+                if (m_heatmap.Peak() < PolarHeatmap::kFloor)
+                {
+                    m_heatmap.Clear();
+                }
+            }
+            content = m_heatmap.Peak() > 0.0f;
+        }
+        else
+        {
+            content = !m_hits.Empty();
+        }
+        update.dirty = added || content || m_hadContent;
+    }
+    m_hadContent = content;
+    return update;
+}
+
+void RadarScene::Fill(RadarFrame& frame) noexcept
+{
+    frame.hits = nullptr;
+    frame.heatmap = nullptr;
+    frame.waterfall = nullptr;
+    if (m_mode == Config::VisualizationMode::Heatmap)
+    {
+        frame.heatmap = m_heatmap.Peak() > 0.0f ? m_heatmap.Rasterize() : nullptr;
+    }
+    else if (m_mode == Config::VisualizationMode::Waterfall)
+    {
+        frame.waterfall = m_waterfall.HasContent() ? &m_waterfall : nullptr;
+    }
+    else
+    {
+        frame.hits = &m_hits;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "Config/ConfigManager.h"
+#include "Rendering/PolarHeatmap.h"
+#include "Rendering/RadarFrame.h"
+#include "Rendering/RadarHitBuffer.h"
+#include "Rendering/WaterfallStrip.h"
+
+namespace Rendering
+{
+// What changed in the radar's content since the previous Advance
+struct RadarSceneUpdate
+{
+    // The ring needs repainting this frame
+    bool dirty{false};
+    // Waterfall columns committed by this Advance; the strip only moves then
+    size_t waterfallColumns{0};
+};
+
+// The radar's time-varying content for the drawn visualization mode: the
+// hit trail, the heatmap or the waterfall. Hits are added as they are
+// drained and everything is advanced once per frame, which also decides
+// whether the ring changed. Has no drawing dependencies, so the render
+// benchmark advances it exactly as DirectionVisualizer::Render does.
+class RadarScene
+{
+public:
+    // Switching modes drops the heatmap's and the waterfall's history.
+    // Returns whether the mode changed.
+    bool SetMode(Config::VisualizationMode mode) noexcept;
+    [[nodiscard]] Config::VisualizationMode Mode() const noexcept { return m_mode; }
+
+    // Adds a classified hit to the trail and to the mode's heatmap or waterfall
+    void Add(const RadarHitRecord& hit, float distanceScale) noexcept;
+
+    // Expires and fades the trail, decays the heatmap or commits waterfall
+    // columns. A change is dirty while there is content, on the frame that
+    // adds hits and on the one after the last content is gone, so it can
+    // be erased.
+    RadarSceneUpdate Advance(std::chrono::steady_clock::time_point now) noexcept;
+
+    // Points frame at the mode's content, or at nothing when it is empty
+    void Fill(RadarFrame& frame) noexcept;
+
+    [[nodiscard]] const RadarHitBuffer& Hits() const noexcept { return m_hits; }
+    [[nodiscard]] PolarHeatmap& Heatmap() noexcept { return m_heatmap; }
+    [[nodiscard]] WaterfallStrip& Waterfall() noexcept { return m_waterfall; }
+
+private:
+    Config::VisualizationMode m_mode{Config::VisualizationMode::Radar};
+    RadarHitBuffer m_hits;
+    PolarHeatmap m_heatmap;
+    WaterfallStrip m_waterfall;
+    std::chrono::steady_clock::time_point m_lastDecay;
+    bool m_added{false};
+    bool m_hadContent{false};
+};
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace Rendering
+{
+struct RenderColor
+{
+    float r{0.0f};
+    float g{0.0f};
+    float b{0.0f};
+    float a{1.0f};
+};
+
+struct RenderPoint
+{
+    float x{0.0f};
+    float y{0.0f};
+};
+
+struct RenderRect
+{
+    float left{0.0f};
+    float top{0.0f};
+    float right{0.0f};
+    float bottom{0.0f};
+};
+
+// Immediate-mode drawing surface for the radar. Colors are straight
+// (non-premultiplied) alpha; coordinates are pixels with the origin at the
+// top-left. Implemented by Direct2D and by a portable software rasterizer.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    // Replaces every pixel inside the current clip.
+    virtual void Clear(const RenderColor& color) = 0;
+    virtual void DrawLine(RenderPoint from, RenderPoint to, const RenderColor& color, float width) = 0;
+    virtual void DrawCircle(RenderPoint center, float radius, const RenderColor& color, float width) = 0;
+    virtual void FillCircle(RenderPoint center, float radius, const RenderColor& color) = 0;
+    virtual void FillRect(const RenderRect& rect, const RenderColor& color) = 0;
+    virtual void PushClip(const RenderRect& rect) = 0;
+    virtual void PopClip() = 0;
+};
+}
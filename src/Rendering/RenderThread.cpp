@@ -0,0 +1,174 @@
+#include "Rendering/RenderThread.h"
+
+#include "Diagnostics/TraceRecorder.h"
+#include "Rendering/DirectionVisualizer.h"
+#include "Rendering/FrameClock.h"
+
+#include <windows.h>
+#include <Psapi.h>
+
+#include <cmath>
+#include <exception>
+#include <thread>
+
+using namespace Rendering;
+
+namespace
+{
+constexpr auto kDeviceRetryDelay = std::chrono::seconds(1);
+
+ULONGLONG ProcessCpuTime()
+{
+    FILETIME creation{}, exit{}, kernel{}, user{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    {
+        return 0;
+    }
+    const ULARGE_INTEGER k{ kernel.dwLowDateTime, kernel.dwHighDateTime };
+    const ULARGE_INTEGER u{ user.dwLowDateTime, user.dwHighDateTime };
+    return k.QuadPart + u.QuadPart; // 100 ns units
+}
+
+size_t WorkingSetKb()
+{
+    PROCESS_MEMORY_COUNTERS counters{};
+    counters.cb = sizeof(counters);
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.WorkingSetSize / 1024;
+}
+}
+
+RenderThread::RenderThread(DirectionVisualizer* visualizer, std::unique_ptr<FrameClock> clock)
+    : m_visualizer(visualizer)
+    , m_clock(std::move(clock))
+    , m_hiddenCpu(Diagnostics::MetricsRegistry::Instance().GetGauge("render.hidden_cpu"))
+    , m_hiddenWorkingSet(Diagnostics::MetricsRegistry::Instance().GetGauge("render.hidden_working_set_kb"))
+{
+}
+
+RenderThread::~RenderThread()
+{
+    Stop();
+}
+
+void RenderThread::Start()
+{
+    if (m_running.exchange(true))
+    {
+        return;
+    }
+
+    m_thread = Util::NamedThread("render", &RenderThread::Run, this);
+}
+
+void RenderThread::Stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock lock{m_pauseMutex};
+    }
+    m_pauseChanged.notify_one();
+
+    if (m_thread.joinable())
+    {
+        // Re-layering the window sends it messages, which the window's
+        // thread - usually this one - has to keep dispatching until the
+        // render thread has finished
+        const HANDLE thread = m_thread.native_handle();
+        while (MsgWaitForMultipleObjects(1, &thread, FALSE, INFINITE, QS_SENDMESSAGE) == WAIT_OBJECT_0 + 1)
+        {
+            MSG message;
+            PeekMessageW(&message, nullptr, 0, 0, PM_NOREMOVE | PM_QS_SENDMESSAGE);
+        }
+        m_thread.join();
+    }
+}
+
+void RenderThread::Pause(bool trimWorkingSet)
+{
+    std::scoped_lock lock{m_pauseMutex};
+    m_trimWorkingSet = trimWorkingSet;
+    m_paused.store(true, std::memory_order_release);
+}
+
+void RenderThread::Resume()
+{
+    {
+        std::scoped_lock lock{m_pauseMutex};
+        m_paused.store(false, std::memory_order_release);
+    }
+    m_pauseChanged.notify_one();
+}
+
+void RenderThread::Run()
+{
+    TRACE_THREAD_NAME("render");
+    bool resumed = false;
+    while (m_running.load(std::memory_order_acquire))
+    {
+        if (m_paused.load(std::memory_order_acquire))
+        {
+            Hibernate();
+            resumed = true;
+            continue;
+        }
+
+        if (!resumed)
+        {
+            m_clock->WaitForNextFrame();
+        }
+        resumed = false;
+
+        try
+        {
+            m_visualizer->Render();
+        }
+        catch (const std::exception& ex)
+        {
+            // Device creation or drawing failed; rebuild the device shortly
+            OutputDebugStringA(ex.what());
+            OutputDebugStringA("\n");
+            m_visualizer->RequestDeviceReset();
+            std::this_thread::sleep_for(kDeviceRetryDelay);
+        }
+    }
+
+    m_visualizer->ReleaseDeviceResources();
+}
+
+void RenderThread::Hibernate()
+{
+    // Device resources are rebuilt by the first Render after resuming
+    m_visualizer->ReleaseDeviceResources();
+    m_visualizer->RequestDeviceReset();
+
+    std::unique_lock lock{m_pauseMutex};
+    if (m_trimWorkingSet)
+    {
+        SetProcessWorkingSetSize(GetCurrentProcess(), static_cast<SIZE_T>(-1), static_cast<SIZE_T>(-1));
+    }
+
+    const auto hiddenAt = std::chrono::steady_clock::now();
+    const ULONGLONG cpuAtHide = ProcessCpuTime();
+    m_hiddenWorkingSet.Set(static_cast<int64_t>(WorkingSetKb()));
+
+    m_pauseChanged.wait(lock, [this] {
+        return !m_paused.load(std::memory_order_acquire) || !m_running.load(std::memory_order_acquire);
+    });
+
+    // Whole-process cost while hidden: what the audio path still spends
+    // once rendering is out of the picture.
+    const double hiddenSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hiddenAt).count();
+    if (hiddenSeconds > 0.0)
+    {
+        const double cpuSeconds = static_cast<double>(ProcessCpuTime() - cpuAtHide) / 1e7;
+        m_hiddenCpu.Set(static_cast<int64_t>(std::lround(10000.0 * cpuSeconds / hiddenSeconds)));
+    }
+}
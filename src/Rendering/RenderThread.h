@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "Diagnostics/MetricsRegistry.h"
+#include "Util/NamedThread.h"
+
+namespace Rendering
+{
+class DirectionVisualizer;
+class FrameClock;
+
+// Owns the render loop: waits on the frame clock, then lets the visualizer
+// draw. All device resources live on this thread; other threads talk to
+// the visualizer only through its thread-safe request API.
+class RenderThread
+{
+public:
+    RenderThread(DirectionVisualizer* visualizer, std::unique_ptr<FrameClock> clock);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    void Start();
+    void Stop();
+
+    // While paused the thread releases every device resource and blocks
+    // without waking. Trimming the working set pages out what is left.
+    // The cost of being hidden goes to the render.hidden_* gauges.
+    void Pause(bool trimWorkingSet);
+    // The first frame after resuming draws immediately, without waiting
+    // for the frame clock.
+    void Resume();
+
+private:
+    void Run();
+    void Hibernate();
+
+    DirectionVisualizer* m_visualizer;
+    std::unique_ptr<FrameClock> m_clock;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_paused{false};
+    bool m_trimWorkingSet{false}; // guarded by m_pauseMutex
+    std::mutex m_pauseMutex;
+    std::condition_variable m_pauseChanged;
+    // Last hidden span: process CPU in hundredths of a percent of one core
+    // (set on resume) and working set once hidden (set on pausing)
+    Diagnostics::Gauge& m_hiddenCpu;
+    Diagnostics::Gauge& m_hiddenWorkingSet;
+    Util::NamedThread m_thread;
+};
+}
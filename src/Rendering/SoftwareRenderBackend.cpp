@@ -0,0 +1,345 @@
+#include "Rendering/SoftwareRenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SOFTWARE_BACKEND_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace Rendering;
+
+namespace
+{
+uint32_t PackPremultiplied(const RenderColor& color)
+{
+    const float alpha = std::clamp(color.a, 0.0f, 1.0f);
+    const auto a = static_cast<uint32_t>(alpha * 255.0f + 0.5f);
+    const auto r = static_cast<uint32_t>(std::clamp(color.r, 0.0f, 1.0f) * alpha * 255.0f + 0.5f);
+    const auto g = static_cast<uint32_t>(std::clamp(color.g, 0.0f, 1.0f) * alpha * 255.0f + 0.5f);
+    const auto b = static_cast<uint32_t>(std::clamp(color.b, 0.0f, 1.0f) * alpha * 255.0f + 0.5f);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+// Coverage of a pixel whose center is `distance` inside an edge, with a
+// one pixel wide linear ramp across the edge.
+float EdgeCoverage(float distance)
+{
+    return std::clamp(distance + 0.5f, 0.0f, 1.0f);
+}
+
+// Coverage of a ring of the given radius and half width for `count`
+// consecutive pixels whose first center is dx0 from the circle center.
+// A ring of radius 0 and half width r is a filled disc of radius r.
+void RingCoverageRow(float* out, size_t count, float dx0, float dy, float ringRadius, float halfWidth)
+{
+    const float dy2 = dy * dy;
+    size_t i = 0;
+
+#if defined(SOFTWARE_BACKEND_USE_SSE2)
+    const __m128 vdy2 = _mm_set1_ps(dy2);
+    const __m128 vradius = _mm_set1_ps(ringRadius);
+    const __m128 vedge = _mm_set1_ps(halfWidth + 0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 step = _mm_set1_ps(4.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 dx = _mm_add_ps(_mm_set1_ps(dx0), _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), vdy2));
+        const __m128 offset = _mm_andnot_ps(signMask, _mm_sub_ps(distance, vradius));
+        const __m128 coverage = _mm_min_ps(_mm_max_ps(_mm_sub_ps(vedge, offset), zero), one);
+        _mm_storeu_ps(out + i, coverage);
+        dx = _mm_add_ps(dx, step);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const float dx = dx0 + static_cast<float>(i);
+        const float distance = std::sqrt(dx * dx + dy2);
+        out[i] = EdgeCoverage(halfWidth - std::fabs(distance - ringRadius));
+    }
+}
+
+// Source-over of a solid color scaled by per-pixel coverage onto
+// premultiplied pixels: dst = src * coverage + dst * (1 - srcAlpha * coverage)
+void BlendSolidSpan(uint32_t* dst, const float* coverage, size_t count, const RenderColor& color)
+{
+    const float alpha = std::clamp(color.a, 0.0f, 1.0f);
+    const float r = std::clamp(color.r, 0.0f, 1.0f) * 255.0f;
+    const float g = std::clamp(color.g, 0.0f, 1.0f) * 255.0f;
+    const float b = std::clamp(color.b, 0.0f, 1.0f) * 255.0f;
+    size_t i = 0;
+
+#if defined(SOFTWARE_BACKEND_USE_SSE2)
+    const __m128 vr = _mm_set1_ps(r);
+    const __m128 vg = _mm_set1_ps(g);
+    const __m128 vb = _mm_set1_ps(b);
+    const __m128 valpha = _mm_set1_ps(alpha);
+    const __m128 v255 = _mm_set1_ps(255.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 a = _mm_mul_ps(valpha, _mm_loadu_ps(coverage + i));
+        const __m128 inverse = _mm_sub_ps(one, a);
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+        const __m128 db = _mm_cvtepi32_ps(_mm_and_si128(d, mask));
+        const __m128 dg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, 8), mask));
+        const __m128 dr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, 16), mask));
+        const __m128 da = _mm_cvtepi32_ps(_mm_srli_epi32(d, 24));
+
+        const __m128i ob = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(vb, a), _mm_mul_ps(db, inverse)));
+        const __m128i og = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(vg, a), _mm_mul_ps(dg, inverse)));
+        const __m128i orr = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(vr, a), _mm_mul_ps(dr, inverse)));
+        const __m128i oa = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(v255, a), _mm_mul_ps(da, inverse)));
+
+        const __m128i out = _mm_or_si128(_mm_or_si128(ob, _mm_slli_epi32(og, 8)),
+                                         _mm_or_si128(_mm_slli_epi32(orr, 16), _mm_slli_epi32(oa, 24)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), out);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const float a = alpha * coverage[i];
+        const float inverse = 1.0f - a;
+        const uint32_t d = dst[i];
+        const auto ob = static_cast<uint32_t>(b * a + static_cast<float>(d & 0xFF) * inverse + 0.5f);
+        const auto og = static_cast<uint32_t>(g * a + static_cast<float>((d >> 8) & 0xFF) * inverse + 0.5f);
+        const auto orr = static_cast<uint32_t>(r * a + static_cast<float>((d >> 16) & 0xFF) * inverse + 0.5f);
+        const auto oa = static_cast<uint32_t>(255.0f * a + static_cast<float>(d >> 24) * inverse + 0.5f);
+        dst[i] = ob | (og << 8) | (orr << 16) | (oa << 24);
+    }
+}
+
+// Source-over of premultiplied pixels: dst = src + dst * (1 - srcAlpha)
+void BlendPremultipliedSpan(uint32_t* dst, const uint32_t* src, size_t count)
+{
+    size_t i = 0;
+
+#if defined(SOFTWARE_BACKEND_USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+        // Broadcast 255 - srcAlpha to every channel of its pixel, 16 bits per channel
+        __m128i inverse = _mm_srli_epi32(s, 24);
+        inverse = _mm_or_si128(inverse, _mm_slli_epi32(inverse, 16));
+        inverse = _mm_or_si128(inverse, _mm_slli_epi32(inverse, 8));
+        inverse = _mm_andnot_si128(inverse, _mm_set1_epi32(-1));
+
+        auto blendHalf = [&](__m128i dHalf, __m128i invHalf)
+        {
+            // (d * inv + 128) * 257 >> 16 == round(d * inv / 255)
+            __m128i product = _mm_add_epi16(_mm_mullo_epi16(dHalf, invHalf), round);
+            product = _mm_add_epi16(product, _mm_srli_epi16(product, 8));
+            return _mm_srli_epi16(product, 8);
+        };
+
+        const __m128i lo = blendHalf(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(inverse, zero));
+        const __m128i hi = blendHalf(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(inverse, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const uint32_t s = src[i];
+        const uint32_t d = dst[i];
+        const uint32_t inverse = 255 - (s >> 24);
+        uint32_t result = 0;
+        for (uint32_t shift = 0; shift < 32; shift += 8)
+        {
+            const uint32_t channel = ((s >> shift) & 0xFF) + (((d >> shift) & 0xFF) * inverse + 127) / 255;
+            result |= std::min<uint32_t>(channel, 255) << shift;
+        }
+        dst[i] = result;
+    }
+}
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(size_t width, size_t height)
+{
+    Resize(width, height);
+}
+
+void SoftwareRenderBackend::Resize(size_t width, size_t height)
+{
+    m_width = width;
+    m_height = height;
+    m_pixels.assign(width * height, 0);
+    m_coverage.assign(width, 0.0f);
+    m_imageRow.assign(width, 0);
+    m_clips.clear();
+}
+
+void SoftwareRenderBackend::Clear(const RenderColor& color)
+{
+    const PixelRect bounds = ClipBounds(0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height));
+    const uint32_t value = PackPremultiplied(color);
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        uint32_t* row = Row(y);
+        std::fill(row + bounds.left, row + bounds.right, value);
+    }
+}
+
+void SoftwareRenderBackend::DrawLine(RenderPoint from, RenderPoint to, const RenderColor& color, float width)
+{
+    const float halfWidth = width / 2.0f;
+    const PixelRect bounds = ClipBounds(std::min(from.x, to.x) - halfWidth - 1.0f,
+                                        std::min(from.y, to.y) - halfWidth - 1.0f,
+                                        std::max(from.x, to.x) + halfWidth + 1.0f,
+                                        std::max(from.y, to.y) + halfWidth + 1.0f);
+    const auto count = static_cast<size_t>(bounds.right - bounds.left);
+
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float lengthSquared = dx * dx + dy * dy;
+
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        const float py = static_cast<float>(y) + 0.5f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float px = static_cast<float>(bounds.left + static_cast<int>(i)) + 0.5f;
+
+            // Distance from the pixel center to the segment
+            float t = lengthSquared > 0.0f ? ((px - from.x) * dx + (py - from.y) * dy) / lengthSquared : 0.0f;
+            t = std::clamp(t, 0.0f, 1.0f);
+            const float ex = px - (from.x + t * dx);
+            const float ey = py - (from.y + t * dy);
+            m_coverage[i] = EdgeCoverage(halfWidth - std::sqrt(ex * ex + ey * ey));
+        }
+        BlendSolidSpan(Row(y) + bounds.left, m_coverage.data(), count, color);
+    }
+}
+
+void SoftwareRenderBackend::DrawCircle(RenderPoint center, float radius, const RenderColor& color, float width)
+{
+    FillRing(center, radius, width / 2.0f, color);
+}
+
+void SoftwareRenderBackend::FillCircle(RenderPoint center, float radius, const RenderColor& color)
+{
+    FillRing(center, 0.0f, radius, color);
+}
+
+void SoftwareRenderBackend::FillRing(RenderPoint center, float ringRadius, float halfWidth, const RenderColor& color)
+{
+    const float extent = ringRadius + halfWidth + 1.0f;
+    const PixelRect bounds = ClipBounds(center.x - extent, center.y - extent, center.x + extent, center.y + extent);
+    const auto count = static_cast<size_t>(bounds.right - bounds.left);
+    const float dx0 = static_cast<float>(bounds.left) + 0.5f - center.x;
+
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        const float dy = static_cast<float>(y) + 0.5f - center.y;
+        RingCoverageRow(m_coverage.data(), count, dx0, dy, ringRadius, halfWidth);
+        BlendSolidSpan(Row(y) + bounds.left, m_coverage.data(), count, color);
+    }
+}
+
+void SoftwareRenderBackend::FillRect(const RenderRect& rect, const RenderColor& color)
+{
+    // Pixel-center sampling: a pixel is covered when its center is inside
+    const PixelRect bounds = ClipBounds(rect.left + 0.5f, rect.top + 0.5f, rect.right + 0.5f, rect.bottom + 0.5f);
+    const auto count = static_cast<size_t>(bounds.right - bounds.left);
+    std::fill(m_coverage.begin(), m_coverage.begin() + count, 1.0f);
+
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        BlendSolidSpan(Row(y) + bounds.left, m_coverage.data(), count, color);
+    }
+}
+
+void SoftwareRenderBackend::DrawImage(const uint32_t* pixels, size_t width, size_t height, size_t pitch, const RenderRect& dest)
+{
+    const float destWidth = dest.right - dest.left;
+    const float destHeight = dest.bottom - dest.top;
+    if (width == 0 || height == 0 || destWidth <= 0.0f || destHeight <= 0.0f)
+    {
+        return;
+    }
+
+    const PixelRect bounds = ClipBounds(dest.left + 0.5f, dest.top + 0.5f, dest.right + 0.5f, dest.bottom + 0.5f);
+    const auto count = static_cast<size_t>(bounds.right - bounds.left);
+    const float scaleX = static_cast<float>(width) / destWidth;
+    const float scaleY = static_cast<float>(height) / destHeight;
+
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        const auto sy = std::min(static_cast<size_t>((static_cast<float>(y) + 0.5f - dest.top) * scaleY), height - 1);
+        const uint32_t* source = pixels + sy * pitch;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float x = static_cast<float>(bounds.left + static_cast<int>(i)) + 0.5f;
+            m_imageRow[i] = source[std::min(static_cast<size_t>((x - dest.left) * scaleX), width - 1)];
+        }
+        BlendPremultipliedSpan(Row(y) + bounds.left, m_imageRow.data(), count);
+    }
+}
+
+bool SoftwareRenderBackend::Vectorized() noexcept
+{
+#if defined(SOFTWARE_BACKEND_USE_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SoftwareRenderBackend::Copy(const SoftwareRenderBackend& source)
+{
+    if (source.m_width != m_width || source.m_height != m_height)
+    {
+        return;
+    }
+
+    const PixelRect bounds = ClipBounds(0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height));
+    for (int y = bounds.top; y < bounds.bottom; ++y)
+    {
+        const uint32_t* from = &source.m_pixels[static_cast<size_t>(y) * m_width];
+        std::copy(from + bounds.left, from + bounds.right, Row(y) + bounds.left);
+    }
+}
+
+void SoftwareRenderBackend::PushClip(const RenderRect& rect)
+{
+    // Aliased clip like Direct2D's PushAxisAlignedClip: whole pixels only
+    m_clips.push_back(ClipBounds(rect.left + 0.5f, rect.top + 0.5f, rect.right + 0.5f, rect.bottom + 0.5f));
+}
+
+void SoftwareRenderBackend::PopClip()
+{
+    if (!m_clips.empty())
+    {
+        m_clips.pop_back();
+    }
+}
+
+SoftwareRenderBackend::PixelRect SoftwareRenderBackend::ClipBounds(float left, float top, float right, float bottom) const noexcept
+{
+    PixelRect clip{ 0, 0, static_cast<int>(m_width), static_cast<int>(m_height) };
+    if (!m_clips.empty())
+    {
+        clip = m_clips.back();
+    }
+
+    PixelRect bounds;
+    bounds.left = std::max(clip.left, static_cast<int>(std::floor(left)));
+    bounds.top = std::max(clip.top, static_cast<int>(std::floor(top)));
+    bounds.right = std::min(clip.right, static_cast<int>(std::floor(right)));
+    bounds.bottom = std::min(clip.bottom, static_cast<int>(std::floor(bottom)));
+    bounds.right = std::max(bounds.right, bounds.left);
+    bounds.bottom = std::max(bounds.bottom, bounds.top);
+    return bounds;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Rendering/RenderBackend.h"
+
+namespace Rendering
+{
+// CPU rasterizer into a premultiplied 32-bit BGRA surface (the layout
+// Direct2D, GDI and UpdateLayeredWindow use), with analytic anti-aliasing
+// on circle and line edges. Each primitive computes one row of coverage at
+// a time and blends it with SSE2 where available. Has no platform
+// dependencies, so the radar can be rendered headless.
+class SoftwareRenderBackend final : public RenderBackend
+{
+public:
+    SoftwareRenderBackend(size_t width, size_t height);
+
+    void Resize(size_t width, size_t height);
+
+    void Clear(const RenderColor& color) override;
+    void DrawLine(RenderPoint from, RenderPoint to, const RenderColor& color, float width) override;
+    void DrawCircle(RenderPoint center, float radius, const RenderColor& color, float width) override;
+    void FillCircle(RenderPoint center, float radius, const RenderColor& color) override;
+    void FillRect(const RenderRect& rect, const RenderColor& color) override;
+    void PushClip(const RenderRect& rect) override;
+    void PopClip() override;
+
+    // Source-over blit of a premultiplied BGRA image scaled (nearest
+    // neighbour) into dest. pitch is the source row length in pixels, so a
+    // sub-rectangle of a larger image can be blitted in place.
+    void DrawImage(const uint32_t* pixels, size_t width, size_t height, size_t pitch, const RenderRect& dest);
+    void DrawImage(const uint32_t* pixels, size_t width, size_t height, const RenderRect& dest)
+    {
+        DrawImage(pixels, width, height, width, dest);
+    }
+
+    // Replaces the pixels inside the clip with source's, without blending.
+    // source must be the same size; used to restore a cached static layer.
+    void Copy(const SoftwareRenderBackend& source);
+
+    // Whether spans are blended with SSE2 rather than the scalar fallback
+    [[nodiscard]] static bool Vectorized() noexcept;
+
+    [[nodiscard]] size_t Width() const noexcept { return m_width; }
+    [[nodiscard]] size_t Height() const noexcept { return m_height; }
+    // Row pitch is Width() pixels; each pixel is 0xAARRGGBB, premultiplied.
+    [[nodiscard]] const uint32_t* Pixels() const noexcept { return m_pixels.data(); }
+
+private:
+    struct PixelRect
+    {
+        int left{0};
+        int top{0};
+        int right{0}; // exclusive
+        int bottom{0}; // exclusive
+    };
+
+    // Pixel bounds of a float rectangle, intersected with the current clip.
+    [[nodiscard]] PixelRect ClipBounds(float left, float top, float right, float bottom) const noexcept;
+    void FillRing(RenderPoint center, float ringRadius, float halfWidth, const RenderColor& color);
+    [[nodiscard]] uint32_t* Row(int y) noexcept { return &m_pixels[static_cast<size_t>(y) * m_width]; }
+
+    size_t m_width{0};
+    size_t m_height{0};
+    std::vector<uint32_t> m_pixels;
+    std::vector<float> m_coverage; // one row of per-pixel coverage
+    std::vector<uint32_t> m_imageRow; // one row of scaled image pixels
+    std::vector<PixelRect> m_clips;
+};
+}
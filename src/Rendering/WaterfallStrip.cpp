@@ -0,0 +1,121 @@
+#include "Rendering/WaterfallStrip.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Rendering;
+
+namespace
+{
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kTwoPi = 2.0f * kPi;
+
+// Soft saturation: a couple of hits in one bin and period reach full intensity
+constexpr float kSaturation = 1.5f;
+}
+
+WaterfallStrip::WaterfallStrip()
+{
+    SetPalette(255, 255, 255, 1.0f);
+}
+
+void WaterfallStrip::Accumulate(float x, float z, float weight) noexcept
+{
+    // Row 0 is straight behind on the left, the middle row is front. Split
+    // the weight between the two nearest rows to avoid banding.
+    const float position = (std::atan2(x, z) + kPi) / kTwoPi * kAzimuthBins - 0.5f;
+    const float floorPosition = std::floor(position);
+    const float t = position - floorPosition;
+    const auto first = static_cast<size_t>(static_cast<long>(floorPosition) + static_cast<long>(kAzimuthBins)) % kAzimuthBins;
+    const size_t second = (first + 1) % kAzimuthBins;
+
+    m_pending[first] += weight * (1.0f - t);
+    m_pending[second] += weight * t;
+    m_pendingLit = true;
+}
+
+size_t WaterfallStrip::Advance(std::chrono::steady_clock::time_point now) noexcept
+{
+    if (m_nextColumn == std::chrono::steady_clock::time_point{})
+    {
+        m_nextColumn = now + kColumnPeriod;
+        return 0;
+    }
+    if (now < m_nextColumn)
+    {
+        return 0;
+    }
+
+    // After a long gap (hidden overlay, device reset) the whole history is
+    // stale; rewriting it once is the most any frame ever pays.
+    const auto elapsed = static_cast<size_t>((now - m_nextColumn) / kColumnPeriod) + 1;
+    const size_t written = std::min(elapsed, kColumns);
+    for (size_t i = 0; i < written; ++i)
+    {
+        CommitColumn();
+    }
+
+    if (elapsed > kColumns)
+    {
+        m_nextColumn = now + kColumnPeriod;
+    }
+    else
+    {
+        m_nextColumn += kColumnPeriod * static_cast<long long>(elapsed);
+    }
+    return written;
+}
+
+void WaterfallStrip::CommitColumn() noexcept
+{
+    const size_t column = m_head;
+    m_litColumns -= m_columnLit[column] ? 1 : 0;
+    m_columnLit[column] = m_pendingLit;
+    m_litColumns += m_pendingLit ? 1 : 0;
+
+    uint32_t* pixel = &m_pixels[column];
+    if (m_pendingLit)
+    {
+        for (size_t row = 0; row < kAzimuthBins; ++row, pixel += kColumns)
+        {
+            const float level = std::min(m_pending[row] / kSaturation, 1.0f);
+            *pixel = m_palette[static_cast<size_t>(level * 255.0f)];
+        }
+        m_pending.fill(0.0f);
+        m_pendingLit = false;
+    }
+    else
+    {
+        for (size_t row = 0; row < kAzimuthBins; ++row, pixel += kColumns)
+        {
+            *pixel = 0;
+        }
+    }
+
+    m_head = (m_head + 1) % kColumns;
+}
+
+void WaterfallStrip::Clear() noexcept
+{
+    m_pending.fill(0.0f);
+    m_pendingLit = false;
+    m_columnLit.fill(false);
+    m_litColumns = 0;
+    m_head = 0;
+    m_nextColumn = {};
+    m_pixels.fill(0);
+}
+
+void WaterfallStrip::SetPalette(uint8_t r, uint8_t g, uint8_t b, float opacity) noexcept
+{
+    // Existing columns keep the colors they were committed with
+    for (size_t i = 0; i < m_palette.size(); ++i)
+    {
+        const float alpha = std::clamp(opacity, 0.0f, 1.0f) * static_cast<float>(i) / 255.0f;
+        const auto a8 = static_cast<uint32_t>(alpha * 255.0f + 0.5f);
+        const auto r8 = static_cast<uint32_t>(r * alpha + 0.5f);
+        const auto g8 = static_cast<uint32_t>(g * alpha + 0.5f);
+        const auto b8 = static_cast<uint32_t>(b * alpha + 0.5f);
+        m_palette[i] = (a8 << 24) | (r8 << 16) | (g8 << 8) | b8;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Rendering
+{
+// Azimuth-versus-time history. Time runs along the columns of a circular
+// texture: every column period the pending azimuth bins are committed as one
+// new column at Head(), overwriting the oldest, and older columns are never
+// touched again. Memory is the texture itself and per-column cost depends
+// only on the number of azimuth bins, not on how long the history is.
+class WaterfallStrip
+{
+public:
+    static constexpr size_t kAzimuthBins = 96; // texture rows, 3.75 degrees each
+    static constexpr size_t kColumns = 256; // texture columns
+    static constexpr std::chrono::milliseconds kColumnPeriod{25}; // 6.4 s of history
+
+    WaterfallStrip();
+
+    // x/z is the screen-space unit vector of the hit; it lands in the column
+    // currently being collected.
+    void Accumulate(float x, float z, float weight) noexcept;
+    // Commits every column period that ended by now and returns how many
+    // columns were written (at most kColumns, however long the gap).
+    size_t Advance(std::chrono::steady_clock::time_point now) noexcept;
+    void Clear() noexcept;
+
+    // Color used for the hottest bins; alpha ramps with intensity up to opacity.
+    void SetPalette(uint8_t r, uint8_t g, uint8_t b, float opacity) noexcept;
+
+    // Column the next Advance writes, which is also the oldest column shown.
+    [[nodiscard]] size_t Head() const noexcept { return m_head; }
+    // True while any column in the history holds a hit.
+    [[nodiscard]] bool HasContent() const noexcept { return m_litColumns > 0; }
+
+    // Premultiplied BGRA pixels, kColumns * kAzimuthBins, row pitch kColumns * 4.
+    [[nodiscard]] const uint32_t* Pixels() const noexcept { return m_pixels.data(); }
+
+private:
+    void CommitColumn() noexcept;
+
+    std::array<float, kAzimuthBins> m_pending{};
+    bool m_pendingLit{false};
+    std::array<bool, kColumns> m_columnLit{};
+    size_t m_litColumns{0};
+    size_t m_head{0};
+    std::chrono::steady_clock::time_point m_nextColumn{};
+    std::array<uint32_t, 256> m_palette{};
+    std::array<uint32_t, kColumns * kAzimuthBins> m_pixels{};
+};
+}
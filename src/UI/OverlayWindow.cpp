@@ -2,6 +2,8 @@
 
 #include "Config/ConfigManager.h"
 #include "Rendering/DirectionVisualizer.h"
+#include "Rendering/DwmFrameClock.h"
+#include "Rendering/RenderThread.h"
 #include "UI/SettingsController.h"
 #include "Util/ComException.h"
 
@@ -15,8 +17,6 @@ using namespace UI;
 namespace
 {
 constexpr wchar_t kWindowClassName[] = L"SpatialAudioVisualizerOverlay";
-constexpr UINT_PTR kRenderTimerId = 1001;
-constexpr UINT kRenderTimerIntervalMs = 16;
 }
 
 OverlayWindow::OverlayWindow(HINSTANCE instance,
@@ -28,6 +28,8 @@ OverlayWindow::OverlayWindow(HINSTANCE instance,
 {
 }
 
+OverlayWindow::~OverlayWindow() = default;
+
 void OverlayWindow::Create(int cmdShow)
 {
     RegisterClass();
@@ -50,21 +52,30 @@ void OverlayWindow::Create(int cmdShow)
         throw std::runtime_error("Failed to create overlay window");
     }
 
-    SetLayeredWindowAttributes(m_hwnd, 0, static_cast<BYTE>(255 * m_config->Theme().opacity), LWA_ALPHA);
+    // Layering attributes are set by the render thread with the device
     SetWindowPos(m_hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOSIZE | SWP_NOMOVE);
     ShowWindow(m_hwnd, cmdShow);
     UpdateWindow(m_hwnd);
 
     m_visualizer->Initialize(m_hwnd);
     UpdateVisuals();
-    SetTimer(m_hwnd, kRenderTimerId, kRenderTimerIntervalMs, nullptr);
+
+    // Frames are paced by the compositor rather than a 16 ms WM_TIMER
+    m_renderThread = std::make_unique<Rendering::RenderThread>(m_visualizer, std::make_unique<Rendering::DwmFrameClock>());
+    m_renderThread->Start();
 }
 
 void OverlayWindow::Destroy()
 {
+    // The render thread draws into the window, so stop it first
+    if (m_renderThread)
+    {
+        m_renderThread->Stop();
+        m_renderThread.reset();
+    }
+
     if (m_hwnd)
     {
-        KillTimer(m_hwnd, kRenderTimerId);
         DestroyWindow(m_hwnd);
         m_hwnd = nullptr;
     }
@@ -77,6 +88,11 @@ void OverlayWindow::Show()
     {
         m_visualizer->SetVisible(true);
     }
+    // Resume first so the device is being rebuilt while the window maps
+    if (m_renderThread)
+    {
+        m_renderThread->Resume();
+    }
     ShowWindow(m_hwnd, SW_SHOW);
 }
 
@@ -88,6 +104,10 @@ void OverlayWindow::Hide()
         m_visualizer->SetVisible(false);
     }
     ShowWindow(m_hwnd, SW_HIDE);
+    if (m_renderThread)
+    {
+        m_renderThread->Pause(true);
+    }
 }
 
 void OverlayWindow::Toggle()
@@ -104,15 +124,36 @@ void OverlayWindow::Toggle()
 
 void OverlayWindow::UpdateTransparency()
 {
-    SetLayeredWindowAttributes(m_hwnd, 0, static_cast<BYTE>(255 * m_config->Theme().opacity), LWA_ALPHA);
+    // Window opacity and brush alpha are both applied by the render thread
+    m_visualizer->InvalidateTheme();
+}
+
+void OverlayWindow::ApplyTheme()
+{
+    m_visualizer->InvalidateTheme();
+    ForceRender();
+}
+
+void OverlayWindow::ApplyPresenter()
+{
+    // Device resources and the window's layering depend on the presenter;
+    // the render thread rebuilds both between two frames
+    m_visualizer->SetDisplay(m_config->Display());
+    m_visualizer->RequestDeviceReset();
+    UpdateVisuals();
+    ForceRender();
+}
+
+void OverlayWindow::ApplyDisplay()
+{
+    m_visualizer->SetDisplay(m_config->Display());
+    ForceRender();
 }
 
 void OverlayWindow::ForceRender()
 {
-    if (m_visible)
-    {
-        m_visualizer->Render();
-    }
+    // Picked up by the render thread on its next frame
+    m_visualizer->Invalidate();
 }
 
 void OverlayWindow::RegisterClass()
@@ -163,12 +204,6 @@ LRESULT OverlayWindow::HandleMessage(UINT message, WPARAM wParam, LPARAM lParam)
 {
     switch (message)
     {
-    case WM_TIMER:
-        if (wParam == kRenderTimerId)
-        {
-            ForceRender();
-        }
-        break;
     case WM_ERASEBKGND:
         return 1;
     case WM_LBUTTONDOWN:
@@ -215,9 +250,6 @@ LRESULT OverlayWindow::HandleMessage(UINT message, WPARAM wParam, LPARAM lParam)
             return 0;
         }
         break;
-    case WM_DESTROY:
-        KillTimer(m_hwnd, kRenderTimerId);
-        break;
     }
 
     return DefWindowProcW(m_hwnd, message, wParam, lParam);
@@ -6,7 +6,7 @@
 #include <string>
 
 namespace Config { class ConfigManager; }
-namespace Rendering { class DirectionVisualizer; }
+namespace Rendering { class DirectionVisualizer; class RenderThread; }
 
 namespace UI
 {
@@ -16,6 +16,7 @@ public:
     OverlayWindow(HINSTANCE instance,
                   Rendering::DirectionVisualizer* visualizer,
                   std::shared_ptr<Config::ConfigManager> config);
+    ~OverlayWindow();
 
     void Create(int cmdShow);
     void Destroy();
@@ -25,6 +26,11 @@ public:
     void Toggle();
 
     void UpdateTransparency();
+    void ApplyTheme();
+    // Switches between window-wide and per-pixel alpha per the display config.
+    void ApplyPresenter();
+    // Pushes diagnostics/visualization changes to the render thread.
+    void ApplyDisplay();
     void ForceRender();
     void SetSettingsController(class SettingsController* controller) { m_settingsController = controller; }
 
@@ -44,6 +50,7 @@ private:
     HINSTANCE m_instance;
     Rendering::DirectionVisualizer* m_visualizer;
     std::shared_ptr<Config::ConfigManager> m_config;
+    std::unique_ptr<Rendering::RenderThread> m_renderThread;
     HWND m_hwnd{nullptr};
     bool m_visible{true};
     bool m_dragging{false};
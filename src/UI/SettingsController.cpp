@@ -200,6 +200,17 @@ void SettingsController::BuildMenu(HMENU menu)
     AppendMenuW(patternMenu, aggressiveFlags, MenuId_PatternPresetAggressive, L"Aggressive");
     AppendMenuW(menu, MF_POPUP, reinterpret_cast<UINT_PTR>(patternMenu), L"Pattern Preset");
 
+    // Visualization mode
+    HMENU visualizationMenu = CreatePopupMenu();
+    auto visualization = m_config->Display().visualization;
+    AppendMenuW(visualizationMenu, MF_STRING | ((visualization == Config::VisualizationMode::Radar) ? MF_CHECKED : 0), MenuId_VisualizationRadar, L"Radar Markers");
+    AppendMenuW(visualizationMenu, MF_STRING | ((visualization == Config::VisualizationMode::Heatmap) ? MF_CHECKED : 0), MenuId_VisualizationHeatmap, L"Heatmap");
+    AppendMenuW(visualizationMenu, MF_STRING | ((visualization == Config::VisualizationMode::Waterfall) ? MF_CHECKED : 0), MenuId_VisualizationWaterfall, L"Waterfall");
+    AppendMenuW(menu, MF_POPUP, reinterpret_cast<UINT_PTR>(visualizationMenu), L"Visualization");
+    AppendMenuW(menu, MF_STRING | (m_config->Display().perPixelAlpha ? MF_CHECKED : 0), MenuId_TogglePerPixelAlpha, L"Per-Pixel Transparency");
+    AppendMenuW(menu, MF_STRING | (m_config->Display().predictMotion ? MF_CHECKED : 0), MenuId_TogglePrediction, L"Predict Motion");
+    AppendMenuW(menu, MF_STRING | (m_config->Display().showDiagnostics ? MF_CHECKED : 0), MenuId_ToggleDiagnostics, L"Show Diagnostics");
+
     AppendMenuW(menu, MF_SEPARATOR, 0, nullptr);
 
     // Hotkeys
@@ -265,6 +276,36 @@ void SettingsController::OnMenuCommand(UINT id)
             m_hotkeys->Register();
         }
         break;
+    case MenuId_ToggleDiagnostics:
+        m_config->Display().showDiagnostics = !m_config->Display().showDiagnostics;
+        m_config->Save();
+        m_overlay->ApplyDisplay();
+        break;
+    case MenuId_VisualizationRadar:
+        m_config->Display().visualization = Config::VisualizationMode::Radar;
+        m_config->Save();
+        m_overlay->ApplyDisplay();
+        break;
+    case MenuId_VisualizationHeatmap:
+        m_config->Display().visualization = Config::VisualizationMode::Heatmap;
+        m_config->Save();
+        m_overlay->ApplyDisplay();
+        break;
+    case MenuId_VisualizationWaterfall:
+        m_config->Display().visualization = Config::VisualizationMode::Waterfall;
+        m_config->Save();
+        m_overlay->ApplyDisplay();
+        break;
+    case MenuId_TogglePrediction:
+        m_config->Display().predictMotion = !m_config->Display().predictMotion;
+        m_config->Save();
+        m_overlay->ApplyDisplay();
+        break;
+    case MenuId_TogglePerPixelAlpha:
+        m_config->Display().perPixelAlpha = !m_config->Display().perPixelAlpha;
+        m_config->Save();
+        m_overlay->ApplyPresenter();
+        break;
     case MenuId_Save:
         m_config->Save();
         break;
@@ -326,7 +367,7 @@ void SettingsController::PickThemeColor()
     {
         m_config->Theme().primaryColor = cc.rgbResult;
         m_config->Save();
-        m_overlay->ForceRender();
+        m_overlay->ApplyTheme();
     }
 }
 
@@ -81,6 +81,12 @@ private:
         MenuId_PatternPresetConservative,
         MenuId_PatternPresetBalanced,
         MenuId_PatternPresetAggressive,
+        MenuId_ToggleDiagnostics,
+        MenuId_VisualizationRadar,
+        MenuId_VisualizationHeatmap,
+        MenuId_TogglePerPixelAlpha,
+        MenuId_VisualizationWaterfall,
+        MenuId_TogglePrediction,
     };
 };
 }
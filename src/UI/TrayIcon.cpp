@@ -1,9 +1,11 @@
 #include "UI/TrayIcon.h"
 
+#include "Config/ConfigManager.h"
 #include "Diagnostics/PerformanceMonitor.h"
 #include "UI/OverlayWindow.h"
 #include "UI/SettingsController.h"
 
+#include <algorithm>
 #include <cwchar>
 #include <string>
 
@@ -17,6 +19,9 @@ constexpr UINT ID_TRAY_MENU_SHOW = 2001;
 constexpr UINT ID_TRAY_MENU_SETTINGS = 2002;
 constexpr UINT ID_TRAY_MENU_EXIT = 2003;
 constexpr UINT ID_TRAY_MENU_PERFORMANCE = 2004;
+constexpr UINT ID_TRAY_MENU_METRICS_LOG = 2005;
+constexpr UINT_PTR kTooltipTimerId = 1;
+constexpr UINT kTooltipIntervalMs = 2000;
 }
 
 TrayIcon::TrayIcon(HINSTANCE instance,
@@ -57,6 +62,7 @@ void TrayIcon::Create()
 
     Shell_NotifyIconW(NIM_ADD, &m_nid);
     UpdateTooltip();
+    SetTimer(m_messageWindow, kTooltipTimerId, kTooltipIntervalMs, nullptr);
 }
 
 void TrayIcon::Destroy()
@@ -69,6 +75,7 @@ void TrayIcon::Destroy()
 
     if (m_messageWindow)
     {
+        KillTimer(m_messageWindow, kTooltipTimerId);
         DestroyWindow(m_messageWindow);
         m_messageWindow = nullptr;
     }
@@ -81,8 +88,25 @@ void TrayIcon::UpdateTooltip()
     {
         auto stats = m_performance->GetLatest();
         wchar_t buffer[128];
-        swprintf_s(buffer, L"\nCPU %.1f%% MEM %zu MB", stats.cpuPercent, stats.memoryMb);
+        swprintf_s(buffer, L"\nCPU %.1f%% (app %.1f%%) MEM %zu MB", stats.cpuPercent, stats.processCpuPercent, stats.memoryMb);
         tooltip += buffer;
+
+        const auto* render = Diagnostics::FindMetric(stats.metrics, "render.cpu");
+        const auto* packets = Diagnostics::FindMetric(stats.metrics, "audio.packets");
+        if (render && packets)
+        {
+            swprintf_s(buffer, L"\nRender p99 %lld us, %.0f pkt/s",
+                       static_cast<long long>(render->p99.count()), packets->ratePerSecond);
+            tooltip += buffer;
+        }
+
+        const auto busiest = std::max_element(stats.threads.begin(), stats.threads.end(),
+                                              [](const Util::ThreadLoad& a, const Util::ThreadLoad& b) { return a.percentOfCore < b.percentOfCore; });
+        if (busiest != stats.threads.end())
+        {
+            swprintf_s(buffer, L"\nBusiest: %hs %.1f%% of a core", busiest->name.c_str(), busiest->percentOfCore);
+            tooltip += buffer;
+        }
     }
 
     wcsncpy_s(m_nid.szTip, tooltip.c_str(), _TRUNCATE);
@@ -104,6 +128,17 @@ void TrayIcon::HandleCommand(UINT id)
     case ID_TRAY_MENU_PERFORMANCE:
         UpdateTooltip();
         break;
+    case ID_TRAY_MENU_METRICS_LOG:
+    {
+        auto& display = m_config->Display();
+        display.metricsLog = !display.metricsLog;
+        m_config->Save();
+        if (m_performance)
+        {
+            m_performance->SetFileSink(display.metricsLog);
+        }
+        break;
+    }
     case ID_TRAY_MENU_EXIT:
         PostQuitMessage(0);
         break;
@@ -138,6 +173,8 @@ LRESULT CALLBACK TrayIcon::WindowProc(HWND hwnd, UINT message, WPARAM wParam, LP
             AppendMenuW(menu, MF_STRING, ID_TRAY_MENU_SHOW, icon->m_overlay->IsVisible() ? L"Hide" : L"Show");
             AppendMenuW(menu, MF_STRING, ID_TRAY_MENU_SETTINGS, L"Settings");
             AppendMenuW(menu, MF_STRING, ID_TRAY_MENU_PERFORMANCE, L"Refresh Performance");
+            AppendMenuW(menu, MF_STRING | (icon->m_config->Display().metricsLog ? MF_CHECKED : 0),
+                        ID_TRAY_MENU_METRICS_LOG, L"Log Metrics");
             AppendMenuW(menu, MF_SEPARATOR, 0, nullptr);
             AppendMenuW(menu, MF_STRING, ID_TRAY_MENU_EXIT, L"Exit");
             POINT pt;
@@ -154,6 +191,12 @@ LRESULT CALLBACK TrayIcon::WindowProc(HWND hwnd, UINT message, WPARAM wParam, LP
     case WM_COMMAND:
         icon->HandleCommand(LOWORD(wParam));
         break;
+    case WM_TIMER:
+        if (wParam == kTooltipTimerId)
+        {
+            icon->UpdateTooltip();
+        }
+        break;
     case WM_DESTROY:
         break;
     }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace Util
+{
+// Wide string stored inline with a fixed capacity; longer text is
+// truncated. Copies never touch the heap, so labels and session names can
+// travel by value from the capture thread to the renderer.
+template <size_t Capacity>
+class FixedWString
+{
+public:
+    FixedWString() noexcept = default;
+    FixedWString(std::wstring_view text) noexcept { Assign(text); }
+
+    void Assign(std::wstring_view text) noexcept
+    {
+        m_size = 0;
+        Append(text);
+    }
+
+    void Append(std::wstring_view text) noexcept
+    {
+        const size_t count = std::min(text.size(), Capacity - m_size);
+        std::copy_n(text.data(), count, m_text.data() + m_size);
+        m_size += count;
+        m_text[m_size] = L'\0';
+    }
+
+    void Clear() noexcept { Assign({}); }
+
+    [[nodiscard]] const wchar_t* Data() const noexcept { return m_text.data(); } // null-terminated
+    [[nodiscard]] size_t Size() const noexcept { return m_size; }
+    [[nodiscard]] bool Empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] std::wstring_view View() const noexcept { return {m_text.data(), m_size}; }
+
+    friend bool operator==(const FixedWString& a, const FixedWString& b) noexcept { return a.View() == b.View(); }
+    friend bool operator!=(const FixedWString& a, const FixedWString& b) noexcept { return !(a == b); }
+
+private:
+    std::array<wchar_t, Capacity + 1> m_text{};
+    size_t m_size{0};
+};
+}
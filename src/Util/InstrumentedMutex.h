@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "Util/LatencyHistogram.h"
+
+namespace Util
+{
+struct LockWaitStats
+{
+    uint64_t acquisitions{0};
+    uint64_t contended{0};
+    uint64_t totalWaitNs{0};
+    uint64_t maxWaitNs{0};
+};
+
+// std::mutex drop-in (usable with std::scoped_lock) that records how long
+// callers spent blocked. The uncontended path costs one try_lock.
+class InstrumentedMutex
+{
+public:
+    void lock()
+    {
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (m_mutex.try_lock())
+        {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        m_mutex.lock();
+        const auto waited = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+        m_contended.fetch_add(1, std::memory_order_relaxed);
+        m_totalWaitNs.fetch_add(waited, std::memory_order_relaxed);
+        if (m_waitHistogram)
+        {
+            m_waitHistogram->Record(std::chrono::nanoseconds(waited));
+        }
+
+        uint64_t previous = m_maxWaitNs.load(std::memory_order_relaxed);
+        while (waited > previous &&
+               !m_maxWaitNs.compare_exchange_weak(previous, waited, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    bool try_lock()
+    {
+        if (!m_mutex.try_lock())
+        {
+            return false;
+        }
+        m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void unlock() { m_mutex.unlock(); }
+
+    // Also records each contended wait into the histogram. Call before the
+    // mutex is shared between threads.
+    void ReportWaitsTo(LatencyHistogram* histogram) noexcept { m_waitHistogram = histogram; }
+
+    [[nodiscard]] LockWaitStats Stats() const noexcept
+    {
+        LockWaitStats stats;
+        stats.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+        stats.contended = m_contended.load(std::memory_order_relaxed);
+        stats.totalWaitNs = m_totalWaitNs.load(std::memory_order_relaxed);
+        stats.maxWaitNs = m_maxWaitNs.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::atomic<uint64_t> m_acquisitions{0};
+    std::atomic<uint64_t> m_contended{0};
+    std::atomic<uint64_t> m_totalWaitNs{0};
+    std::atomic<uint64_t> m_maxWaitNs{0};
+    LatencyHistogram* m_waitHistogram{nullptr};
+};
+}
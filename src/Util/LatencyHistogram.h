@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace Util
+{
+// Log-linear histogram of durations: four buckets per power of two of
+// microseconds, up to ~2 minutes. Recording is lock-free and may run on one
+// thread while another reads percentiles; a read may mix samples from
+// adjacent frames, which is fine for diagnostics.
+class LatencyHistogram
+{
+public:
+    static constexpr size_t kBucketsPerOctave = 4;
+    static constexpr size_t kBucketCount = 27 * kBucketsPerOctave;
+
+    void Record(std::chrono::nanoseconds duration) noexcept
+    {
+        const double micros = std::max(0.0, static_cast<double>(duration.count()) / 1000.0);
+        const auto index = static_cast<size_t>(std::log2(micros + 1.0) * kBucketsPerOctave);
+        m_buckets[std::min(index, kBucketCount - 1)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+
+        const auto micros64 = static_cast<uint64_t>(micros);
+        uint64_t previous = m_maxMicros.load(std::memory_order_relaxed);
+        while (micros64 > previous &&
+               !m_maxMicros.compare_exchange_weak(previous, micros64, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    [[nodiscard]] uint64_t Count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::chrono::microseconds Max() const noexcept
+    {
+        return std::chrono::microseconds(m_maxMicros.load(std::memory_order_relaxed));
+    }
+
+    // Upper bound of the bucket holding the given fraction (0..1) of samples.
+    [[nodiscard]] std::chrono::microseconds Percentile(double fraction) const noexcept
+    {
+        const uint64_t total = Count();
+        if (total == 0)
+        {
+            return std::chrono::microseconds(0);
+        }
+
+        const auto target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+            {
+                const double upper = std::exp2(static_cast<double>(i + 1) / kBucketsPerOctave) - 1.0;
+                return std::chrono::microseconds(static_cast<int64_t>(std::min(upper, static_cast<double>(Max().count()))));
+            }
+        }
+        return Max();
+    }
+
+    // Replaces the contents with other's, e.g. to publish a finished window.
+    // A concurrent reader may see a mix of the old and new contents.
+    void CopyFrom(const LatencyHistogram& other) noexcept
+    {
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+            m_buckets[i].store(other.m_buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        m_count.store(other.Count(), std::memory_order_relaxed);
+        m_maxMicros.store(other.m_maxMicros.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    void Reset() noexcept
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_maxMicros.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_maxMicros{0};
+};
+}
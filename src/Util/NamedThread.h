@@ -0,0 +1,235 @@
+#pragma once
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Util
+{
+// CPU consumed by one registered thread, in platform ticks: TSC cycles
+// (QueryThreadCycleTime) on Windows, nanoseconds (CLOCK_THREAD_CPUTIME_ID)
+// elsewhere. referenceTicks advances in the same unit with wall time, so
+// the ratio of two deltas is the share of one core.
+struct ThreadCpuTicks
+{
+    uint64_t id{0};
+    std::string name;
+    uint64_t ticks{0};
+};
+
+struct ThreadCpuSample
+{
+    uint64_t referenceTicks{0};
+    std::vector<ThreadCpuTicks> threads;
+};
+
+struct ThreadLoad
+{
+    std::string name;
+    double percentOfCore{0.0};
+};
+
+namespace Detail
+{
+#if defined(_WIN32)
+using ThreadCpuHandle = HANDLE;
+#else
+using ThreadCpuHandle = clockid_t;
+#endif
+
+struct RegisteredThread
+{
+    uint64_t id;
+    std::string name;
+    ThreadCpuHandle handle;
+};
+
+class ThreadTable
+{
+public:
+    static ThreadTable& Instance()
+    {
+        static ThreadTable table;
+        return table;
+    }
+
+    uint64_t Add(std::string name, ThreadCpuHandle handle)
+    {
+        std::scoped_lock lock{m_mutex};
+        const uint64_t id = ++m_nextId;
+        m_threads.push_back({id, std::move(name), handle});
+        return id;
+    }
+
+    void Remove(uint64_t id)
+    {
+        std::scoped_lock lock{m_mutex};
+        auto it = std::find_if(m_threads.begin(), m_threads.end(),
+                               [id](const RegisteredThread& thread) { return thread.id == id; });
+        if (it != m_threads.end())
+        {
+#if defined(_WIN32)
+            CloseHandle(it->handle);
+#endif
+            m_threads.erase(it);
+        }
+    }
+
+    ThreadCpuSample Sample() const
+    {
+        ThreadCpuSample sample;
+        std::scoped_lock lock{m_mutex};
+        sample.threads.reserve(m_threads.size());
+        for (const auto& thread : m_threads)
+        {
+            sample.threads.push_back({thread.id, thread.name, ReadTicks(thread.handle)});
+        }
+        sample.referenceTicks = ReferenceTicks();
+        return sample;
+    }
+
+private:
+    static uint64_t ReadTicks(ThreadCpuHandle handle)
+    {
+#if defined(_WIN32)
+        ULONG64 cycles = 0;
+        QueryThreadCycleTime(handle, &cycles);
+        return cycles;
+#else
+        timespec time{};
+        clock_gettime(handle, &time);
+        return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(time.tv_nsec);
+#endif
+    }
+
+    static uint64_t ReferenceTicks()
+    {
+#if defined(_WIN32)
+        return __rdtsc();
+#else
+        timespec time{};
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(time.tv_nsec);
+#endif
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<RegisteredThread> m_threads;
+    uint64_t m_nextId{0};
+};
+}
+
+// Names the calling thread for debuggers and profilers and registers it
+// for per-thread CPU accounting until the object goes out of scope.
+class ThreadIdentity
+{
+public:
+    explicit ThreadIdentity(const char* name)
+    {
+#if defined(_WIN32)
+        const std::wstring wideName(name, name + std::char_traits<char>::length(name));
+        SetThreadDescription(GetCurrentThread(), wideName.c_str());
+
+        HANDLE handle{};
+        DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &handle,
+                        THREAD_QUERY_LIMITED_INFORMATION, FALSE, 0);
+#else
+        // Linux limits thread names to 15 characters
+        pthread_setname_np(pthread_self(), std::string(name).substr(0, 15).c_str());
+
+        clockid_t handle{};
+        pthread_getcpuclockid(pthread_self(), &handle);
+#endif
+        m_id = Detail::ThreadTable::Instance().Add(name, handle);
+    }
+
+    ~ThreadIdentity() { Detail::ThreadTable::Instance().Remove(m_id); }
+
+    ThreadIdentity(const ThreadIdentity&) = delete;
+    ThreadIdentity& operator=(const ThreadIdentity&) = delete;
+
+private:
+    uint64_t m_id{0};
+};
+
+// std::thread that runs its function under a ThreadIdentity. Every worker
+// thread in the app is created through this.
+class NamedThread
+{
+public:
+    NamedThread() = default;
+
+    template <typename Function, typename... Args>
+    NamedThread(const char* name, Function&& function, Args&&... args)
+        : m_thread(
+              [name](auto threadFunction, auto... threadArgs) {
+                  ThreadIdentity identity{name};
+                  std::invoke(std::move(threadFunction), std::move(threadArgs)...);
+              },
+              std::forward<Function>(function), std::forward<Args>(args)...)
+    {
+    }
+
+    NamedThread(NamedThread&&) noexcept = default;
+    NamedThread& operator=(NamedThread&&) noexcept = default;
+
+    [[nodiscard]] bool joinable() const noexcept { return m_thread.joinable(); }
+    void join() { m_thread.join(); }
+    [[nodiscard]] std::thread::native_handle_type native_handle() { return m_thread.native_handle(); }
+
+private:
+    std::thread m_thread;
+};
+
+// CPU accounting of all registered threads.
+inline ThreadCpuSample SampleThreadCpu()
+{
+    return Detail::ThreadTable::Instance().Sample();
+}
+
+// Turns successive samples into per-thread load. Not thread-safe; each
+// consumer keeps its own meter.
+class ThreadLoadMeter
+{
+public:
+    // Load of each registered thread since the previous call; empty on the
+    // first call.
+    std::vector<ThreadLoad> Update()
+    {
+        auto sample = SampleThreadCpu();
+
+        std::vector<ThreadLoad> loads;
+        const uint64_t elapsed = sample.referenceTicks - m_previous.referenceTicks;
+        if (m_previous.referenceTicks != 0 && elapsed > 0)
+        {
+            for (const auto& thread : sample.threads)
+            {
+                auto previous = std::find_if(m_previous.threads.begin(), m_previous.threads.end(),
+                                             [&](const ThreadCpuTicks& old) { return old.id == thread.id; });
+                const uint64_t before = (previous != m_previous.threads.end()) ? previous->ticks : 0;
+                const uint64_t used = thread.ticks >= before ? thread.ticks - before : 0;
+                loads.push_back({thread.name, static_cast<double>(used) / static_cast<double>(elapsed) * 100.0});
+            }
+        }
+
+        m_previous = std::move(sample);
+        return loads;
+    }
+
+private:
+    ThreadCpuSample m_previous;
+};
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <chrono>
+#include <cstdint>
+
+namespace Util
+{
+// Now on the clock WASAPI stamps capture packets with: QPC in 100 ns
+// units. steady_clock reads QPC on Windows; elsewhere it is the only
+// clock a fake endpoint needs to agree with.
+inline uint64_t QpcNow100ns() noexcept
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter{}, frequency{};
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    constexpr long long k100nsPerSecond = 10'000'000;
+    const long long ticks = counter.QuadPart;
+    const long long perSecond = frequency.QuadPart;
+    return static_cast<uint64_t>((ticks / perSecond) * k100nsPerSecond + (ticks % perSecond) * k100nsPerSecond / perSecond);
+#else
+    using Ticks100ns = std::chrono::duration<long long, std::ratio<1, 10'000'000>>;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<Ticks100ns>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <avrt.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Util
+{
+enum class CorePreference
+{
+    Any = 0,
+    Performance = 1, // P-cores of a hybrid CPU
+    Efficiency = 2,  // E-cores of a hybrid CPU
+};
+
+struct RealtimePolicy
+{
+    bool enabled{false};
+    // Logical processor to pin the thread to; -1 lets the scheduler choose
+    int core{-1};
+    // Core class to keep the thread on when it is not pinned; ignored on
+    // CPUs with a single class
+    CorePreference cores{CorePreference::Any};
+};
+
+namespace Detail
+{
+#if !defined(_WIN32)
+// Parses a sysfs CPU list such as "0-7,16"
+inline std::vector<int> ReadCpuList(const char* path)
+{
+    std::vector<int> cpus;
+    std::ifstream file(path);
+    std::string range;
+    while (std::getline(file, range, ','))
+    {
+        const auto dash = range.find('-');
+        try
+        {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        catch (const std::exception&)
+        {
+            return {};
+        }
+    }
+    return cpus;
+}
+#endif
+}
+
+// Moves the calling thread to real-time scheduling and the requested cores
+// until the object goes out of scope: the MMCSS "Pro Audio" task on
+// Windows, SCHED_FIFO elsewhere (used by the fake-endpoint benchmarks).
+// Either step may be refused - SCHED_FIFO needs CAP_SYS_NICE, MMCSS can be
+// disabled - and the thread then carries on at normal priority.
+class RealtimeScope
+{
+public:
+    explicit RealtimeScope(const RealtimePolicy& policy)
+    {
+        if (!policy.enabled)
+        {
+            return;
+        }
+        m_elevated = Elevate();
+        m_placed = Place(policy);
+    }
+
+    ~RealtimeScope()
+    {
+#if defined(_WIN32)
+        if (m_selectedCpuSets)
+        {
+            SetThreadSelectedCpuSets(GetCurrentThread(), nullptr, 0);
+        }
+        if (m_previousAffinity)
+        {
+            SetThreadAffinityMask(GetCurrentThread(), m_previousAffinity);
+        }
+        if (m_task)
+        {
+            AvRevertMmThreadCharacteristics(m_task);
+        }
+#else
+        if (m_restoreAffinity)
+        {
+            pthread_setaffinity_np(pthread_self(), sizeof(m_previousAffinity), &m_previousAffinity);
+        }
+        if (m_elevated)
+        {
+            pthread_setschedparam(pthread_self(), m_previousPolicy, &m_previousParam);
+        }
+#endif
+    }
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+
+    // Whether the thread runs with real-time priority
+    [[nodiscard]] bool Elevated() const noexcept { return m_elevated; }
+    // Whether a core or core class restriction took effect
+    [[nodiscard]] bool Placed() const noexcept { return m_placed; }
+
+private:
+#if defined(_WIN32)
+    bool Elevate()
+    {
+        DWORD taskIndex = 0;
+        m_task = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        return m_task != nullptr;
+    }
+
+    bool Place(const RealtimePolicy& policy)
+    {
+        if (policy.core >= 0)
+        {
+            if (policy.core >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+            {
+                return false;
+            }
+            m_previousAffinity = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << policy.core);
+            return m_previousAffinity != 0;
+        }
+        if (policy.cores == CorePreference::Any)
+        {
+            return false;
+        }
+
+        ULONG length = 0;
+        GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+        std::vector<BYTE> buffer(length);
+        auto* first = reinterpret_cast<SYSTEM_CPU_SET_INFORMATION*>(buffer.data());
+        if (length == 0 || !GetSystemCpuSetInformation(first, length, &length, GetCurrentProcess(), 0))
+        {
+            return false;
+        }
+
+        // Higher efficiency classes are the faster cores
+        struct CpuSet
+        {
+            ULONG id;
+            BYTE efficiencyClass;
+        };
+        std::vector<CpuSet> sets;
+        for (ULONG offset = 0; offset < length;)
+        {
+            const auto* entry = reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION*>(buffer.data() + offset);
+            if (entry->Type == CpuSetInformation)
+            {
+                sets.push_back({entry->CpuSet.Id, entry->CpuSet.EfficiencyClass});
+            }
+            offset += entry->Size;
+        }
+        if (sets.empty())
+        {
+            return false;
+        }
+
+        const auto [slowest, fastest] = std::minmax_element(
+            sets.begin(), sets.end(), [](const CpuSet& a, const CpuSet& b) { return a.efficiencyClass < b.efficiencyClass; });
+        if (slowest->efficiencyClass == fastest->efficiencyClass)
+        {
+            return false;
+        }
+        const BYTE wanted = policy.cores == CorePreference::Performance ? fastest->efficiencyClass : slowest->efficiencyClass;
+
+        std::vector<ULONG> ids;
+        for (const auto& set : sets)
+        {
+            if (set.efficiencyClass == wanted)
+            {
+                ids.push_back(set.id);
+            }
+        }
+        m_selectedCpuSets = SetThreadSelectedCpuSets(GetCurrentThread(), ids.data(), static_cast<ULONG>(ids.size())) != FALSE;
+        return m_selectedCpuSets;
+    }
+
+    HANDLE m_task{};
+    DWORD_PTR m_previousAffinity{0};
+    bool m_selectedCpuSets{false};
+#else
+    bool Elevate()
+    {
+        if (pthread_getschedparam(pthread_self(), &m_previousPolicy, &m_previousParam) != 0)
+        {
+            return false;
+        }
+        // Above the usual IRQ threads (50), below the kernel's own (99)
+        sched_param param{};
+        param.sched_priority = std::clamp(70, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+
+    bool Place(const RealtimePolicy& policy)
+    {
+        std::vector<int> cpus;
+        if (policy.core >= 0)
+        {
+            cpus.push_back(policy.core);
+        }
+        else if (policy.cores != CorePreference::Any)
+        {
+            // Only hybrid Intel parts export these PMUs
+            cpus = Detail::ReadCpuList(policy.cores == CorePreference::Performance ? "/sys/devices/cpu_core/cpus"
+                                                                                   : "/sys/devices/cpu_atom/cpus");
+        }
+        if (cpus.empty())
+        {
+            return false;
+        }
+
+        if (pthread_getaffinity_np(pthread_self(), sizeof(m_previousAffinity), &m_previousAffinity) != 0)
+        {
+            return false;
+        }
+
+        // Only cores the process may run on (taskset, cgroup cpusets): the
+        // kernel rejects a mask without any of them, and silently drops the
+        // others from one that has some
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+        {
+            if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &m_previousAffinity))
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (CPU_COUNT(&set) == 0)
+        {
+            return false;
+        }
+        m_restoreAffinity = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+        return m_restoreAffinity;
+    }
+
+    int m_previousPolicy{SCHED_OTHER};
+    sched_param m_previousParam{};
+    cpu_set_t m_previousAffinity{};
+    bool m_restoreAffinity{false};
+#endif
+
+    bool m_elevated{false};
+    bool m_placed{false};
+};
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Util
+{
+// Bounded single-producer / single-consumer queue. Push and TryPop never
+// block or allocate; Push fails when the queue is full.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+public:
+    bool Push(const T& value) noexcept
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail == Capacity)
+        {
+            return false;
+        }
+
+        m_items[head & kMask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& value) noexcept
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        if (head == tail)
+        {
+            return false;
+        }
+
+        value = m_items[tail & kMask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static constexpr size_t kMask = Capacity - 1;
+
+    std::array<T, Capacity> m_items{};
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace Util
+{
+// Lock-free hand-off of the latest value from one producer to one consumer.
+// The producer fills Back() and calls Publish(); the consumer calls Acquire()
+// and reads Front(). Neither side ever waits on the other: the third slot is
+// the one currently in flight between them.
+template <typename T>
+class TripleBuffer
+{
+public:
+    T& Back() noexcept { return m_slots[m_backIndex]; }
+
+    void Publish() noexcept
+    {
+        m_backIndex = m_middle.exchange(m_backIndex | kFreshBit, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Returns true when a newer value was swapped into Front().
+    bool Acquire() noexcept
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & kFreshBit) == 0)
+        {
+            return false;
+        }
+
+        m_frontIndex = m_middle.exchange(m_frontIndex, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    const T& Front() const noexcept { return m_slots[m_frontIndex]; }
+
+private:
+    static constexpr unsigned kIndexMask = 0x3;
+    static constexpr unsigned kFreshBit = 0x4;
+
+    std::array<T, 3> m_slots{};
+    std::atomic<unsigned> m_middle{1};
+    unsigned m_backIndex{0};
+    unsigned m_frontIndex{2};
+};
+}
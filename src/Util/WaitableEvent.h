@@ -0,0 +1,130 @@
+#pragma once
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#include <initializer_list>
+
+namespace Util
+{
+// Auto-reset event for the capture thread's wake-ups. Native() is what
+// IAudioClient::SetEventHandle takes, and whoever holds that value signals
+// it through Set(NativeHandle). Windows uses a kernel event; elsewhere a
+// condition variable stands in so the capture loop runs against fake
+// endpoints.
+class WaitableEvent
+{
+public:
+#if defined(_WIN32)
+    using NativeHandle = HANDLE;
+#else
+    using NativeHandle = void*;
+#endif
+
+    WaitableEvent(const WaitableEvent&) = delete;
+    WaitableEvent& operator=(const WaitableEvent&) = delete;
+
+#if defined(_WIN32)
+    WaitableEvent()
+        : m_event(CreateEventExW(nullptr, nullptr, 0, EVENT_MODIFY_STATE | SYNCHRONIZE))
+    {
+    }
+
+    ~WaitableEvent()
+    {
+        if (m_event)
+        {
+            CloseHandle(m_event);
+        }
+    }
+
+    [[nodiscard]] NativeHandle Native() const noexcept { return m_event; }
+
+    static void Set(NativeHandle event) noexcept { SetEvent(event); }
+    void Set() noexcept { SetEvent(m_event); }
+    void Reset() noexcept { ResetEvent(m_event); }
+
+    // Blocks until one of the events is signalled, resets it and returns
+    // its index
+    static int WaitAny(std::initializer_list<const WaitableEvent*> events)
+    {
+        HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+        DWORD count = 0;
+        for (const auto* event : events)
+        {
+            handles[count++] = event->m_event;
+        }
+        const DWORD result = WaitForMultipleObjects(count, handles, FALSE, INFINITE);
+        return result < WAIT_OBJECT_0 + count ? static_cast<int>(result - WAIT_OBJECT_0) : -1;
+    }
+
+private:
+    HANDLE m_event;
+#else
+    WaitableEvent() = default;
+
+    [[nodiscard]] NativeHandle Native() const noexcept { return const_cast<WaitableEvent*>(this); }
+
+    static void Set(NativeHandle event) noexcept { static_cast<WaitableEvent*>(event)->Set(); }
+
+    void Set() noexcept
+    {
+        {
+            std::scoped_lock lock{Mutex()};
+            m_signalled = true;
+        }
+        Signalled().notify_all();
+    }
+
+    void Reset() noexcept
+    {
+        std::scoped_lock lock{Mutex()};
+        m_signalled = false;
+    }
+
+    // Blocks until one of the events is signalled, resets it and returns
+    // its index
+    static int WaitAny(std::initializer_list<const WaitableEvent*> events)
+    {
+        std::unique_lock lock{Mutex()};
+        int index = -1;
+        Signalled().wait(lock, [&] {
+            int i = 0;
+            for (const auto* event : events)
+            {
+                if (event->m_signalled)
+                {
+                    event->m_signalled = false;
+                    index = i;
+                    return true;
+                }
+                ++i;
+            }
+            return false;
+        });
+        return index;
+    }
+
+private:
+    // One lock for every event keeps waiting on several of them simple;
+    // only a capture thread and its endpoint ever contend for it
+    static std::mutex& Mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::condition_variable& Signalled()
+    {
+        static std::condition_variable signalled;
+        return signalled;
+    }
+
+    mutable bool m_signalled{false};
+#endif
+};
+}
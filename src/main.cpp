@@ -1,7 +1,14 @@
 #include "App/ApplicationHost.h"
+#include "Benchmark/BenchmarkCommand.h"
 
-int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int nCmdShow)
+int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR commandLine, int nCmdShow)
 {
+    // Headless benchmark runs exit before any window or device is created
+    if (const auto exitCode = Benchmark::RunFromCommandLine(commandLine))
+    {
+        return *exitCode;
+    }
+
     App::ApplicationHost app{hInstance, nCmdShow};
     return app.Run();
 }